@@ -23,7 +23,7 @@ let package = Package(
   
   targets: [
     // User-facing modules
-    .target(name: "ComplexModule", dependencies: ["RealModule"]),
+    .target(name: "ComplexModule", dependencies: ["RealModule", "_NumericsShims"]),
     .target(name: "Numerics", dependencies: ["ComplexModule", "RealModule"]),
     .target(name: "RealModule", dependencies: ["_NumericsShims"]),
     
@@ -37,6 +37,9 @@ let package = Package(
     
     // Test executables
     .target(name: "ComplexLog", dependencies: ["Numerics", "_TestSupport"], path: "Tests/Executable/ComplexLog"),
-    .target(name: "ComplexLog1p", dependencies: ["Numerics", "_TestSupport"], path: "Tests/Executable/ComplexLog1p")
+    .target(name: "ComplexLog1p", dependencies: ["Numerics", "_TestSupport"], path: "Tests/Executable/ComplexLog1p"),
+    
+    // Performance benchmarks
+    .target(name: "Benchmarks", dependencies: ["Numerics"], path: "Tests/Executable/Benchmarks")
   ]
 )
@@ -92,10 +92,20 @@ extension Complex: AlgebraicField {
   
   @usableFromInline @_alwaysEmitIntoClient @inline(never)
   internal static func rescaledDivide(_ z: Complex, _ w: Complex) -> Complex {
+    #if SWIFT_NUMERICS_INSTRUMENTATION
+    SlowPathCounters._record(.rescaledDivide)
+    #endif
     if w.isZero { return .infinity }
     if z.isZero || !w.isFinite { return .zero }
-    // TODO: detect when RealType is Float and just promote to Double, then
-    // use the naive algorithm.
+    // When RealType is Float, the naive algorithm evaluated in Double cannot
+    // overflow or underflow (see the Complex<Float> division operator
+    // below). Concrete code uses that operator directly; this catches
+    // generic code that ends up here.
+    if RealType.self == Float.self {
+      let q = unsafeBitCast(z, to: Complex<Float>.self) /
+              unsafeBitCast(w, to: Complex<Float>.self)
+      return unsafeBitCast(q, to: Complex.self)
+    }
     let zScale = z.magnitude
     let wScale = w.magnitude
     let zNorm = z.divided(by: zScale)
@@ -158,6 +168,8 @@ extension Complex: AlgebraicField {
   ///   return data.map { $0 / divisor }
   /// }
   /// ```
+  ///
+  /// `Complex.divide(_:by:into:)` implements this for buffers.
   @inlinable
   public var reciprocal: Complex? {
     let recip = 1/self
@@ -167,3 +179,50 @@ extension Complex: AlgebraicField {
     return nil
   }
 }
+
+// MARK: - Fused multiply-add
+extension Complex {
+  /// `a*b + c`, computed using fused multiply-add for the component
+  /// operations when that is faster (see `RealFunctions._mulAdd`).
+  ///
+  /// Like `*`, this uses the naive expression for the product, so it is
+  /// subject to the same overflow and underflow behavior. When the
+  /// component operations are fused, the result may differ slightly from
+  /// `a*b + c`, and is generally more accurate.
+  @_transparent
+  public static func multiplyAdd(
+    _ a: Complex, _ b: Complex, _ c: Complex
+  ) -> Complex {
+    Complex(
+      RealType._mulAdd(a.x, b.x, RealType._mulAdd(-a.y, b.y, c.x)),
+      RealType._mulAdd(a.x, b.y, RealType._mulAdd(a.y, b.x, c.y))
+    )
+  }
+}
+
+// MARK: - Float division
+//
+// For Complex<Float>, promote to Double and use the naive expression.
+// Products of Float values are exact in Double, and the squared length of
+// any non-zero finite Complex<Float> is comfortably within the normal range
+// of Double, so none of the rescaling that the generic operator may need is
+// required; the only branch is for zero and non-finite divisors, which keep
+// the generic semantics. Each component is rounded to Float once.
+//
+// This is an overload for concrete Complex<Float>, so it is chosen at
+// compile time; generic code continues to use the operator above.
+extension Complex where RealType == Float {
+  @_transparent
+  public static func /(z: Complex, w: Complex) -> Complex {
+    guard w.isFinite && !w.isZero else { return rescaledDivide(z, w) }
+    let a = Double(z.x), b = Double(z.y)
+    let c = Double(w.x), d = Double(w.y)
+    let lenSq = c*c + d*d
+    return Complex(Float((a*c + b*d)/lenSq), Float((b*c - a*d)/lenSq))
+  }
+
+  @_transparent
+  public static func /=(z: inout Complex, w: Complex) {
+    z = z / w
+  }
+}
@@ -0,0 +1,251 @@
+//===--- BatchedArithmetic.swift ------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+
+// Arithmetic on buffers of interleaved complex values.
+//
+// As with the batched functions in RealModule, the output buffer may be the
+// same as an input buffer, but must not partially overlap any input.
+
+// MARK: - Division
+extension Complex {
+  /// Divides each element of `data` by `divisor`, storing the results to
+  /// `result`.
+  ///
+  /// If `divisor` is well-scaled, this multiplies every element by its
+  /// reciprocal rather than dividing (see `reciprocal`), so results may
+  /// differ very slightly from `data[i] / divisor`. Otherwise, every
+  /// element is computed as `data[i] / divisor`.
+  @inlinable
+  public static func divide(
+    _ data: UnsafeBufferPointer<Complex>,
+    by divisor: Complex,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    precondition(data.count == result.count,
+      "result must have the same count as data.")
+    // reciprocal is also non-nil for zero and non-finite divisors, where
+    // multiplying is not the same as dividing (∞/∞ is zero, but ∞*0 is not).
+    if divisor.isFinite && !divisor.isZero, let recip = divisor.reciprocal {
+      for i in data.indices { result[i] = data[i] * recip }
+    } else {
+      for i in data.indices { result[i] = data[i] / divisor }
+    }
+  }
+
+  /// Replaces each element of `data` with that element divided by `divisor`.
+  ///
+  /// See `divide(_:by:into:)` for details.
+  @inlinable
+  public static func divide(
+    _ data: UnsafeMutableBufferPointer<Complex>,
+    by divisor: Complex
+  ) {
+    divide(UnsafeBufferPointer(data), by: divisor, into: data)
+  }
+
+  /// Divides each element of `z` by the corresponding element of `w`,
+  /// storing the results to `result`.
+  ///
+  /// Each element of `result` is exactly `z[i] / w[i]`, but unlike a loop
+  /// over `/`, the common case of well-scaled divisors is vectorizable.
+  @inlinable
+  public static func divide(
+    _ z: UnsafeBufferPointer<Complex>,
+    _ w: UnsafeBufferPointer<Complex>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    precondition(z.count == w.count && z.count == result.count,
+      "z, w and result must have the same count.")
+    // Work in blocks: first check whether every divisor in the block is
+    // well-scaled (a branch-free reduction), and if so use the naive
+    // expression for the whole block. Otherwise fall back on scalar division
+    // for that block, which rescales only the elements that need it.
+    // Because each element is read before it is written, this is safe when
+    // result is the same buffer as z or w.
+    let blockSize = 64
+    var start = 0
+    while start < z.count {
+      let end = min(start + blockSize, z.count)
+      var slow = 0
+      for i in start ..< end {
+        slow |= w[i].lengthSquared.isNormal ? 0 : 1
+      }
+      if slow != 0 {
+        for i in start ..< end { result[i] = z[i] / w[i] }
+      } else {
+        for i in start ..< end {
+          let lenSq = w[i].lengthSquared
+          result[i] = z[i] * w[i].conjugate.divided(by: lenSq)
+        }
+      }
+      start = end
+    }
+  }
+}
+
+// For Complex<Float>, the division operator works in Double (see
+// Arithmetic.swift), so the elementwise division does too. Like that
+// operator, this overload is chosen at compile time.
+extension Complex where RealType == Float {
+  /// Divides each element of `z` by the corresponding element of `w`,
+  /// storing the results to `result`.
+  ///
+  /// Each element of `result` is exactly `z[i] / w[i]`, but unlike a loop
+  /// over `/`, the common case of finite, non-zero divisors is
+  /// vectorizable.
+  @inlinable
+  public static func divide(
+    _ z: UnsafeBufferPointer<Complex>,
+    _ w: UnsafeBufferPointer<Complex>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    precondition(z.count == w.count && z.count == result.count,
+      "z, w and result must have the same count.")
+    // The same blocking as the generic division, but promoted to Double
+    // the naive expression only needs zero and non-finite divisors to be
+    // handled separately.
+    let blockSize = 64
+    var start = 0
+    while start < z.count {
+      let end = min(start + blockSize, z.count)
+      var slow = 0
+      for i in start ..< end {
+        slow |= w[i].isFinite && !w[i].isZero ? 0 : 1
+      }
+      if slow != 0 {
+        for i in start ..< end { result[i] = z[i] / w[i] }
+      } else {
+        for i in start ..< end {
+          let x = Double(z[i].x), y = Double(z[i].y)
+          let u = Double(w[i].x), v = Double(w[i].y)
+          let lenSq = u*u + v*v
+          result[i] = Complex(Float((x*u + y*v)/lenSq), Float((y*u - x*v)/lenSq))
+        }
+      }
+      start = end
+    }
+  }
+}
+
+// MARK: - Dot products and axpy
+extension Complex {
+  /// The sum of the elementwise products of `x` and `y`, `Σ x[i]*y[i]`.
+  ///
+  /// Neither operand is conjugated (this corresponds to BLAS `cdotu` and
+  /// `zdotu`); see `conjugateDot` for the inner product.
+  ///
+  /// - Parameters:
+  ///   - compensated: If `false` (the default), products are accumulated
+  ///     with fused multiply-adds into several independent partial sums,
+  ///     which is fast, but has the usual rounding error growth. If `true`,
+  ///     products and sums are accumulated with augmented arithmetic, so
+  ///     that the result is about as accurate as if it had been computed
+  ///     with twice the precision of `RealType` and then rounded.
+  @inlinable
+  public static func dot(
+    _ x: UnsafeBufferPointer<Complex>,
+    _ y: UnsafeBufferPointer<Complex>,
+    compensated: Bool = false
+  ) -> Complex {
+    precondition(x.count == y.count, "x and y must have the same count.")
+    if compensated { return _compensatedDot(x, y, conjugate: false) }
+    return _dot(x, y, conjugate: false)
+  }
+
+  /// The inner product of `x` and `y`, `Σ x[i].conjugate * y[i]`.
+  ///
+  /// This corresponds to BLAS `cdotc` and `zdotc`. See `dot` for the
+  /// meaning of `compensated`.
+  @inlinable
+  public static func conjugateDot(
+    _ x: UnsafeBufferPointer<Complex>,
+    _ y: UnsafeBufferPointer<Complex>,
+    compensated: Bool = false
+  ) -> Complex {
+    precondition(x.count == y.count, "x and y must have the same count.")
+    if compensated { return _compensatedDot(x, y, conjugate: true) }
+    return _dot(x, y, conjugate: true)
+  }
+
+  /// Replaces each element of `y` with `a*x[i] + y[i]`.
+  ///
+  /// Each element is computed with `multiplyAdd`.
+  @inlinable
+  public static func axpy(
+    a: Complex,
+    x: UnsafeBufferPointer<Complex>,
+    y: UnsafeMutableBufferPointer<Complex>
+  ) {
+    precondition(x.count == y.count, "x and y must have the same count.")
+    for i in x.indices { y[i] = multiplyAdd(a, x[i], y[i]) }
+  }
+
+  @usableFromInline @_transparent
+  internal static func _dot(
+    _ x: UnsafeBufferPointer<Complex>,
+    _ y: UnsafeBufferPointer<Complex>,
+    conjugate: Bool
+  ) -> Complex {
+    // Four independent accumulators hide the latency of the multiply-adds.
+    var s0 = Complex.zero, s1 = Complex.zero
+    var s2 = Complex.zero, s3 = Complex.zero
+    let n = x.count
+    var i = 0
+    while i + 4 <= n {
+      s0 = multiplyAdd(conjugate ? x[i].conjugate : x[i], y[i], s0)
+      s1 = multiplyAdd(conjugate ? x[i+1].conjugate : x[i+1], y[i+1], s1)
+      s2 = multiplyAdd(conjugate ? x[i+2].conjugate : x[i+2], y[i+2], s2)
+      s3 = multiplyAdd(conjugate ? x[i+3].conjugate : x[i+3], y[i+3], s3)
+      i += 4
+    }
+    while i < n {
+      s0 = multiplyAdd(conjugate ? x[i].conjugate : x[i], y[i], s0)
+      i += 1
+    }
+    return (s0 + s1) + (s2 + s3)
+  }
+
+  // Adds a*b to the compensated sum (s, c): the product is computed exactly
+  // as a head-tail pair, and the head is added to s exactly, with all of
+  // the rounding errors collected in c (this is the "Dot2" algorithm of
+  // Ogita, Rump and Oishi).
+  @usableFromInline @_transparent
+  internal static func _accumulate(
+    _ s: inout RealType, _ c: inout RealType, _ a: RealType, _ b: RealType
+  ) {
+    let p = Augmented.twoProdFMA(a, b)
+    let t = s.magnitude >= p.head.magnitude ?
+      Augmented.fastTwoSum(s, p.head) : Augmented.fastTwoSum(p.head, s)
+    s = t.head
+    c += t.tail + p.tail
+  }
+
+  @inlinable
+  internal static func _compensatedDot(
+    _ x: UnsafeBufferPointer<Complex>,
+    _ y: UnsafeBufferPointer<Complex>,
+    conjugate: Bool
+  ) -> Complex {
+    var sr = RealType.zero, cr = RealType.zero
+    var si = RealType.zero, ci = RealType.zero
+    for i in x.indices {
+      let a = conjugate ? x[i].conjugate : x[i]
+      let b = y[i]
+      _accumulate(&sr, &cr, a.x, b.x)
+      _accumulate(&sr, &cr, -a.y, b.y)
+      _accumulate(&si, &ci, a.x, b.y)
+      _accumulate(&si, &ci, a.y, b.x)
+    }
+    return Complex(sr + cr, si + ci)
+  }
+}
@@ -0,0 +1,163 @@
+//===--- BatchedPolar.swift -----------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+
+// Conversion between buffers of interleaved complex values and polar
+// coordinates.
+//
+// A loop over `polar` computes the length and phase separately, and each
+// of them branches on its edge cases, so it does not vectorize, and the
+// phase costs a call to atan2 per element. `toPolar` instead computes both
+// in one pass with no data-dependent branches: the phase comes from a
+// single argument reduction to |r| ≤ tan(π/8), followed by a polynomial
+// evaluated over the whole block. Elements for which that is not accurate
+// (zero, non-finite, or with a squared length that overflows or is not
+// normal) are then fixed by a second scan, which rescales only those lanes.
+
+// MARK: - Polar coordinates
+extension Complex {
+  /// Stores the length and phase of each element of `z` to `lengths` and
+  /// `phases`.
+  ///
+  /// Each element of `lengths` is exactly `z[i].length`. Each element of
+  /// `phases` has the edge cases of `z[i].phase` (it is nan exactly when
+  /// that is), and otherwise differs from the exact phase by at most about
+  /// 3 ulps, where atan2 is usually within 1 ulp. Like atan2, it is in
+  /// [-π, π], with the sign of `z[i].imaginary`.
+  @inlinable
+  public static func toPolar(
+    _ z: UnsafeBufferPointer<Complex>,
+    lengths: UnsafeMutableBufferPointer<RealType>,
+    phases: UnsafeMutableBufferPointer<RealType>
+  ) {
+    precondition(z.count == lengths.count && z.count == phases.count,
+      "lengths and phases must have the same count as z.")
+    let tanPiOver8 = RealType.sqrt(2) - 1
+    let quarterPi = RealType.pi / 4
+    let halfPi = RealType.pi / 2
+    let series = _atanSeries
+    let blockSize = 256
+    let s = UnsafeMutableBufferPointer<RealType>.allocate(
+      capacity: min(blockSize, z.count)
+    )
+    defer { s.deallocate() }
+    var start = 0
+    while start < z.count {
+      let n = min(blockSize, z.count - start)
+      // With u and v the larger and smaller of |x| and |y|, the phase is
+      // built from atan(v/u). That is atan(r), with r = v/u, when v/u is
+      // at most tan(π/8), and π/4 + atan(r), with r = (v - u)/(v + u),
+      // otherwise. The reduced argument is kept in phases until the second
+      // loop, and its square in s.
+      for j in 0 ..< n {
+        let x = z[start + j].x, y = z[start + j].y
+        lengths[start + j] = .sqrt(x*x + y*y)
+        let u = max(x.magnitude, y.magnitude)
+        let v = min(x.magnitude, y.magnitude)
+        let big = v > tanPiOver8 * u
+        let r = (big ? v - u : v) / (big ? u + v : u)
+        phases[start + j] = r
+        s[j] = r*r
+      }
+      // atan(r) = r P(r²).
+      series.evaluate(at: UnsafeMutableBufferPointer(rebasing: s[0 ..< n]))
+      // Undo the reduction: swapping x and y reflects the phase through
+      // π/4, and negating x reflects it through π/2.
+      for j in 0 ..< n {
+        let x = z[start + j].x, y = z[start + j].y
+        let u = max(x.magnitude, y.magnitude)
+        let v = min(x.magnitude, y.magnitude)
+        let offset = v > tanPiOver8 * u ? quarterPi : 0
+        var a = RealType._mulAdd(phases[start + j], s[j], offset)
+        a = y.magnitude > x.magnitude ? halfPi - a : a
+        a = x.sign == .minus ? .pi - a : a
+        phases[start + j] = RealType(signOf: y, magnitudeOf: a)
+      }
+      start += n
+    }
+    // lengthSquared is not normal for zero and non-finite values, and when
+    // x*x + y*y overflows or underflows (which is also the only way v + u
+    // can overflow above); the scalar properties handle all of these.
+    for i in z.indices where !z[i].lengthSquared.isNormal {
+      lengths[i] = z[i].length
+      phases[i] = z[i].phase
+    }
+  }
+
+  /// Stores the complex values with polar coordinates `lengths[i]` and
+  /// `phases[i]` to `result`.
+  ///
+  /// Each element of `result` is `Complex(length: lengths[i], phase:
+  /// phases[i])`, with the same edge cases and preconditions, except that
+  /// when `RealType` is Float or Double the cosines and sines come from the
+  /// batched kernels in RealModule, which may differ from the host libm in
+  /// the last bit.
+  @inlinable
+  public static func fromPolar(
+    lengths: UnsafeBufferPointer<RealType>,
+    phases: UnsafeBufferPointer<RealType>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    precondition(lengths.count == phases.count && lengths.count == result.count,
+      "lengths, phases and result must have the same count.")
+    let blockSize = 256
+    let storage = UnsafeMutableBufferPointer<RealType>.allocate(
+      capacity: 2 * min(blockSize, lengths.count)
+    )
+    defer { storage.deallocate() }
+    var start = 0
+    while start < lengths.count {
+      let n = min(blockSize, lengths.count - start)
+      let c = UnsafeMutableBufferPointer(rebasing: storage[0 ..< n])
+      let s = UnsafeMutableBufferPointer(rebasing: storage[n ..< 2*n])
+      for j in 0 ..< n {
+        c[j] = phases[start + j]
+        s[j] = phases[start + j]
+      }
+      RealType._applyBatched(c,
+        float: { Float.cos($0) }, double: { Double.cos($0) },
+        scalar: { .cos($0) })
+      RealType._applyBatched(s,
+        float: { Float.sin($0) }, double: { Double.sin($0) },
+        scalar: { .sin($0) })
+      for j in 0 ..< n {
+        let r = lengths[start + j]
+        result[start + j] = Complex(c[j], s[j]).multiplied(by: r)
+      }
+      start += n
+    }
+    // Non-finite phases produce nan from the kernels; the initializer gives
+    // these their meaning (or traps).
+    for i in phases.indices where !phases[i].isFinite {
+      result[i] = Complex(length: lengths[i], phase: phases[i])
+    }
+  }
+
+  /// The Taylor series of atan(r)/r in r², truncated once its terms are
+  /// below a quarter of an ulp of 1 for |r| ≤ tan(π/8).
+  ///
+  /// This has 9 terms for Float and 20 for Double. The series alternates,
+  /// so the truncation error is at most the first omitted term.
+  @inlinable
+  internal static var _atanSeries: Polynomial<RealType> {
+    let tanPiOver8 = RealType.sqrt(2) - 1
+    let s = tanPiOver8 * tanPiOver8
+    var coefficients: [RealType] = []
+    var power: RealType = 1
+    while power / RealType(2*coefficients.count + 1) >= .ulpOfOne / 4 {
+      let sign: RealType = coefficients.count % 2 == 0 ? 1 : -1
+      coefficients.append(sign / RealType(2*coefficients.count + 1))
+      power *= s
+    }
+    return Polynomial(coefficients: coefficients)
+  }
+}
@@ -0,0 +1,238 @@
+//===--- BinaryRepresentation.swift ---------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+
+// Views of buffers of complex values as their components and as raw bytes,
+// and a compact binary encoding for them.
+//
+// `Complex<RealType>` is laid out as its real component followed by its
+// imaginary component, with no padding between them, so a buffer of n
+// complex values is a buffer of 2n interleaved real values. For Float and
+// Double, this is the layout of C's `float _Complex` and `double _Complex`,
+// C++'s `std::complex<float>` and `std::complex<double>`, and the
+// interleaved I/Q samples written by most capture hardware.
+//
+// The views here rely on that layout, and never copy. The array
+// initializers copy once, with a single memcpy. Codable, by contrast,
+// encodes every component separately, which is portable but is orders of
+// magnitude slower for large arrays; the binary encoding is the fast
+// alternative, with a fixed byte order so that it is portable too.
+
+// MARK: - Component views
+extension Complex {
+  /// Calls `body` with the components of the elements of `z`, as a buffer
+  /// of `2*z.count` real values in which the real and imaginary component
+  /// of each element alternate.
+  ///
+  /// The buffer is only valid for the duration of `body`.
+  @inlinable
+  public static func withUnsafeComponents<Result>(
+    of z: UnsafeBufferPointer<Complex>,
+    _ body: (UnsafeBufferPointer<RealType>) throws -> Result
+  ) rethrows -> Result {
+    // Memory bound to Complex is also bound to its components.
+    let x = UnsafeRawPointer(z.baseAddress)?
+      .assumingMemoryBound(to: RealType.self)
+    return try body(UnsafeBufferPointer(start: x, count: 2*z.count))
+  }
+
+  /// Calls `body` with the components of the elements of `z`, as a mutable
+  /// buffer of `2*z.count` real values in which the real and imaginary
+  /// component of each element alternate.
+  ///
+  /// The buffer is only valid for the duration of `body`.
+  @inlinable
+  public static func withUnsafeMutableComponents<Result>(
+    of z: UnsafeMutableBufferPointer<Complex>,
+    _ body: (UnsafeMutableBufferPointer<RealType>) throws -> Result
+  ) rethrows -> Result {
+    let x = UnsafeMutableRawPointer(z.baseAddress)?
+      .assumingMemoryBound(to: RealType.self)
+    return try body(UnsafeMutableBufferPointer(start: x, count: 2*z.count))
+  }
+
+  /// Calls `body` with the complex values stored in `bytes`, without
+  /// copying them.
+  ///
+  /// `bytes` must contain consecutive complex values in the native
+  /// representation of `Complex` (interleaved real and imaginary components
+  /// in the host's byte order), such as a region of a memory-mapped file
+  /// of samples, and must be aligned for `RealType`. The memory is bound to
+  /// `Complex`, so afterwards it must not be accessed as a different type
+  /// except through raw pointers.
+  ///
+  /// - Precondition: `bytes.count` is a multiple of
+  ///   `MemoryLayout<Complex>.stride`, and `bytes` is suitably aligned.
+  @inlinable
+  public static func withUnsafeBuffer<Result>(
+    overBytes bytes: UnsafeRawBufferPointer,
+    _ body: (UnsafeBufferPointer<Complex>) throws -> Result
+  ) rethrows -> Result {
+    let stride = MemoryLayout<Complex>.stride
+    precondition(bytes.count % stride == 0,
+      "bytes must contain a whole number of complex values.")
+    guard let base = bytes.baseAddress else {
+      return try body(UnsafeBufferPointer(start: nil, count: 0))
+    }
+    precondition(
+      Int(bitPattern: base) % MemoryLayout<Complex>.alignment == 0,
+      "bytes must be aligned for RealType."
+    )
+    let count = bytes.count / stride
+    let z = base.bindMemory(to: Complex.self, capacity: count)
+    return try body(UnsafeBufferPointer(start: z, count: count))
+  }
+}
+
+extension Array {
+  /// An array of the complex values stored in `bytes`, copied with a single
+  /// memcpy.
+  ///
+  /// `bytes` must contain consecutive complex values in the native
+  /// representation of `Complex` (interleaved real and imaginary components
+  /// in the host's byte order), as produced by `withUnsafeBytes` on an array
+  /// of complex values. Unlike `Complex.withUnsafeBuffer(overBytes:_:)`,
+  /// `bytes` need not be aligned.
+  ///
+  /// - Precondition: `bytes.count` is a multiple of
+  ///   `MemoryLayout<Complex<RealType>>.stride`, and `RealType` is a trivial
+  ///   type (as all of the standard library floating-point types are).
+  @inlinable
+  public init<RealType>(unsafeComplexBytes bytes: UnsafeRawBufferPointer)
+  where Element == Complex<RealType> {
+    precondition(_isPOD(RealType.self), "RealType must be a trivial type.")
+    let stride = MemoryLayout<Element>.stride
+    precondition(bytes.count % stride == 0,
+      "bytes must contain a whole number of complex values.")
+    let count = bytes.count / stride
+    self.init(unsafeUninitializedCapacity: count) { z, n in
+      if count > 0 {
+        UnsafeMutableRawPointer(z.baseAddress!).copyMemory(
+          from: bytes.baseAddress!, byteCount: bytes.count
+        )
+      }
+      n = count
+    }
+  }
+}
+
+// MARK: - Binary encoding
+extension Complex where RealType: BinaryFloatingPoint {
+  /// The number of bytes in the binary encoding of `count` complex values.
+  @inlinable
+  public static func encodedByteCount(count: Int) -> Int {
+    2 * count * MemoryLayout<RealType>.size
+  }
+
+  /// Stores the binary encoding of the elements of `z` to `bytes`.
+  ///
+  /// The encoding is the interleaved real and imaginary components of each
+  /// element, each in the little-endian IEEE 754 interchange format of
+  /// `RealType` (for `Complex<Float>`, the common interleaved 32-bit float
+  /// I/Q format). It has no header, so the count and type must be known to
+  /// the reader. On little-endian hosts, this is a single memcpy; elsewhere
+  /// each component is byte-swapped.
+  ///
+  /// - Precondition: `bytes.count` is `encodedByteCount(count: z.count)`,
+  ///   and `RealType` is an IEEE 754 interchange format (it is not
+  ///   `Float80`).
+  @inlinable
+  public static func encode(
+    _ z: UnsafeBufferPointer<Complex>,
+    into bytes: UnsafeMutableRawBufferPointer
+  ) {
+    precondition(bytes.count == encodedByteCount(count: z.count),
+      "bytes must have room for exactly the encoding of z.")
+    withUnsafeComponents(of: z) {
+      _copyLittleEndian(UnsafeRawBufferPointer($0), into: bytes)
+    }
+  }
+
+  /// Stores the complex values whose binary encoding is `bytes` to `z`.
+  ///
+  /// This is the inverse of `encode(_:into:)`. `bytes` need not be aligned.
+  ///
+  /// - Precondition: `bytes.count` is `encodedByteCount(count: z.count)`,
+  ///   and `RealType` is an IEEE 754 interchange format (it is not
+  ///   `Float80`).
+  @inlinable
+  public static func decode(
+    _ bytes: UnsafeRawBufferPointer,
+    into z: UnsafeMutableBufferPointer<Complex>
+  ) {
+    precondition(bytes.count == encodedByteCount(count: z.count),
+      "bytes must contain exactly the encoding of z.")
+    withUnsafeMutableComponents(of: z) {
+      _copyLittleEndian(bytes, into: UnsafeMutableRawBufferPointer($0))
+    }
+  }
+
+  /// The binary encoding of the elements of `z`.
+  ///
+  /// See `encode(_:into:)` for the format.
+  @inlinable
+  public static func encoded(_ z: [Complex]) -> [UInt8] {
+    let n = encodedByteCount(count: z.count)
+    return [UInt8](unsafeUninitializedCapacity: n) { bytes, count in
+      z.withUnsafeBufferPointer {
+        encode($0, into: UnsafeMutableRawBufferPointer(bytes))
+      }
+      count = n
+    }
+  }
+
+  /// The complex values whose binary encoding is `bytes`.
+  ///
+  /// See `encode(_:into:)` for the format.
+  ///
+  /// - Precondition: `bytes.count` is a multiple of the size of two
+  ///   components.
+  @inlinable
+  public static func decoded(_ bytes: UnsafeRawBufferPointer) -> [Complex] {
+    let size = encodedByteCount(count: 1)
+    precondition(bytes.count % size == 0,
+      "bytes must contain a whole number of complex values.")
+    let n = bytes.count / size
+    return [Complex](unsafeUninitializedCapacity: n) { z, count in
+      decode(bytes, into: z)
+      count = n
+    }
+  }
+
+  // Copies the components in source to target, converting between host
+  // and little-endian byte order. The two have the same count, a multiple
+  // of the size of RealType.
+  @inlinable
+  internal static func _copyLittleEndian(
+    _ source: UnsafeRawBufferPointer,
+    into target: UnsafeMutableRawBufferPointer
+  ) {
+    let size = MemoryLayout<RealType>.size
+    // size == stride is not enough: Float80 is 16 bytes, with 6 of padding.
+    precondition(
+      1 + RealType.exponentBitCount + RealType.significandBitCount == 8 * size,
+      "RealType must be an IEEE 754 interchange format."
+    )
+    guard source.count > 0 else { return }
+    if 1.littleEndian == 1 {
+      target.baseAddress!.copyMemory(
+        from: source.baseAddress!, byteCount: source.count
+      )
+      return
+    }
+    for start in stride(from: 0, to: source.count, by: size) {
+      for k in 0 ..< size {
+        target[start + k] = source[start + size - 1 - k]
+      }
+    }
+  }
+}
@@ -44,6 +44,13 @@ import RealModule
 /// the infinity norm avoids this problem entirely without significant
 /// downsides. You can access the Euclidean norm using the `length`
 /// property.
+///
+/// The memory layout of `Complex` is part of its interface: the real
+/// component is stored first, followed by the imaginary component, with no
+/// padding between them. `Complex<Float>` and `Complex<Double>` therefore
+/// have the layout of C's `float _Complex` and `double _Complex`, and an
+/// array of complex values is an array of interleaved components (see
+/// `withUnsafeComponents(of:_:)`).
 @frozen
 public struct Complex<RealType> where RealType: Real {
   //  A note on the `x` and `y` properties
@@ -348,6 +355,8 @@ extension Complex: Hashable {
 
 // MARK: - Conformance to Codable
 // FloatingPoint does not refine Codable, so this is a conditional conformance.
+// Each component is encoded separately; for large arrays, the binary
+// encoding in BinaryRepresentation.swift is much faster.
 extension Complex: Decodable where RealType: Decodable {
   public init(from decoder: Decoder) throws {
     var unkeyedContainer = try decoder.unkeyedContainer()
@@ -426,6 +435,9 @@ extension Complex {
   //  of representable values.
   @usableFromInline
   internal var carefulLength: RealType {
+    #if SWIFT_NUMERICS_INSTRUMENTATION
+    SlowPathCounters._record(.carefulLength)
+    #endif
     guard isFinite else { return .infinity }
     return .hypot(x, y)
   }
@@ -0,0 +1,188 @@
+//===--- ComplexBuffer+ElementaryFunctions.swift --------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+
+// Elementwise length, phase, exp, log and sqrt of a ComplexBuffer.
+//
+// The scalar functions branch on the edge cases (non-finite values, badly
+// scaled lengths, points near the unit circle), which keeps loops over them
+// from vectorizing. Each function here instead makes two passes:
+//
+// - a fast path, evaluated for every element with no data-dependent
+//   branches, using the batched real kernels from RealModule when RealType
+//   is Float or Double;
+//
+// - a fix-up pass, which gathers the indices of the elements for which the
+//   fast path is not accurate and recomputes only those. When there are
+//   none, which is the common case, this is a single scan with no
+//   allocation.
+//
+// The results have the accuracy of the scalar functions. They are exactly
+// the scalar results for length, phase and sqrt; exp and log use the
+// batched real kernels, which may differ from the host libm in the last
+// bit.
+
+extension ComplexBuffer {
+  /// The indices of the elements that satisfy `predicate`, which is passed
+  /// the real and imaginary components.
+  @usableFromInline @_transparent
+  internal func _indices(
+    where predicate: (RealType, RealType) -> Bool
+  ) -> [Int] {
+    var result: [Int] = []
+    withUnsafeBufferPointers { re, im in
+      for i in re.indices where predicate(re[i], im[i]) {
+        result.append(i)
+      }
+    }
+    return result
+  }
+
+  /// The length of each element.
+  ///
+  /// Each element of the result is exactly `self[i].length`.
+  @inlinable
+  public var length: [RealType] {
+    var result = lengthSquared
+    result.withUnsafeMutableBufferPointer { r in
+      for i in r.indices { r[i] = .sqrt(r[i]) }
+    }
+    for i in _indices(where: { !($0*$0 + $1*$1).isNormal }) {
+      result[i] = self[i].length
+    }
+    return result
+  }
+
+  /// The phase (argument) of each element.
+  ///
+  /// Each element of the result is exactly `self[i].phase`, so it is nan
+  /// for elements that are zero or non-finite.
+  @inlinable
+  public var phase: [RealType] {
+    var result = withUnsafeBufferPointers { re, im in
+      [RealType](unsafeUninitializedCapacity: re.count) { r, n in
+        for i in re.indices {
+          (r.baseAddress! + i).initialize(to: .atan2(y: im[i], x: re[i]))
+        }
+        n = re.count
+      }
+    }
+    let special = _indices(where: {
+      !($0.isFinite && $1.isFinite) || ($0 == 0 && $1 == 0)
+    })
+    for i in special { result[i] = .nan }
+    return result
+  }
+
+  /// `Complex.exp` of each element of `z`.
+  @inlinable
+  public static func exp(_ z: ComplexBuffer) -> ComplexBuffer {
+    // exp(x + iy) = exp(x) cos(y) + i exp(x) sin(y), which is accurate
+    // unless z is not finite, or exp(x) overflows while the result does not.
+    var result = z
+    var cos = z._imaginary
+    result.withUnsafeMutableBufferPointers { re, im in
+      RealType._applyBatched(re,
+        float: { Float.exp($0) }, double: { Double.exp($0) },
+        scalar: { .exp($0) })
+      RealType._applyBatched(im,
+        float: { Float.sin($0) }, double: { Double.sin($0) },
+        scalar: { .sin($0) })
+      cos.withUnsafeMutableBufferPointer { c in
+        RealType._applyBatched(c,
+          float: { Float.cos($0) }, double: { Double.cos($0) },
+          scalar: { .cos($0) })
+        for i in re.indices {
+          (re[i], im[i]) = (c[i]*re[i], im[i]*re[i])
+        }
+      }
+    }
+    let bound = RealType.log(.greatestFiniteMagnitude) - 1
+    let special = z._indices(where: {
+      !($0.isFinite && $1.isFinite && $0 < bound)
+    })
+    for i in special { result[i] = .exp(z[i]) }
+    return result
+  }
+
+  /// `Complex.log` of each element of `z`.
+  @inlinable
+  public static func log(_ z: ComplexBuffer) -> ComplexBuffer {
+    // The real part of log(z) is log(|z|²)/2. Away from the unit circle
+    // this is accurate as long as |z|² is normal; there is no cancellation,
+    // because |log(|z|²)| ≥ log(2) when |z|² is outside [1/2, 2]. The
+    // imaginary part is the phase.
+    var result = ComplexBuffer(real: z.lengthSquared, imaginary: z.phase)
+    result.withUnsafeMutableBufferPointers { re, _ in
+      RealType._applyBatched(re,
+        float: { Float.log($0) }, double: { Double.log($0) },
+        scalar: { .log($0) })
+      for i in re.indices { re[i] /= 2 }
+    }
+    // Near the unit circle, the real part is log(onePlus: |z|² - 1)/2, with
+    // |z|² - 1 computed from exact products as in Complex.log. These lanes
+    // are gathered into a dense buffer, so the batched log(onePlus:) kernel
+    // can be used for them as well.
+    let near = z._indices(where: {
+      let lengthSquared = $0*$0 + $1*$1
+      return 2*lengthSquared >= 1 && lengthSquared <= 2
+    })
+    if !near.isEmpty {
+      var s = near.map { i -> RealType in
+        let u = max(z._real[i].magnitude, z._imaginary[i].magnitude)
+        let v = min(z._real[i].magnitude, z._imaginary[i].magnitude)
+        let (a, b) = Augmented.twoProdFMA(u, u)
+        let (c, d) = Augmented.twoProdFMA(v, v)
+        let (h, e) = Augmented.twoSum(-1, a)
+        return (h + c) + e + b + d
+      }
+      s.withUnsafeMutableBufferPointer { s in
+        RealType._applyBatched(s,
+          float: { Float.log(onePlus: $0) },
+          double: { Double.log(onePlus: $0) },
+          scalar: { .log(onePlus: $0) })
+      }
+      for (j, i) in near.enumerated() { result._real[i] = s[j] / 2 }
+    }
+    // Zero, non-finite elements, and elements whose squared length
+    // overflows or underflows take the scalar path.
+    for i in z._indices(where: { !($0*$0 + $1*$1).isNormal }) {
+      result[i] = .log(z[i])
+    }
+    return result
+  }
+
+  /// `Complex.sqrt` of each element of `z`.
+  ///
+  /// Each element of the result is exactly `Complex.sqrt(z[i])`.
+  @inlinable
+  public static func sqrt(_ z: ComplexBuffer) -> ComplexBuffer {
+    // The same expressions as the fast path of Complex.sqrt, with the
+    // branch on the sign of x replaced by selects.
+    var result = z
+    result.withUnsafeMutableBufferPointers { re, im in
+      for i in re.indices {
+        let x = re[i], y = im[i]
+        let norm = RealType.sqrt(x*x + y*y)
+        let u = RealType.sqrt((norm + abs(x))/2)
+        let v = y / (2*u)
+        let positive = x.sign == .plus
+        re[i] = positive ? u : abs(v)
+        im[i] = positive ? v : RealType(signOf: y, magnitudeOf: u)
+      }
+    }
+    for i in z._indices(where: { !($0*$0 + $1*$1).isNormal }) {
+      result[i] = .sqrt(z[i])
+    }
+    return result
+  }
+}
@@ -0,0 +1,408 @@
+//===--- ComplexBuffer.swift ----------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+
+/// A collection of complex numbers whose real and imaginary components are
+/// stored in two separate contiguous arrays ("split" or
+/// "structure-of-arrays" layout).
+///
+/// `[Complex<RealType>]` stores interleaved `(real, imaginary)` pairs,
+/// which is the layout C, C++ and Fortran use and the one to use when
+/// interoperating with them. Arithmetic on long interleaved arrays, however,
+/// spends much of its time shuffling components into place; with split
+/// storage the elementwise operations on `ComplexBuffer` are straight-line
+/// loops over real arrays that the compiler can vectorize directly.
+///
+/// ```swift
+/// let samples: [Complex<Float>] = ...
+/// var z = ComplexBuffer(samples)
+/// z *= ComplexBuffer(repeating: Complex(0, 1), count: z.count)
+/// let power = z.lengthSquared
+/// let result = Array(z)  // back to [Complex<Float>]
+/// ```
+///
+/// `ComplexBuffer` is a `RandomAccessCollection` and `MutableCollection`
+/// of `Complex<RealType>`, so it can be read and written elementwise (and
+/// passed to generic code) without converting it back to an array first.
+/// Like `Array`, it is a value type with copy-on-write storage.
+///
+/// The raw components are available through the `real` and `imaginary`
+/// arrays. Unlike the `real` and `imaginary` properties of `Complex`, these
+/// are the stored values, and are not replaced by `nan` for non-finite
+/// elements.
+///
+/// All of the binary operations require that both operands have the same
+/// count.
+public struct ComplexBuffer<RealType> where RealType: Real {
+
+  @usableFromInline
+  internal var _real: [RealType]
+
+  @usableFromInline
+  internal var _imaginary: [RealType]
+
+  /// The real components of the elements.
+  @inlinable
+  public var real: [RealType] { _real }
+
+  /// The imaginary components of the elements.
+  @inlinable
+  public var imaginary: [RealType] { _imaginary }
+
+  /// A buffer with the specified real and imaginary components.
+  ///
+  /// - Precondition: `real` and `imaginary` have the same count.
+  @inlinable
+  public init(real: [RealType], imaginary: [RealType]) {
+    precondition(real.count == imaginary.count,
+      "real and imaginary must have the same count.")
+    self._real = real
+    self._imaginary = imaginary
+  }
+
+  /// An empty buffer.
+  @inlinable
+  public init() {
+    self.init(real: [], imaginary: [])
+  }
+
+  /// A buffer of `count` copies of `value`.
+  @inlinable
+  public init(repeating value: Complex<RealType>, count: Int) {
+    self.init(
+      real: [RealType](repeating: value.x, count: count),
+      imaginary: [RealType](repeating: value.y, count: count)
+    )
+  }
+
+  /// A buffer containing the elements of `elements`, converted to split
+  /// storage.
+  @inlinable
+  public init<S>(_ elements: S)
+  where S: Sequence, S.Element == Complex<RealType> {
+    if let buffer = elements.withContiguousStorageIfAvailable({ z in
+      ComplexBuffer(unsafeUninitializedCount: z.count) { re, im in
+        for i in z.indices {
+          (re.baseAddress! + i).initialize(to: z[i].x)
+          (im.baseAddress! + i).initialize(to: z[i].y)
+        }
+      }
+    }) {
+      self = buffer
+      return
+    }
+    self.init()
+    reserveCapacity(elements.underestimatedCount)
+    for z in elements { append(z) }
+  }
+
+  /// A buffer of `count` elements, whose components are initialized by
+  /// `initializer`.
+  ///
+  /// `initializer` must initialize every element of both buffers, and must
+  /// not throw after initializing any element.
+  @inlinable
+  public init(
+    unsafeUninitializedCount count: Int,
+    initializingWith initializer: (
+      UnsafeMutableBufferPointer<RealType>,
+      UnsafeMutableBufferPointer<RealType>
+    ) throws -> Void
+  ) rethrows {
+    var im: [RealType] = []
+    let re = try [RealType](unsafeUninitializedCapacity: count) { re, n in
+      im = try [RealType](unsafeUninitializedCapacity: count) { im, m in
+        try initializer(re, im)
+        m = count
+      }
+      n = count
+    }
+    self.init(real: re, imaginary: im)
+  }
+
+  /// Adds `z` to the end of the buffer.
+  @inlinable
+  public mutating func append(_ z: Complex<RealType>) {
+    _real.append(z.x)
+    _imaginary.append(z.y)
+  }
+
+  /// Reserves enough space to store `minimumCapacity` elements.
+  @inlinable
+  public mutating func reserveCapacity(_ minimumCapacity: Int) {
+    _real.reserveCapacity(minimumCapacity)
+    _imaginary.reserveCapacity(minimumCapacity)
+  }
+
+  /// Calls `body` with pointers to the real and imaginary components.
+  @inlinable
+  public func withUnsafeBufferPointers<Result>(
+    _ body: (
+      UnsafeBufferPointer<RealType>,
+      UnsafeBufferPointer<RealType>
+    ) throws -> Result
+  ) rethrows -> Result {
+    try _real.withUnsafeBufferPointer { re in
+      try _imaginary.withUnsafeBufferPointer { im in
+        try body(re, im)
+      }
+    }
+  }
+
+  /// Calls `body` with mutable pointers to the real and imaginary components.
+  ///
+  /// `body` must not change the count of either buffer.
+  @inlinable
+  public mutating func withUnsafeMutableBufferPointers<Result>(
+    _ body: (
+      UnsafeMutableBufferPointer<RealType>,
+      UnsafeMutableBufferPointer<RealType>
+    ) throws -> Result
+  ) rethrows -> Result {
+    try _real.withUnsafeMutableBufferPointer { re in
+      try _imaginary.withUnsafeMutableBufferPointer { im in
+        try body(re, im)
+      }
+    }
+  }
+}
+
+// MARK: - Collection conformances
+extension ComplexBuffer: RandomAccessCollection, MutableCollection {
+  public typealias Index = Int
+  public typealias Indices = Range<Int>
+
+  @_transparent
+  public var startIndex: Int { 0 }
+
+  @_transparent
+  public var endIndex: Int { _real.count }
+
+  @inlinable
+  public subscript(position: Int) -> Complex<RealType> {
+    get { Complex(_real[position], _imaginary[position]) }
+    set {
+      _real[position] = newValue.x
+      _imaginary[position] = newValue.y
+    }
+  }
+}
+
+extension ComplexBuffer: ExpressibleByArrayLiteral {
+  @inlinable
+  public init(arrayLiteral elements: Complex<RealType>...) {
+    self.init(elements)
+  }
+}
+
+extension ComplexBuffer: Equatable {
+  @inlinable
+  public static func ==(a: ComplexBuffer, b: ComplexBuffer) -> Bool {
+    a.elementsEqual(b)
+  }
+}
+
+extension ComplexBuffer: CustomStringConvertible {
+  public var description: String {
+    "[" + map { $0.description }.joined(separator: ", ") + "]"
+  }
+}
+
+extension Array {
+  /// An array containing the elements of `buffer`, converted to interleaved
+  /// storage.
+  @inlinable
+  public init<RealType>(_ buffer: ComplexBuffer<RealType>)
+  where Element == Complex<RealType> {
+    self = buffer.withUnsafeBufferPointers { re, im in
+      [Element](unsafeUninitializedCapacity: re.count) { z, n in
+        for i in re.indices {
+          (z.baseAddress! + i).initialize(to: Complex(re[i], im[i]))
+        }
+        n = re.count
+      }
+    }
+  }
+}
+
+// MARK: - Elementwise operations
+extension ComplexBuffer {
+  // Applies `f` to the components of corresponding elements of `a` and `b`.
+  // The loop operates directly on the component arrays, so that it can be
+  // vectorized.
+  @usableFromInline @_transparent
+  internal static func _map(
+    _ a: ComplexBuffer, _ b: ComplexBuffer,
+    _ f: (RealType, RealType, RealType, RealType) -> (RealType, RealType)
+  ) -> ComplexBuffer {
+    precondition(a.count == b.count, "operands must have the same count.")
+    return a.withUnsafeBufferPointers { ar, ai in
+      b.withUnsafeBufferPointers { br, bi in
+        ComplexBuffer(unsafeUninitializedCount: a.count) { re, im in
+          for i in 0 ..< re.count {
+            let (u, v) = f(ar[i], ai[i], br[i], bi[i])
+            (re.baseAddress! + i).initialize(to: u)
+            (im.baseAddress! + i).initialize(to: v)
+          }
+        }
+      }
+    }
+  }
+
+  // Replaces the components of each element of `a` with `f` applied to
+  // it and the corresponding element of `b`, without allocating.
+  @usableFromInline @_transparent
+  internal static func _update(
+    _ a: inout ComplexBuffer, _ b: ComplexBuffer,
+    _ f: (RealType, RealType, RealType, RealType) -> (RealType, RealType)
+  ) {
+    precondition(a.count == b.count, "operands must have the same count.")
+    b.withUnsafeBufferPointers { br, bi in
+      a.withUnsafeMutableBufferPointers { re, im in
+        for i in 0 ..< re.count {
+          (re[i], im[i]) = f(re[i], im[i], br[i], bi[i])
+        }
+      }
+    }
+  }
+
+  @inlinable
+  public static func +(a: ComplexBuffer, b: ComplexBuffer) -> ComplexBuffer {
+    _map(a, b) { ($0 + $2, $1 + $3) }
+  }
+
+  @inlinable
+  public static func -(a: ComplexBuffer, b: ComplexBuffer) -> ComplexBuffer {
+    _map(a, b) { ($0 - $2, $1 - $3) }
+  }
+
+  /// The elementwise product of `a` and `b`.
+  @inlinable
+  public static func *(a: ComplexBuffer, b: ComplexBuffer) -> ComplexBuffer {
+    _map(a, b) { ($0*$2 - $1*$3, $0*$3 + $1*$2) }
+  }
+
+  /// The elementwise quotient of `a` and `b`.
+  ///
+  /// Each element of the result is exactly `a[i] / b[i]`.
+  @inlinable
+  public static func /(a: ComplexBuffer, b: ComplexBuffer) -> ComplexBuffer {
+    // As with scalar division, first try the naive expression for every
+    // element. This is branch-free, so it vectorizes; the few elements whose
+    // divisor is not well-scaled are then recomputed carefully.
+    var result = _map(a, b) {
+      let lenSq = $2*$2 + $3*$3
+      let c = $2/lenSq
+      let d = -$3/lenSq
+      return ($0*c - $1*d, $0*d + $1*c)
+    }
+    result._fixupDivide(a, b)
+    return result
+  }
+
+  @usableFromInline
+  internal mutating func _fixupDivide(_ a: ComplexBuffer, _ b: ComplexBuffer) {
+    for i in b.indices {
+      let w = b[i]
+      if !w.lengthSquared.isNormal {
+        self[i] = Complex.rescaledDivide(a[i], w)
+      }
+    }
+  }
+
+  @inlinable
+  public static func +=(a: inout ComplexBuffer, b: ComplexBuffer) {
+    _update(&a, b) { ($0 + $2, $1 + $3) }
+  }
+
+  @inlinable
+  public static func -=(a: inout ComplexBuffer, b: ComplexBuffer) {
+    _update(&a, b) { ($0 - $2, $1 - $3) }
+  }
+
+  @inlinable
+  public static func *=(a: inout ComplexBuffer, b: ComplexBuffer) {
+    _update(&a, b) { ($0*$2 - $1*$3, $0*$3 + $1*$2) }
+  }
+
+  @inlinable
+  public static func /=(a: inout ComplexBuffer, b: ComplexBuffer) {
+    a = a / b
+  }
+
+  /// The elementwise complex conjugate of this buffer.
+  @inlinable
+  public var conjugate: ComplexBuffer {
+    ComplexBuffer(real: _real, imaginary: _imaginary.map { -$0 })
+  }
+
+  /// The squared length `(real*real + imaginary*imaginary)` of each element.
+  ///
+  /// See `Complex.lengthSquared` for caveats about overflow and underflow.
+  @inlinable
+  public var lengthSquared: [RealType] {
+    withUnsafeBufferPointers { re, im in
+      [RealType](unsafeUninitializedCapacity: re.count) { r, n in
+        for i in re.indices {
+          (r.baseAddress! + i).initialize(to: re[i]*re[i] + im[i]*im[i])
+        }
+        n = re.count
+      }
+    }
+  }
+
+  /// The ∞-norm (`max(abs(real), abs(imaginary))`) of each element.
+  ///
+  /// As with `Complex.magnitude`, the magnitude of any non-finite element
+  /// is `.infinity`.
+  @inlinable
+  public var magnitude: [RealType] {
+    withUnsafeBufferPointers { re, im in
+      [RealType](unsafeUninitializedCapacity: re.count) { r, n in
+        for i in re.indices {
+          let finite = re[i].isFinite && im[i].isFinite
+          let m = finite ? max(abs(re[i]), abs(im[i])) : .infinity
+          (r.baseAddress! + i).initialize(to: m)
+        }
+        n = re.count
+      }
+    }
+  }
+}
+
+// For ComplexBuffer<Float>, divide as the Complex<Float> division operator
+// does, in Double. Like that operator, this overload is chosen at compile
+// time; generic code continues to use the division above.
+extension ComplexBuffer where RealType == Float {
+  /// The elementwise quotient of `a` and `b`.
+  ///
+  /// Each element of the result is exactly `a[i] / b[i]`.
+  @inlinable
+  public static func /(a: ComplexBuffer, b: ComplexBuffer) -> ComplexBuffer {
+    // Promoted to Double, the naive expression is the scalar operator's for
+    // every divisor but zero and non-finite ones, which are recomputed.
+    var result = _map(a, b) {
+      let x = Double($0), y = Double($1)
+      let u = Double($2), v = Double($3)
+      let lenSq = u*u + v*v
+      return (Float((x*u + y*v)/lenSq), Float((y*u - x*v)/lenSq))
+    }
+    result._fixupDivide(a, b)
+    return result
+  }
+
+  @inlinable
+  public static func /=(a: inout ComplexBuffer, b: ComplexBuffer) {
+    a = a / b
+  }
+}
+
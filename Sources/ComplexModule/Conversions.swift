@@ -0,0 +1,277 @@
+//===--- Conversions.swift ------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+
+// Conversions between complex types with concrete standard library real
+// types.
+//
+// The generic `init<Other: BinaryFloatingPoint>(_: Complex<Other>)` goes
+// through the generic BinaryFloatingPoint conversion, which is much slower
+// than the single instruction that converting between concrete types takes.
+// The overloads here are concrete, so they are preferred whenever both types
+// are known at the call site.
+//
+// The buffer conversions convert the components as one flat buffer of
+// scalars, which the optimizer vectorizes into packed conversions.
+
+extension Complex where RealType: BinaryFloatingPoint {
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @inlinable
+  public static func convert<Other>(
+    _ source: UnsafeBufferPointer<Complex<Other>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) where Other: BinaryFloatingPoint {
+    _convert(source, into: result) { RealType($0) }
+  }
+
+  // Converts the components of source as a flat buffer of scalars using
+  // convert. This is transparent so that convert is inlined into the loop.
+  @_transparent @usableFromInline
+  internal static func _convert<Other>(
+    _ source: UnsafeBufferPointer<Complex<Other>>,
+    into result: UnsafeMutableBufferPointer<Complex>,
+    _ convert: (Other) -> RealType
+  ) {
+    precondition(source.count == result.count,
+      "result must have the same count as source.")
+    guard let s = source.baseAddress, let r = result.baseAddress else { return }
+    // Complex is laid out as two consecutive RealType components.
+    let x = UnsafeRawPointer(s).assumingMemoryBound(to: Other.self)
+    let y = UnsafeMutableRawPointer(r).assumingMemoryBound(to: RealType.self)
+    for i in 0 ..< 2*source.count { y[i] = convert(x[i]) }
+  }
+}
+
+
+#if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+@available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *)
+extension Complex where RealType == Float16 {
+  /// `other` rounded to the nearest representable value of this type.
+  @_transparent
+  public init(_ other: Complex<Float>) {
+    self.init(Float16(other.x), Float16(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Float>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Float16($0) }
+  }
+
+  /// `other` rounded to the nearest representable value of this type.
+  @_transparent
+  public init(_ other: Complex<Double>) {
+    self.init(Float16(other.x), Float16(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Double>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Float16($0) }
+  }
+
+  #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+  /// `other` rounded to the nearest representable value of this type.
+  @_transparent
+  public init(_ other: Complex<Float80>) {
+    self.init(Float16(other.x), Float16(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Float80>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Float16($0) }
+  }
+  #endif
+}
+#endif
+
+extension Complex where RealType == Float {
+  #if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+  /// `other` rounded to the nearest representable value of this type.
+  @available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *)
+  @_transparent
+  public init(_ other: Complex<Float16>) {
+    self.init(Float(other.x), Float(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *)
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Float16>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Float($0) }
+  }
+  #endif
+
+  /// `other` rounded to the nearest representable value of this type.
+  @_transparent
+  public init(_ other: Complex<Double>) {
+    self.init(Float(other.x), Float(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Double>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Float($0) }
+  }
+
+  #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+  /// `other` rounded to the nearest representable value of this type.
+  @_transparent
+  public init(_ other: Complex<Float80>) {
+    self.init(Float(other.x), Float(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Float80>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Float($0) }
+  }
+  #endif
+}
+
+extension Complex where RealType == Double {
+  #if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+  /// `other` rounded to the nearest representable value of this type.
+  @available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *)
+  @_transparent
+  public init(_ other: Complex<Float16>) {
+    self.init(Double(other.x), Double(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *)
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Float16>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Double($0) }
+  }
+  #endif
+
+  /// `other` rounded to the nearest representable value of this type.
+  @_transparent
+  public init(_ other: Complex<Float>) {
+    self.init(Double(other.x), Double(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Float>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Double($0) }
+  }
+
+  #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+  /// `other` rounded to the nearest representable value of this type.
+  @_transparent
+  public init(_ other: Complex<Float80>) {
+    self.init(Double(other.x), Double(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Float80>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Double($0) }
+  }
+  #endif
+}
+
+#if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+extension Complex where RealType == Float80 {
+  #if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+  /// `other` rounded to the nearest representable value of this type.
+  @available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *)
+  @_transparent
+  public init(_ other: Complex<Float16>) {
+    self.init(Float80(other.x), Float80(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *)
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Float16>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Float80($0) }
+  }
+  #endif
+
+  /// `other` rounded to the nearest representable value of this type.
+  @_transparent
+  public init(_ other: Complex<Float>) {
+    self.init(Float80(other.x), Float80(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Float>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Float80($0) }
+  }
+
+  /// `other` rounded to the nearest representable value of this type.
+  @_transparent
+  public init(_ other: Complex<Double>) {
+    self.init(Float80(other.x), Float80(other.y))
+  }
+
+  /// Converts each element of `source`, rounding to the nearest
+  /// representable value, and stores the results to `result`.
+  @inlinable
+  public static func convert(
+    _ source: UnsafeBufferPointer<Complex<Double>>,
+    into result: UnsafeMutableBufferPointer<Complex>
+  ) {
+    _convert(source, into: result) { Float80($0) }
+  }
+}
+#endif
@@ -35,6 +35,12 @@
 
 import RealModule
 
+// The public functions are pre-specialized for Float and Double. Callers
+// that are specialized inline their own copies anyway; the specializations
+// are for generic code in other modules that was not specialized, which
+// calls the generic entry points in this module. Those check for the
+// specialized types once, up front, instead of reaching every real
+// operation through RealType's witness table.
 extension Complex: ElementaryFunctions {
   
   // MARK: - exp-like functions
@@ -53,21 +59,29 @@ extension Complex: ElementaryFunctions {
   /// less than 1 for most inputs (i.e. `exp(x)` may be infinity when
   /// `exp(x) cos(y)` would not be).
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func exp(_ z: Complex) -> Complex {
     guard z.isFinite else { return z }
     // If x < log(greatestFiniteMagnitude), then exp(x) does not overflow.
     // To protect ourselves against sketchy log or exp implementations in
     // an unknown host library, or slight rounding disagreements between
     // the two, subtract one from the bound for a little safety margin.
+    let (sin, cos) = RealType.sincos(z.y)
     guard z.x < RealType.log(.greatestFiniteMagnitude) - 1 else {
+      #if SWIFT_NUMERICS_INSTRUMENTATION
+      SlowPathCounters._record(.scaledExp)
+      #endif
       let halfScale = RealType.exp(z.x/2)
-      let phase = Complex(RealType.cos(z.y), RealType.sin(z.y))
+      let phase = Complex(cos, sin)
       return phase.multiplied(by: halfScale).multiplied(by: halfScale)
     }
-    return Complex(.cos(z.y), .sin(z.y)).multiplied(by: .exp(z.x))
+    return Complex(cos, sin).multiplied(by: .exp(z.x))
   }
   
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func expMinusOne(_ z: Complex) -> Complex {
     // exp(x + iy) - 1 = (exp(x) cos(y) - 1) + i exp(x) sin(y)
     //                   -------- u --------
@@ -112,15 +126,21 @@ extension Complex: ElementaryFunctions {
     // it can't be close enough to overcome the scaling from exp(z.x),
     // so the -1 term is _always_ negligable). So we simply handle
     // these cases exactly the same as exp(z).
+    let (sin, cos) = RealType.sincos(z.y)
     guard z.x < RealType.log(.greatestFiniteMagnitude) - 1 else {
+      #if SWIFT_NUMERICS_INSTRUMENTATION
+      SlowPathCounters._record(.scaledExp)
+      #endif
       let halfScale = RealType.exp(z.x/2)
-      let phase = Complex(RealType.cos(z.y), RealType.sin(z.y))
+      let phase = Complex(cos, sin)
       return phase.multiplied(by: halfScale).multiplied(by: halfScale)
     }
-    // Special cases out of the way, evaluate as discussed above.
+    // Special cases out of the way, evaluate as discussed above. All three
+    // of cos(y), sin(y) and cosMinusOne(y) come from the one sincos.
+    let cosMinusOne = RealType.cosMinusOne(sin: sin, cos: cos)
     return Complex(
-      RealType._mulAdd(.cos(z.y), .expMinusOne(z.x), .cosMinusOne(z.y)),
-      .exp(z.x) * .sin(z.y)
+      RealType._mulAdd(cos, .expMinusOne(z.x), cosMinusOne),
+      .exp(z.x) * sin
     )
   }
   
@@ -138,10 +158,13 @@ extension Complex: ElementaryFunctions {
   // modification here, you should almost surely make a parallel
   // modification to sinh below.
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func cosh(_ z: Complex) -> Complex {
     guard z.isFinite else { return z }
+    let (sin, cos) = RealType.sincos(z.y)
     guard z.x.magnitude < -RealType.log(.ulpOfOne) else {
-      let phase = Complex(RealType.cos(z.y), RealType.sin(z.y))
+      let phase = Complex(cos, sin)
       let firstScale = RealType.exp(z.x.magnitude/2)
       let secondScale = firstScale/2
       return phase.multiplied(by: firstScale).multiplied(by: secondScale)
@@ -158,32 +181,36 @@ extension Complex: ElementaryFunctions {
     // and cosh, and for those we should probably just provide our own
     // implementations of _those_, so for now let's keep it simple and
     // obviously correct.
-    return Complex(
-      RealType.cosh(z.x) * RealType.cos(z.y),
-      RealType.sinh(z.x) * RealType.sin(z.y)
-    )
+    //
+    // RealType.sinhcosh now evaluates both from a single expMinusOne,
+    // essentially as suggested above.
+    let (sinh, cosh) = RealType.sinhcosh(z.x)
+    return Complex(cosh * cos, sinh * sin)
   }
   
   // sinh(x + iy) = sinh(x) cos(y) + i cosh(x) sinh(y)
   //
   // See cosh above for algorithm details.
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func sinh(_ z: Complex) -> Complex {
     guard z.isFinite else { return z }
+    let (sin, cos) = RealType.sincos(z.y)
     guard z.x.magnitude < -RealType.log(.ulpOfOne) else {
-      let phase = Complex(RealType.cos(z.y), RealType.sin(z.y))
+      let phase = Complex(cos, sin)
       let firstScale = RealType.exp(z.x.magnitude/2)
       let secondScale = RealType(signOf: z.x, magnitudeOf: firstScale/2)
       return phase.multiplied(by: firstScale).multiplied(by: secondScale)
     }
-    return Complex(
-      RealType.sinh(z.x) * RealType.cos(z.y),
-      RealType.cosh(z.x) * RealType.sin(z.y)
-    )
+    let (sinh, cosh) = RealType.sinhcosh(z.x)
+    return Complex(sinh * cos, cosh * sin)
   }
   
   // tanh(z) = sinh(z) / cosh(z)
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func tanh(_ z: Complex) -> Complex {
     guard z.isFinite else { return z }
     // Note that when |x| is larger than -log(.ulpOfOne),
@@ -203,17 +230,26 @@ extension Complex: ElementaryFunctions {
     // componentwise error bounds, and is likely more efficient (because
     // it avoids the complex division, which is painful even when well-
     // scaled). This suffices to get us up and running.
-    return sinh(z) / cosh(z)
+    //
+    // sinh(z) and cosh(z) are assembled from the same four real values,
+    // so evaluate those once rather than calling sinh and cosh.
+    let (sin, cos) = RealType.sincos(z.y)
+    let (sinh, cosh) = RealType.sinhcosh(z.x)
+    return Complex(sinh * cos, cosh * sin) / Complex(cosh * cos, sinh * sin)
   }
   
   // cos(z) = cosh(iz)
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func cos(_ z: Complex) -> Complex {
     return cosh(Complex(-z.y, z.x))
   }
   
   // sin(z) = -i*sinh(iz)
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func sin(_ z: Complex) -> Complex {
     let w = sinh(Complex(-z.y, z.x))
     return Complex(w.y, -w.x)
@@ -221,6 +257,8 @@ extension Complex: ElementaryFunctions {
   
   // tan(z) = -i*tanh(iz)
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func tan(_ z: Complex) -> Complex {
     let w = tanh(Complex(-z.y, z.x))
     return Complex(w.y, -w.x)
@@ -228,6 +266,8 @@ extension Complex: ElementaryFunctions {
   
   // MARK: - log-like functions
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func log(_ z: Complex) -> Complex {
     // If z is zero or infinite, the phase is undefined, so the result is
     // the single exceptional value.
@@ -304,6 +344,9 @@ extension Complex: ElementaryFunctions {
       let r = v / u
       return Complex(.log(u) + .log(onePlus: r*r)/2, θ)
     }
+    #if SWIFT_NUMERICS_INSTRUMENTATION
+    SlowPathCounters._record(.compensatedLog)
+    #endif
     // Here we're in the tricky case; cancellation is likely to occur.
     // Instead of the factorization used above, we will want to evaluate
     // log(onePlus: u² + v² - 1)/2. This all boils down to accurately
@@ -328,6 +371,8 @@ extension Complex: ElementaryFunctions {
   }
   
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func log(onePlus z: Complex) -> Complex {
     // If either |x| or |y| is bounded away from the origin, we don't need
     // any extra precision, and can just literally compute log(1+z). Note
@@ -336,6 +381,9 @@ extension Complex: ElementaryFunctions {
     // is always exact by Sterbenz' lemma, so as long as log( ) produces
     // a good result, log(1+z) will too.
     guard 2*z.x.magnitude < 1 && z.y.magnitude < 1 else { return log(1+z) }
+    #if SWIFT_NUMERICS_INSTRUMENTATION
+    SlowPathCounters._record(.compensatedLogOnePlus)
+    #endif
     // z is in (±0.5, ±1), so we need to evaluate more carefully.
     // The imaginary part is straightforward:
     let θ = (1+z).phase
@@ -361,6 +409,8 @@ extension Complex: ElementaryFunctions {
   }
   
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func acos(_ z: Complex) -> Complex {
     Complex(
       2*RealType.atan2(y: sqrt(1-z).real, x: sqrt(1+z).real),
@@ -369,6 +419,8 @@ extension Complex: ElementaryFunctions {
   }
   
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func asin(_ z: Complex) -> Complex {
     Complex(
       RealType.atan2(y: z.x, x: (sqrt(1-z) * sqrt(1+z)).real),
@@ -378,12 +430,16 @@ extension Complex: ElementaryFunctions {
   
   // atan(z) = -i*atanh(iz)
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func atan(_ z: Complex) -> Complex {
     let w = atanh(Complex(-z.y, z.x))
     return Complex(w.y, -w.x)
   }
   
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func acosh(_ z: Complex) -> Complex {
     Complex(
       RealType.asinh((sqrt(z-1).conjugate * sqrt(z+1)).real),
@@ -393,12 +449,16 @@ extension Complex: ElementaryFunctions {
   
   // asinh(z) = -i*asin(iz)
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func asinh(_ z: Complex) -> Complex {
     let w = asin(Complex(-z.y, z.x))
     return Complex(w.y, -w.x)
   }
   
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func atanh(_ z: Complex) -> Complex {
     // TODO: Kahan uses a much more complicated expression here; possibly
     // simply because he didn't have a complex log(1+z) with good
@@ -414,13 +474,42 @@ extension Complex: ElementaryFunctions {
   
   // MARK: - pow-like functions
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func pow(_ z: Complex, _ w: Complex) -> Complex {
     return exp(w * log(z))
   }
   
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func pow(_ z: Complex, _ n: Int) -> Complex {
+    pow(z, n, compensated: false)
+  }
+  
+  /// `z` raised to the integer power `n`.
+  ///
+  /// When |n| is at most 64, this is computed by repeated squaring, which
+  /// is much faster than evaluating `exp(n*log(z))`, and more accurate
+  /// for most small exponents. Like any sequence of multiplications, its
+  /// error bound grows with the number of multiplications; if
+  /// `compensated` is `true`, the products are instead accumulated in
+  /// double-word arithmetic using `Augmented.twoProdFMA`, which costs a
+  /// few times more, but makes the result about as accurate as a single
+  /// multiplication.
+  ///
+  /// When |n| is larger, or the result would overflow or underflow, the
+  /// result is computed as `exp(n*log(z))` regardless of `compensated`.
+  @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
+  public static func pow(
+    _ z: Complex, _ n: Int, compensated: Bool
+  ) -> Complex {
     if z.isZero { return .zero }
+    if let result = _powBySquaring(z, n, compensated: compensated) {
+      return result
+    }
     // TODO: this implementation is not quite correct, because n may be
     // rounded in conversion to RealType. This only effects very extreme
     // cases, so we'll leave it alone for now.
@@ -432,6 +521,8 @@ extension Complex: ElementaryFunctions {
   }
   
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func sqrt(_ z: Complex) -> Complex {
     let lengthSquared = z.lengthSquared
     if lengthSquared.isNormal {
@@ -454,6 +545,9 @@ extension Complex: ElementaryFunctions {
     // Handle edge cases:
     if z.isZero { return Complex(0, z.y) }
     if !z.isFinite { return z }
+    #if SWIFT_NUMERICS_INSTRUMENTATION
+    SlowPathCounters._record(.rescaledSqrt)
+    #endif
     // z is finite but badly-scaled. Rescale and replay by factoring out
     // the larger of x and y.
     let scale = RealType.maximum(abs(z.x), abs(z.y))
@@ -461,8 +555,15 @@ extension Complex: ElementaryFunctions {
   }
   
   @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
   public static func root(_ z: Complex, _ n: Int) -> Complex {
     if z.isZero { return .zero }
+    // For finite z, work in polar form (see _rootPolar); negative n
+    // computes the reciprocal of the corresponding positive root.
+    if z.isFinite && n != 0 && n != .min {
+      return n > 0 ? _rootPolar(z, n) : Complex.one / _rootPolar(z, -n)
+    }
     // TODO: this implementation is not quite correct, because n may be
     // rounded in conversion to RealType. This only effects very extreme
     // cases, so we'll leave it alone for now.
@@ -473,3 +574,209 @@ extension Complex: ElementaryFunctions {
     return exp(log(z).divided(by: RealType(n)))
   }
 }
+
+// MARK: - Integer powers and roots
+extension Complex {
+  /// All `n` of the `n`th roots of `z`, in counterclockwise order,
+  /// starting from the principal root `root(z, n)`.
+  ///
+  /// This computes the principal root once, and obtains the others by
+  /// rotating it by the `n`th roots of unity, which is much cheaper than
+  /// `n` separate calls to `root`. Rotations by a multiple of a quarter
+  /// turn are exact.
+  ///
+  /// - Parameters:
+  ///   - z: the value whose roots are computed. If `z` is zero, every root
+  ///     is zero, and if `z` is not finite, every root is infinity.
+  ///   - n: the number of roots; must be positive.
+  @inlinable
+  @_specialize(where RealType == Float)
+  @_specialize(where RealType == Double)
+  public static func roots(of z: Complex, count n: Int) -> [Complex] {
+    precondition(n > 0, "count must be positive.")
+    let w = root(z, n)
+    guard w.isFinite && !w.isZero else {
+      return Array(repeating: w, count: n)
+    }
+    return (0 ..< n).map { k in
+      // Use the rotation with the smallest angle, k or k - n, so that the
+      // error in the angle doesn't grow with k.
+      let j = 2*k <= n ? k : k - n
+      return w * _unitRoot(j, n)
+    }
+  }
+  
+  // exp(2πij/n), for |j| <= n/2, exact for multiples of a quarter turn.
+  @usableFromInline @_transparent
+  internal static func _unitRoot(_ j: Int, _ n: Int) -> Complex {
+    if j == 0 { return .one }
+    if 2*j == n || 2*j == -n { return Complex(-1, 0) }
+    if 4*j == n { return .i }
+    if 4*j == -n { return -.i }
+    // The rounding errors of π and of the quotient grow with the angle, so
+    // reduce it in integers first: with 4j = qn + r and |r| <= n/2, the
+    // angle is q quarter turns, which are exact, plus πr/2n, which is
+    // within an eighth of a turn.
+    var q = 4*j / n
+    var r = 4*j - q*n
+    if 2*r > n { q += 1; r -= n }
+    else if 2*r < -n { q -= 1; r += n }
+    let (sin, cos) = RealType.sincos(.pi * (RealType(r) / RealType(2*n)))
+    switch q & 3 {
+    case 0: return Complex(cos, sin)
+    case 1: return Complex(-sin, cos)
+    case 2: return Complex(-cos, -sin)
+    default: return Complex(sin, -cos)
+    }
+  }
+  
+  // The principal nth root of z, for finite, non-zero z and positive n.
+  //
+  // Every factor of two in n is a square root, which does its own careful
+  // rescaling. The remaining odd root is taken in polar form, as
+  // root(r, m)·exp(iθ/m); root(r, 3) is a cbrt, so this costs one atan2,
+  // one cbrt and one sincos, rather than the log and exp (and their
+  // rescaling) of exp(log(z)/n).
+  @inlinable
+  internal static func _rootPolar(_ z: Complex, _ n: Int) -> Complex {
+    var w = z
+    var m = n
+    while m & 1 == 0 {
+      w = sqrt(w)
+      m >>= 1
+    }
+    if m == 1 { return w }
+    let r = w.length
+    let ρ: RealType
+    if r.isFinite {
+      ρ = .root(r, m)
+    } else {
+      // w is finite, but its length overflows; scale it down first.
+      ρ = .root(w.divided(by: 4).length, m) * .root(4, m)
+    }
+    let (sin, cos) = RealType.sincos(w.phase / RealType(m))
+    return Complex(ρ * cos, ρ * sin)
+  }
+  
+  /// `z**n` computed by repeated squaring, or `nil` if the result should
+  /// come from `exp(n*log(z))` instead: if z is not finite, |n| is larger
+  /// than 64, or the result is not normal (so that overflow and underflow
+  /// are handled exactly as before).
+  ///
+  /// This is transparent so that a constant n folds down to the
+  /// straight-line code for that case.
+  @usableFromInline @_transparent
+  internal static func _powBySquaring(
+    _ z: Complex, _ n: Int, compensated: Bool
+  ) -> Complex? {
+    guard z.isFinite else { return nil }
+    let p: Complex
+    switch n {
+    case 0: return .one
+    case 1: return z
+    case -1: return Complex.one / z
+    case 2 where !compensated: p = z*z
+    case 3 where !compensated: p = z*z*z
+    case 4 where !compensated: let s = z*z; p = s*s
+    default:
+      guard n.magnitude <= 64 else { return nil }
+      if compensated {
+        return _powBySquaringCompensated(z, n)
+      }
+      var m = n.magnitude
+      var b = z
+      while m & 1 == 0 { b *= b; m >>= 1 }
+      var q = b
+      m >>= 1
+      while m != 0 {
+        b *= b
+        if m & 1 != 0 { q *= b }
+        m >>= 1
+      }
+      p = q
+    }
+    guard p.isNormal else { return nil }
+    return n > 0 ? p : Complex.one / p
+  }
+  
+  @inlinable
+  internal static func _powBySquaringCompensated(
+    _ z: Complex, _ n: Int
+  ) -> Complex? {
+    var m = n.magnitude
+    var b = (head: z, tail: Complex.zero)
+    while m & 1 == 0 { b = _multiplyDoubleWord(b, b); m >>= 1 }
+    var p = b
+    m >>= 1
+    while m != 0 {
+      b = _multiplyDoubleWord(b, b)
+      if m & 1 != 0 { p = _multiplyDoubleWord(p, b) }
+      m >>= 1
+    }
+    guard p.head.isNormal else { return nil }
+    if n > 0 { return p.head + p.tail }
+    // 1/(h + t) = (1/h)(1 - t/h + ...); the division dominates the error.
+    let q = Complex.one / p.head
+    let r = q - q * (p.tail * q)
+    return r.isNormal ? r : nil
+  }
+  
+  // The product of two double-word complex values (unevaluated sums
+  // head + tail), which is itself double-word. The four products of the
+  // heads are computed exactly, and their rounding errors are carried in
+  // the tail along with the cross terms.
+  @usableFromInline @_transparent
+  internal static func _multiplyDoubleWord(
+    _ a: (head: Complex, tail: Complex), _ b: (head: Complex, tail: Complex)
+  ) -> (head: Complex, tail: Complex) {
+    let xx = Augmented.twoProdFMA(a.head.x, b.head.x)
+    let yy = Augmented.twoProdFMA(a.head.y, b.head.y)
+    let xy = Augmented.twoProdFMA(a.head.x, b.head.y)
+    let yx = Augmented.twoProdFMA(a.head.y, b.head.x)
+    let re = Augmented.twoSum(xx.head, -yy.head)
+    let im = Augmented.twoSum(xy.head, yx.head)
+    let cross = a.head * b.tail + a.tail * b.head
+    // There may be cancellation in re or im, so the tails are not
+    // necessarily smaller than the heads, and we need twoSum here.
+    let x = Augmented.twoSum(re.head, re.tail + (xx.tail - yy.tail) + cross.x)
+    let y = Augmented.twoSum(im.head, im.tail + (xy.tail + yx.tail) + cross.y)
+    return (Complex(x.head, y.head), Complex(x.tail, y.tail))
+  }
+}
+
+// MARK: - Float log-like functions
+//
+// For Complex<Float>, log and log(onePlus:) are computed in Double and
+// rounded once. The extra precision makes the careful rescaling and
+// augmented arithmetic of the generic implementations unnecessary. As with
+// division, these are overloads for concrete Complex<Float>, chosen at
+// compile time.
+extension Complex where RealType == Float {
+  @_transparent
+  public static func log(_ z: Complex) -> Complex {
+    guard z.isFinite && !z.isZero else { return .infinity }
+    let x = Double(z.x), y = Double(z.y)
+    let u = max(x.magnitude, y.magnitude)
+    let v = min(x.magnitude, y.magnitude)
+    // u*u and v*v are exact in Double, so are well-scaled for any finite
+    // Float. If u >= 1/2, u*u - 1 is exact as well, which leaves a single
+    // rounding ahead of log(onePlus:) where |z| is close to 1; otherwise
+    // |z|² <= 1/2, and there can be no cancellation.
+    let re = u < 0.5 ? Double.log(u*u + v*v) :
+                       Double.log(onePlus: (u*u - 1) + v*v)
+    return Complex(Float(re/2), Float(Double.atan2(y: y, x: x)))
+  }
+
+  @_transparent
+  public static func log(onePlus z: Complex) -> Complex {
+    guard z.isFinite else { return .infinity }
+    let x = Double(z.x), y = Double(z.y)
+    // Re(log(1+z)) = log(onePlus: 2x + x² + y²)/2, as in the generic
+    // implementation. x² and y² are exact in Double, and whenever 2x and y²
+    // are close enough in magnitude to cancel, their sum is exact too, so
+    // there is a single significant rounding in s.
+    let s = (2*x + y*y) + x*x
+    return Complex(Float(Double.log(onePlus: s)/2),
+                   Float(Double.atan2(y: y, x: 1 + x)))
+  }
+}
@@ -0,0 +1,81 @@
+//===--- Parallel.swift ---------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+
+// Parallel complex reductions, using the drivers in RealModule/Parallel.swift
+// and the terms of the serial reductions in Summation.swift. They are
+// deterministic in the same way as the real reductions. The batched complex
+// operations can be run in parallel with `Parallel.apply`, for example:
+//
+//   Parallel.apply({ Complex.divide($0, by: w, into: $1) }, to: z, into: q)
+
+#if canImport(Dispatch)
+extension Parallel {
+  /// The sum of the elements of `z`, computed in parallel.
+  @inlinable
+  public static func sum<T>(
+    _ z: UnsafeBufferPointer<Complex<T>>,
+    method: SummationMethod = .pairwise,
+    chunkSize: Int? = nil
+  ) -> Complex<T> {
+    let chunkSize = chunkSize ?? defaultChunkSize(for: Complex<T>.self)
+    let s = _parallelSum(_ComplexSumTerms(z), method: method,
+                         chunkSize: chunkSize)
+    return Complex(s.0, s.1)
+  }
+
+  /// The sum of the elementwise products of `x` and `y`, `Σ x[i]*y[i]`,
+  /// computed in parallel.
+  @inlinable
+  public static func dot<T>(
+    _ x: UnsafeBufferPointer<Complex<T>>,
+    _ y: UnsafeBufferPointer<Complex<T>>,
+    method: SummationMethod = .pairwise,
+    chunkSize: Int? = nil
+  ) -> Complex<T> {
+    precondition(x.count == y.count, "x and y must have the same count.")
+    let chunkSize = chunkSize ?? defaultChunkSize(for: Complex<T>.self)
+    let s = _parallelSum(_ComplexDotTerms(x, y, conjugate: false),
+                         method: method, chunkSize: chunkSize)
+    return Complex(s.0, s.1)
+  }
+
+  /// The inner product of `x` and `y`, `Σ x[i].conjugate * y[i]`, computed
+  /// in parallel.
+  @inlinable
+  public static func conjugateDot<T>(
+    _ x: UnsafeBufferPointer<Complex<T>>,
+    _ y: UnsafeBufferPointer<Complex<T>>,
+    method: SummationMethod = .pairwise,
+    chunkSize: Int? = nil
+  ) -> Complex<T> {
+    precondition(x.count == y.count, "x and y must have the same count.")
+    let chunkSize = chunkSize ?? defaultChunkSize(for: Complex<T>.self)
+    let s = _parallelSum(_ComplexDotTerms(x, y, conjugate: true),
+                         method: method, chunkSize: chunkSize)
+    return Complex(s.0, s.1)
+  }
+
+  /// The sum of the squared lengths of the elements of `z`, computed in
+  /// parallel.
+  @inlinable
+  public static func sum<T>(
+    ofSquaredLengths z: UnsafeBufferPointer<Complex<T>>,
+    method: SummationMethod = .pairwise,
+    chunkSize: Int? = nil
+  ) -> T {
+    let chunkSize = chunkSize ?? defaultChunkSize(for: Complex<T>.self)
+    return _parallelSum(_ComplexSquaredLengthTerms(z), method: method,
+                        chunkSize: chunkSize).0
+  }
+}
+#endif
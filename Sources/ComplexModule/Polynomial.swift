@@ -0,0 +1,36 @@
+//===--- Polynomial.swift -------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+
+// Polynomials with complex coefficients are evaluated at complex points with
+// the generic `Polynomial.evaluate(at:)`; this adds the cheaper evaluation
+// at a real point.
+
+extension Polynomial {
+  /// The value of the polynomial at the real point `x`.
+  ///
+  /// The real and imaginary parts are evaluated separately by Horner's rule
+  /// with real multiply-adds, which is half the work of evaluating at
+  /// `Complex(x)`.
+  @inlinable
+  public func evaluate<RealType>(at x: RealType) -> Coefficient
+  where Coefficient == Complex<RealType> {
+    guard let last = coefficients.last else { return .zero }
+    var re = last.x
+    var im = last.y
+    for c in coefficients.dropLast().reversed() {
+      re = RealType._mulAdd(re, x, c.x)
+      im = RealType._mulAdd(im, x, c.y)
+    }
+    return Complex(re, im)
+  }
+}
@@ -0,0 +1,120 @@
+//===--- Relaxed.swift ----------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+
+// Relaxed-accuracy complex arithmetic and elementary functions; see the
+// documentation of `Relaxed` in RealModule for the general contract. These
+// are the naive formulas that the default implementations use on their fast
+// paths, without the checks that guard those paths. All error bounds are
+// normwise, for results whose intermediate values neither overflow nor
+// underflow.
+
+extension Relaxed {
+  /// The product `z*w`, with error at most about 2 ulps.
+  @_transparent
+  public static func multiply<T>(
+    _ z: Complex<T>, _ w: Complex<T>
+  ) -> Complex<T> {
+    Complex(T._mulAdd(z.x, w.x, -z.y*w.y), T._mulAdd(z.x, w.y, z.y*w.x))
+  }
+
+  /// The quotient `z/w`, with error at most about 4 ulps.
+  ///
+  /// Unlike `/`, this never rescales, so the result is not useful if
+  /// `w.lengthSquared` overflows or is not normal.
+  @_transparent
+  public static func divide<T>(
+    _ z: Complex<T>, _ w: Complex<T>
+  ) -> Complex<T> {
+    let r = 1 / lengthSquared(w)
+    return multiply(z, Complex(w.x*r, -w.y*r))
+  }
+
+  /// `z.lengthSquared`, computed with a fused multiply-add when that is
+  /// faster.
+  @_transparent
+  public static func lengthSquared<T>(_ z: Complex<T>) -> T {
+    T._mulAdd(z.x, z.x, z.y*z.y)
+  }
+
+  /// `z.length`, with error at most 1.5 ulps, skipping the careful
+  /// computation used when `lengthSquared` overflows or underflows.
+  @_transparent
+  public static func length<T>(_ z: Complex<T>) -> T {
+    hypot(z.x, z.y)
+  }
+
+  /// `Complex.exp(z)`, with error at most about 3 ulps.
+  ///
+  /// The result overflows whenever exp(z.real) does, even if one of its
+  /// components would be representable.
+  @_transparent
+  public static func exp<T>(_ z: Complex<T>) -> Complex<T> {
+    let (sin, cos) = T.sincos(z.y)
+    let r = T.exp(z.x)
+    return Complex(r*cos, r*sin)
+  }
+
+  /// `Complex.log(z)`, with error at most about 4 ulps.
+  ///
+  /// When |z| is not small, the real part is log(onePlus: (u-1)(u+1) + v²)/2,
+  /// where u and v are the larger and smaller of |z.real| and |z.imaginary|.
+  /// For u in [1/2, 2], u-1 is exact, so there is no loss of accuracy near
+  /// z = 1. Cancellation in the sum, which only happens elsewhere on the
+  /// unit circle, may destroy the relative accuracy of the real part, but
+  /// not of the result, whose imaginary part is then much larger. This
+  /// replaces the compensated arithmetic of `Complex.log`.
+  @_transparent
+  public static func log<T>(_ z: Complex<T>) -> Complex<T> {
+    let u = max(z.x.magnitude, z.y.magnitude)
+    let v = min(z.x.magnitude, z.y.magnitude)
+    let re = 2*u < 1 ? T.log(T._mulAdd(u, u, v*v)) :
+                       T.log(onePlus: T._mulAdd(u - 1, u + 1, v*v))
+    return Complex(re/2, T.atan2(y: z.y, x: z.x))
+  }
+
+  /// `Complex.log(onePlus: z)`, with error at most about 4 ulps.
+  ///
+  /// For small z, the real part is log(onePlus: (2+x)x + y²)/2, evaluated
+  /// without compensation; as for `log`, cancellation may destroy the
+  /// relative accuracy of the real part, but not of the result. Otherwise,
+  /// this is log(1 + z).
+  @_transparent
+  public static func log<T>(onePlus z: Complex<T>) -> Complex<T> {
+    guard 2*z.x.magnitude < 1 && z.y.magnitude < 1 else {
+      return log(Complex(1 + z.x, z.y))
+    }
+    let s = T._mulAdd(2 + z.x, z.x, z.y*z.y)
+    return Complex(T.log(onePlus: s)/2, T.atan2(y: z.y, x: 1 + z.x))
+  }
+
+  /// `Complex.sqrt(z)`, with error at most about 3 ulps.
+  @_transparent
+  public static func sqrt<T>(_ z: Complex<T>) -> Complex<T> {
+    // The same expressions as the fast path of Complex.sqrt; the only
+    // edge case handled is zero.
+    let u = T.sqrt((length(z) + z.x.magnitude)/2)
+    let v = u == 0 ? z.y : z.y / (2*u)
+    if z.x.sign == .plus { return Complex(u, v) }
+    return Complex(v.magnitude, T(signOf: z.y, magnitudeOf: u))
+  }
+
+  /// `Complex.pow(z, w)`, computed as `exp(w*log(z))` using the relaxed
+  /// functions.
+  ///
+  /// As for `Complex.pow`, the error grows with the magnitude of the
+  /// result's logarithm.
+  @_transparent
+  public static func pow<T>(_ z: Complex<T>, _ w: Complex<T>) -> Complex<T> {
+    exp(multiply(w, log(z)))
+  }
+}
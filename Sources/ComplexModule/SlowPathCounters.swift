@@ -0,0 +1,132 @@
+//===--- SlowPathCounters.swift -------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import _NumericsShims
+
+/// Counts of how often complex arithmetic and elementary functions take
+/// their slow paths.
+///
+/// Division, `length`, `sqrt`, `exp`, `log` and `log(onePlus:)` each have a
+/// fast path for well-scaled values, and fall back on rescaling or extra
+/// precision when intermediate results would overflow, underflow, or
+/// cancel. The results are the same either way, so the only sign that data
+/// is hitting the slow paths is that it is slower. These counters show how
+/// often that happens, for example to decide whether rescaling the inputs
+/// upstream would pay off.
+///
+/// Counting is compiled in only when ComplexModule is built with the
+/// `SWIFT_NUMERICS_INSTRUMENTATION` compilation condition (with swiftpm,
+/// `swift build -Xswiftc -DSWIFT_NUMERICS_INSTRUMENTATION`; with CMake,
+/// `-DSWIFT_NUMERICS_INSTRUMENTATION=ON`). Otherwise the slow paths contain
+/// no instrumentation at all, `isEnabled` is `false`, and every count is
+/// always zero.
+///
+/// When enabled, each slow path increments a counter with a relaxed atomic
+/// add. The counters are striped by thread over separate cache lines, so
+/// threads that hit slow paths at the same time rarely contend.
+public enum SlowPathCounters {
+  /// The instrumented slow paths.
+  public enum Path: Int, CaseIterable, Hashable {
+    /// Division by a value whose squared length is not normal.
+    case rescaledDivide
+    /// `length` of a value whose squared length is not normal.
+    case carefulLength
+    /// `sqrt` of a finite, non-zero value whose squared length is not
+    /// normal.
+    case rescaledSqrt
+    /// `exp` or `expMinusOne` of a value whose real part is close to
+    /// overflowing.
+    case scaledExp
+    /// `log` of a value close to the unit circle, which needs augmented
+    /// arithmetic.
+    case compensatedLog
+    /// `log(onePlus:)` of a small value, which needs augmented arithmetic.
+    case compensatedLogOnePlus
+  }
+
+  /// Whether the slow paths are instrumented in this build.
+  public static var isEnabled: Bool {
+    #if SWIFT_NUMERICS_INSTRUMENTATION
+    return true
+    #else
+    return false
+    #endif
+  }
+
+  /// The number of times each path has been taken since the process started
+  /// or `reset()` was last called, summed over all threads.
+  ///
+  /// Each count is read atomically, but the counts are not read at once, so
+  /// concurrent slow paths may be partially included.
+  public static func snapshot() -> [Path: Int] {
+    var result: [Path: Int] = [:]
+    for path in Path.allCases {
+      var count: UInt64 = 0
+      #if SWIFT_NUMERICS_INSTRUMENTATION
+      for stripe in 0 ..< _stripeCount {
+        count &+= _numerics_relaxed_load(_slowPathCounter(path, stripe))
+      }
+      #endif
+      result[path] = Int(truncatingIfNeeded: count)
+    }
+    return result
+  }
+
+  /// Sets every count to zero.
+  ///
+  /// Slow paths taken by other threads while this runs may or may not be
+  /// counted afterwards.
+  public static func reset() {
+    #if SWIFT_NUMERICS_INSTRUMENTATION
+    for path in Path.allCases {
+      for stripe in 0 ..< _stripeCount {
+        _numerics_relaxed_store(_slowPathCounter(path, stripe), 0)
+      }
+    }
+    #endif
+  }
+
+  #if SWIFT_NUMERICS_INSTRUMENTATION
+  /// Counts one use of `path` by the calling thread.
+  ///
+  /// This is not inlinable, so that the slow paths, which are inlined into
+  /// client code, only contain a call.
+  @usableFromInline
+  internal static func _record(_ path: Path) {
+    let stripe = Int(_numerics_thread_stripe())
+    _numerics_relaxed_increment(_slowPathCounter(path, stripe))
+  }
+  #endif
+}
+
+#if SWIFT_NUMERICS_INSTRUMENTATION
+// _numerics_thread_stripe returns a value in 0 ..< 16.
+internal let _stripeCount = 16
+
+// Each stripe is a cache line of eight counters, which is room for every
+// path.
+internal let _countersPerStripe = 8
+
+internal let _slowPathCounters: UnsafeMutablePointer<UInt64> = {
+  let n = _stripeCount * _countersPerStripe
+  let p = UnsafeMutableRawPointer.allocate(
+    byteCount: n * MemoryLayout<UInt64>.stride, alignment: 64
+  ).bindMemory(to: UInt64.self, capacity: n)
+  p.initialize(repeating: 0, count: n)
+  return p
+}()
+
+internal func _slowPathCounter(
+  _ path: SlowPathCounters.Path, _ stripe: Int
+) -> UnsafeMutablePointer<UInt64> {
+  _slowPathCounters + stripe * _countersPerStripe + path.rawValue
+}
+#endif
@@ -0,0 +1,170 @@
+//===--- Summation.swift --------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+
+// Complex reductions, using the summation methods and machinery defined in
+// RealModule/Summation.swift. The real and imaginary parts are accumulated
+// in a single pass over the data.
+
+extension Complex {
+  /// The sum of the elements of `z`.
+  @inlinable
+  public static func sum(
+    _ z: UnsafeBufferPointer<Complex>,
+    method: SummationMethod = .pairwise
+  ) -> Complex {
+    let s = _sum(_ComplexSumTerms(z), method: method)
+    return Complex(s.0, s.1)
+  }
+
+  /// The sum of the elements of `z`.
+  @inlinable
+  public static func sum<S>(
+    _ z: S,
+    method: SummationMethod = .pairwise
+  ) -> Complex where S: Sequence, S.Element == Complex {
+    _withBuffer(z) { sum($0, method: method) }
+  }
+
+  /// The sum of the elementwise products of `x` and `y`, `Σ x[i]*y[i]`,
+  /// accumulated with `method`.
+  @inlinable
+  public static func dot(
+    _ x: UnsafeBufferPointer<Complex>,
+    _ y: UnsafeBufferPointer<Complex>,
+    method: SummationMethod
+  ) -> Complex {
+    precondition(x.count == y.count, "x and y must have the same count.")
+    let s = _sum(_ComplexDotTerms(x, y, conjugate: false), method: method)
+    return Complex(s.0, s.1)
+  }
+
+  /// The inner product of `x` and `y`, `Σ x[i].conjugate * y[i]`,
+  /// accumulated with `method`.
+  @inlinable
+  public static func conjugateDot(
+    _ x: UnsafeBufferPointer<Complex>,
+    _ y: UnsafeBufferPointer<Complex>,
+    method: SummationMethod
+  ) -> Complex {
+    precondition(x.count == y.count, "x and y must have the same count.")
+    let s = _sum(_ComplexDotTerms(x, y, conjugate: true), method: method)
+    return Complex(s.0, s.1)
+  }
+
+  /// The sum of the squares of the elements of `z`, `Σ z[i]*z[i]`.
+  @inlinable
+  public static func sum(
+    ofSquares z: UnsafeBufferPointer<Complex>,
+    method: SummationMethod = .pairwise
+  ) -> Complex {
+    dot(z, z, method: method)
+  }
+
+  /// The sum of the squared lengths of the elements of `z`,
+  /// `Σ z[i].lengthSquared` (the squared 2-norm of `z`).
+  @inlinable
+  public static func sum(
+    ofSquaredLengths z: UnsafeBufferPointer<Complex>,
+    method: SummationMethod = .pairwise
+  ) -> RealType {
+    _sum(_ComplexSquaredLengthTerms(z), method: method).0
+  }
+
+  /// The sum of the squared lengths of the elements of `z`,
+  /// `Σ z[i].lengthSquared` (the squared 2-norm of `z`).
+  @inlinable
+  public static func sum<S>(
+    ofSquaredLengths z: S,
+    method: SummationMethod = .pairwise
+  ) -> RealType where S: Sequence, S.Element == Complex {
+    _withBuffer(z) { sum(ofSquaredLengths: $0, method: method) }
+  }
+}
+
+@usableFromInline
+internal struct _ComplexSumTerms<RealType>: _SummationTerms
+where RealType: Real {
+  @usableFromInline
+  internal let z: UnsafeBufferPointer<Complex<RealType>>
+
+  @_transparent @usableFromInline
+  internal init(_ z: UnsafeBufferPointer<Complex<RealType>>) { self.z = z }
+
+  @_transparent @usableFromInline
+  internal var count: Int { z.count }
+
+  @_transparent @usableFromInline
+  internal func add<A>(_ i: Int, to a: inout A, _ b: inout A)
+  where A: _SumAccumulator, A.Value == RealType {
+    a.add(z[i].x)
+    b.add(z[i].y)
+  }
+}
+
+@usableFromInline
+internal struct _ComplexDotTerms<RealType>: _SummationTerms
+where RealType: Real {
+  @usableFromInline
+  internal let x: UnsafeBufferPointer<Complex<RealType>>
+
+  @usableFromInline
+  internal let y: UnsafeBufferPointer<Complex<RealType>>
+
+  @usableFromInline
+  internal let conjugate: Bool
+
+  @_transparent @usableFromInline
+  internal init(
+    _ x: UnsafeBufferPointer<Complex<RealType>>,
+    _ y: UnsafeBufferPointer<Complex<RealType>>,
+    conjugate: Bool
+  ) {
+    self.x = x
+    self.y = y
+    self.conjugate = conjugate
+  }
+
+  @_transparent @usableFromInline
+  internal var count: Int { x.count }
+
+  @_transparent @usableFromInline
+  internal func add<A>(_ i: Int, to a: inout A, _ b: inout A)
+  where A: _SumAccumulator, A.Value == RealType {
+    let u = conjugate ? x[i].conjugate : x[i]
+    let v = y[i]
+    a.addProduct(u.x, v.x)
+    a.addProduct(-u.y, v.y)
+    b.addProduct(u.x, v.y)
+    b.addProduct(u.y, v.x)
+  }
+}
+
+@usableFromInline
+internal struct _ComplexSquaredLengthTerms<RealType>: _SummationTerms
+where RealType: Real {
+  @usableFromInline
+  internal let z: UnsafeBufferPointer<Complex<RealType>>
+
+  @_transparent @usableFromInline
+  internal init(_ z: UnsafeBufferPointer<Complex<RealType>>) { self.z = z }
+
+  @_transparent @usableFromInline
+  internal var count: Int { z.count }
+
+  @_transparent @usableFromInline
+  internal func add<A>(_ i: Int, to a: inout A, _ b: inout A)
+  where A: _SumAccumulator, A.Value == RealType {
+    a.addProduct(z[i].x, z[i].x)
+    a.addProduct(z[i].y, z[i].y)
+  }
+}
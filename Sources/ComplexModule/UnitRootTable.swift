@@ -0,0 +1,207 @@
+//===--- UnitRootTable.swift ----------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+import _NumericsShims
+
+/// The nth roots of unity, `exp(2πik/n)` for `k` in `0 ..< n`, such as the
+/// twiddle factors of an FFT of length n.
+///
+/// Building a table costs only O(√n) evaluations of sin and cos: the roots
+/// in the first octant are computed as products of a coarse and a fine
+/// root, and the others follow from the symmetries of the circle, which
+/// are exact. Every root has an error of at most about 2 ulps, which does
+/// not grow with n or k (unlike the rotation recurrence w[k+1] = w[k]·w[1]),
+/// and the roots at multiples of an eighth of a turn are exact (or correctly
+/// rounded, for √½).
+///
+/// Tables share their storage when copied, and `shared(count:)` returns a
+/// table from a process-wide cache, so that every user of a given length
+/// and type shares a single copy.
+public struct UnitRootTable<RealType>: RandomAccessCollection
+where RealType: Real {
+
+  @usableFromInline
+  internal let _storage: _UnitRootStorage<RealType>
+
+  /// A new table of the `n`th roots of unity.
+  public init(count n: Int) {
+    precondition(n > 0, "count must be positive.")
+    _storage = _UnitRootStorage(Complex._unitRoots(n))
+  }
+
+  @usableFromInline
+  internal init(_storage: _UnitRootStorage<RealType>) {
+    self._storage = _storage
+  }
+
+  /// The table of the `n`th roots of unity, from a process-wide cache.
+  ///
+  /// The first request for a given length and type builds the table; later
+  /// requests return the same storage. Lookups never block, even while
+  /// another thread is adding a table: the cache is a list to which tables
+  /// are only ever prepended, published with an atomic compare-and-swap.
+  /// If two threads build the same table at once, only one of them is kept.
+  /// Cached tables are never freed.
+  public static func shared(count n: Int) -> UnitRootTable {
+    precondition(n > 0, "count must be positive.")
+    let type = ObjectIdentifier(RealType.self)
+    var head: UnsafeMutableRawPointer? = _numerics_atomic_load_pointer(_unitRootCache)
+    if let storage = _UnitRootCacheNode.find(type, n, from: head) {
+      return UnitRootTable(_storage: unsafeDowncast(storage, to: _UnitRootStorage<RealType>.self))
+    }
+    let table = UnitRootTable(count: n)
+    while true {
+      let node = Unmanaged.passRetained(
+        _UnitRootCacheNode(type, n, table._storage, next: head)
+      ).toOpaque()
+      if _numerics_atomic_compare_exchange_pointer(_unitRootCache, &head, node) != 0 {
+        return table
+      }
+      // Another thread got there first, and head is now its node; it may
+      // have added this very table.
+      Unmanaged<_UnitRootCacheNode>.fromOpaque(node).release()
+      if let storage = _UnitRootCacheNode.find(type, n, from: head) {
+        return UnitRootTable(_storage: unsafeDowncast(storage, to: _UnitRootStorage<RealType>.self))
+      }
+    }
+  }
+
+  @inlinable
+  public var startIndex: Int { 0 }
+
+  @inlinable
+  public var endIndex: Int { _storage.roots.count }
+
+  /// `exp(2πik/n)`.
+  @inlinable
+  public subscript(k: Int) -> Complex<RealType> {
+    _storage.roots[k]
+  }
+
+  /// `exp(2πik/n)` for any integer `k`.
+  @inlinable
+  public func root(_ k: Int) -> Complex<RealType> {
+    let r = k % count
+    return self[r < 0 ? r + count : r]
+  }
+
+  /// Calls `body` with a pointer to the roots.
+  @inlinable
+  public func withUnsafeBufferPointer<Result>(
+    _ body: (UnsafeBufferPointer<Complex<RealType>>) throws -> Result
+  ) rethrows -> Result {
+    try _storage.roots.withUnsafeBufferPointer(body)
+  }
+}
+
+@usableFromInline
+internal final class _UnitRootStorage<RealType> where RealType: Real {
+  @usableFromInline
+  internal let roots: [Complex<RealType>]
+
+  internal init(_ roots: [Complex<RealType>]) {
+    self.roots = roots
+  }
+}
+
+// MARK: - Cache
+// An immutable singly-linked list of the shared tables, whose head is
+// published through _unitRootCache. Nodes are never removed, so a reader
+// can walk the list from any head it has loaded without synchronization.
+internal final class _UnitRootCacheNode {
+  let type: ObjectIdentifier
+  let count: Int
+  let storage: AnyObject
+  let next: _UnitRootCacheNode?
+
+  init(_ type: ObjectIdentifier, _ count: Int, _ storage: AnyObject,
+       next: UnsafeMutableRawPointer?) {
+    self.type = type
+    self.count = count
+    self.storage = storage
+    self.next = next.map {
+      Unmanaged<_UnitRootCacheNode>.fromOpaque($0).takeUnretainedValue()
+    }
+  }
+
+  static func find(
+    _ type: ObjectIdentifier, _ count: Int, from head: UnsafeMutableRawPointer?
+  ) -> AnyObject? {
+    var node = head.map {
+      Unmanaged<_UnitRootCacheNode>.fromOpaque($0).takeUnretainedValue()
+    }
+    while let n = node {
+      if n.type == type && n.count == count { return n.storage }
+      node = n.next
+    }
+    return nil
+  }
+}
+
+// The head of the cache, as a retained _UnitRootCacheNode, or nil if the
+// cache is empty.
+internal let _unitRootCache: UnsafeMutablePointer<UnsafeMutableRawPointer?> = {
+  let p = UnsafeMutablePointer<UnsafeMutableRawPointer?>.allocate(capacity: 1)
+  p.initialize(to: nil)
+  return p
+}()
+
+// MARK: - Building tables
+extension Complex {
+  // exp(2πik/n) for k in 0 ..< n.
+  internal static func _unitRoots(_ n: Int) -> [Complex] {
+    var t = [Complex](repeating: .zero, count: n)
+    // The roots for k in 0 ... m are computed directly, where m is the
+    // largest k that none of the exact symmetries available for n reach:
+    // an eighth of a turn if 8 divides n, and otherwise a quarter turn or a
+    // half turn.
+    let m = n % 8 == 0 ? n/8 : n % 4 == 0 ? n/4 : n/2
+    // Write k = a*s + b with 0 <= b < s ≈ √m, so that exp(2πik/n) is the
+    // product of a coarse root for a*s and a fine root for b, with only
+    // about 2√m calls to sincos.
+    var s = 1
+    while s*s < m + 1 { s += 1 }
+    let fine = (0 ..< s).map { _unitRoot($0, n) }
+    var a = 0
+    while a*s <= m {
+      let c = _unitRoot(a*s, n)
+      t[a*s] = c
+      for b in 1 ..< Swift.min(s, m - a*s + 1) {
+        let f = fine[b]
+        t[a*s + b] = Complex(RealType._mulAdd(c.x, f.x, -c.y*f.y),
+                             RealType._mulAdd(c.x, f.y, c.y*f.x))
+      }
+      a += 1
+    }
+    if 8*m == n {
+      let h = RealType.sqrt(2)/2
+      t[m] = Complex(h, h)
+    } else if 4*m == n {
+      t[m] = .i
+    } else if 2*m == n {
+      t[m] = Complex(-1, 0)
+    }
+    // exp(i(π/2 - θ)) = sin θ + i cos θ
+    if 8*m == n {
+      let q = n/4
+      for k in m+1 ... q { t[k] = Complex(t[q-k].y, t[q-k].x) }
+    }
+    // exp(i(π/2 + θ)) = -sin θ + i cos θ
+    if n % 4 == 0 {
+      let q = n/4
+      for k in q+1 ... 2*q { t[k] = Complex(-t[k-q].y, t[k-q].x) }
+    }
+    // exp(i(2π - θ)) = cos θ - i sin θ
+    for k in n/2 + 1 ..< n { t[k] = Complex(t[n-k].x, -t[n-k].y) }
+    return t
+  }
+}
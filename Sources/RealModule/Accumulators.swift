@@ -0,0 +1,354 @@
+//===--- Accumulators.swift -----------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+// Streaming accumulators for sums, log-sum-exp, and mean and variance.
+//
+// Each accumulator has O(1) state, and is updated in O(1) per value, so it
+// can summarize an unbounded stream in a single pass. Two accumulators of
+// the same kind can be merged in O(1), which combines the summaries of two
+// shards of the data. Buffers can be added in bulk with `add(contentsOf:)`,
+// which works through the buffer one small, cache-resident block at a time,
+// so that the inner loops vectorize.
+
+// MARK: - Compensated sum
+/// A running sum, with the rounding error of every addition accumulated
+/// separately and added back when the value is read.
+///
+/// This is Neumaier's improvement of Kahan's compensated summation (the
+/// `.kahanBabuska` summation method), built on `Augmented.fastTwoSum`. To
+/// first order, the error bound does not depend on the number of values
+/// added.
+@frozen
+public struct CompensatedSumAccumulator<Value> where Value: Real {
+  @usableFromInline
+  internal var _sum: _KahanBabuskaSum<Value>
+
+  /// An empty sum.
+  @inlinable
+  public init() {
+    _sum = _KahanBabuskaSum()
+  }
+
+  /// The sum of the values added so far.
+  @inlinable
+  public var value: Value { _sum.value }
+
+  /// Adds `x` to the sum.
+  @inlinable
+  public mutating func add(_ x: Value) {
+    _sum.add(x)
+  }
+
+  /// Adds every element of `x` to the sum.
+  ///
+  /// The elements are accumulated into several independent compensated
+  /// sums, which are then merged, so the result may differ very slightly
+  /// from adding the elements one at a time.
+  @inlinable
+  public mutating func add(contentsOf x: UnsafeBufferPointer<Value>) {
+    let (a, _) = _accumulateLanes(_SumTerms(x), 0 ..< x.count,
+                                  _KahanBabuskaSum<Value>.self)
+    _sum.merge(a)
+  }
+
+  /// Adds every element of `x` to the sum.
+  @inlinable
+  public mutating func add<S>(contentsOf x: S)
+  where S: Sequence, S.Element == Value {
+    _withBuffer(x) { add(contentsOf: $0) }
+  }
+
+  /// Adds the sum accumulated by `other` to this sum.
+  @inlinable
+  public mutating func merge(_ other: Self) {
+    _sum.merge(other._sum)
+  }
+}
+
+// MARK: - Log-sum-exp
+/// A running `log(Σ exp(x[i]))`, which neither overflows nor underflows
+/// unless the result does.
+///
+/// The accumulator keeps the largest value seen so far, `m`, and the sum
+/// of `exp(x[i] - m)`, which is at least 1 and at most the number of
+/// values. When a new maximum arrives, the sum is rescaled by a single
+/// `exp`, so there is never a separate pass to find the maximum first.
+///
+/// Edge cases:
+/// - The result for no values, or only values of `-infinity`, is
+///   `-infinity`.
+/// - If any value is `infinity`, the result is `infinity`.
+/// - If any value is nan, the result is nan.
+@frozen
+public struct LogSumExpAccumulator<Value> where Value: Real {
+  @usableFromInline
+  internal var _max: Value
+
+  @usableFromInline
+  internal var _sum: _KahanBabuskaSum<Value>
+
+  /// An empty accumulator, whose value is `-infinity`.
+  @inlinable
+  public init() {
+    _max = -.infinity
+    _sum = _KahanBabuskaSum()
+  }
+
+  /// `log(Σ exp(x[i]))` of the values added so far.
+  @inlinable
+  public var value: Value {
+    _max + .log(_sum.value)
+  }
+
+  /// Adds `x`, which adds `exp(x)` to the sum.
+  @inlinable
+  public mutating func add(_ x: Value) {
+    if x > _max {
+      _rescale(to: x)
+      _sum.add(1)
+    } else if x <= _max {
+      // x - _max is nan only when both are the same infinity: -infinity
+      // contributes nothing, and once _max is infinity, so is the result.
+      let d = x - _max
+      if !d.isNaN { _sum.add(.exp(d)) }
+    } else {
+      // x or _max is nan; nan compares false with everything, so it is
+      // sticky from here on.
+      _max = .nan
+    }
+  }
+
+  /// Adds every element of `x`.
+  ///
+  /// Each block of elements is scanned for its maximum, and then the
+  /// exponentials of the whole block are evaluated together, with the
+  /// batched `exp` kernels when `Value` is Float or Double.
+  @inlinable
+  public mutating func add(contentsOf x: UnsafeBufferPointer<Value>) {
+    let blockSize = 256
+    let t = UnsafeMutableBufferPointer<Value>.allocate(
+      capacity: min(blockSize, x.count)
+    )
+    defer { t.deallocate() }
+    var start = 0
+    while start < x.count {
+      let n = min(blockSize, x.count - start)
+      var m = x[start]
+      var finite = true
+      for i in start ..< start + n {
+        m = x[i] > m ? x[i] : m
+        finite = finite && x[i].isFinite
+      }
+      if !finite || (!_max.isFinite && _max != -.infinity) {
+        // Infinities and nans take the scalar path, which handles them.
+        for i in start ..< start + n { add(x[i]) }
+      } else {
+        if m > _max { _rescale(to: m) }
+        for j in 0 ..< n { t[j] = x[start + j] - _max }
+        Value._applyBatched(UnsafeMutableBufferPointer(rebasing: t[0 ..< n]),
+          float: { Float.exp($0) }, double: { Double.exp($0) },
+          scalar: { .exp($0) })
+        let (a, _) = _accumulateLanes(_SumTerms(UnsafeBufferPointer(t)),
+                                      0 ..< n, _KahanBabuskaSum<Value>.self)
+        _sum.merge(a)
+      }
+      start += n
+    }
+  }
+
+  /// Adds every element of `x`.
+  @inlinable
+  public mutating func add<S>(contentsOf x: S)
+  where S: Sequence, S.Element == Value {
+    _withBuffer(x) { add(contentsOf: $0) }
+  }
+
+  /// Adds the values accumulated by `other`.
+  @inlinable
+  public mutating func merge(_ other: Self) {
+    if other._max > _max {
+      var result = other
+      result._merge(smaller: self)
+      self = result
+    } else if other._max <= _max {
+      _merge(smaller: other)
+    } else {
+      _max = .nan
+    }
+  }
+
+  // Merges other, whose maximum is at most _max.
+  @inlinable
+  internal mutating func _merge(smaller other: Self) {
+    // As in add, a nan difference means that the smaller sum can be
+    // ignored.
+    let d = other._max - _max
+    guard !d.isNaN else { return }
+    let scale = Value.exp(d)
+    var sum = other._sum
+    sum.s *= scale
+    sum.c *= scale
+    _sum.merge(sum)
+  }
+
+  // Makes m the maximum, rescaling the sum to match. m must not be less
+  // than _max.
+  @inlinable
+  internal mutating func _rescale(to m: Value) {
+    // If _max is -infinity, the sum is zero, and so is the scale.
+    let scale = Value.exp(_max - m)
+    _sum.s *= scale
+    _sum.c *= scale
+    _max = m
+  }
+}
+
+// MARK: - Mean and variance
+/// The running count, mean and variance of a stream of values, by
+/// Welford's algorithm.
+///
+/// The mean and the sum of squared deviations from it are updated for
+/// each value, which avoids the cancellation of the textbook formula
+/// `Σx²/n - (Σx/n)²`, and does not need a second pass over the data. The
+/// running mean is kept as a head-tail pair, so that the rounding of each
+/// small update is not lost; otherwise the error in the mean would grow
+/// with the number of values.
+/// Accumulators are merged with the pairwise update of Chan, Golub and
+/// LeVeque, so the result for sharded data is as accurate as for a single
+/// stream.
+@frozen
+public struct MeanVarianceAccumulator<Value> where Value: Real {
+  @usableFromInline
+  internal var _count: Int
+
+  @usableFromInline
+  internal var _mean: Value
+
+  // The rounding error of _mean; the mean is _mean + _meanTail.
+  @usableFromInline
+  internal var _meanTail: Value
+
+  // The sum of squared deviations from the mean.
+  @usableFromInline
+  internal var _m2: Value
+
+  /// An empty accumulator.
+  @inlinable
+  public init() {
+    _count = 0
+    _mean = 0
+    _meanTail = 0
+    _m2 = 0
+  }
+
+  @inlinable
+  internal init(count: Int, mean: Value, m2: Value) {
+    _count = count
+    _mean = mean
+    _meanTail = 0
+    _m2 = m2
+  }
+
+  /// The number of values added so far.
+  @inlinable
+  public var count: Int { _count }
+
+  /// The mean of the values added so far, or nan if there are none.
+  @inlinable
+  public var mean: Value {
+    count == 0 ? .nan : _mean + _meanTail
+  }
+
+  /// The population variance, `Σ(x[i] - mean)²/count`, or nan if no values
+  /// have been added.
+  @inlinable
+  public var variance: Value {
+    count == 0 ? .nan : _m2 / Value(count)
+  }
+
+  /// The sample variance, `Σ(x[i] - mean)²/(count - 1)`, or nan if fewer
+  /// than two values have been added.
+  @inlinable
+  public var sampleVariance: Value {
+    count < 2 ? .nan : _m2 / Value(count - 1)
+  }
+
+  /// The population standard deviation, the square root of `variance`.
+  @inlinable
+  public var standardDeviation: Value {
+    .sqrt(variance)
+  }
+
+  /// Adds `x`.
+  @inlinable
+  public mutating func add(_ x: Value) {
+    _count += 1
+    let delta = (x - _mean) - _meanTail
+    _addToMean(delta / Value(_count))
+    _m2 = Value._mulAdd(delta, (x - _mean) - _meanTail, _m2)
+  }
+
+  // Adds step to the mean, keeping the rounding error in _meanTail. (An
+  // infinite mean has no rounding error, and its tail would be nan.)
+  @usableFromInline @_transparent
+  internal mutating func _addToMean(_ step: Value) {
+    let (a, b) = _mean.magnitude >= step.magnitude ? (_mean, step) : (step, _mean)
+    let t = Augmented.fastTwoSum(a, b)
+    _mean = t.head
+    _meanTail = t.head.isFinite ? _meanTail + t.tail : 0
+  }
+
+  /// Adds every element of `x`.
+  ///
+  /// Each block of elements is summarized with two vectorizable passes,
+  /// one for its mean and one for the squared deviations from that mean,
+  /// while the block is in cache; the block summaries are then merged.
+  @inlinable
+  public mutating func add(contentsOf x: UnsafeBufferPointer<Value>) {
+    let terms = _SumTerms(x)
+    let blockSize = 256
+    var start = 0
+    while start < x.count {
+      let n = min(blockSize, x.count - start)
+      let range = start ..< start + n
+      let sum = _sumLanes(terms, range, _KahanBabuskaSum<Value>.self).0
+      let mean = sum / Value(n)
+      var m2: Value = 0
+      for i in range {
+        let d = x[i] - mean
+        m2 = Value._mulAdd(d, d, m2)
+      }
+      merge(MeanVarianceAccumulator(count: n, mean: mean, m2: m2))
+      start += n
+    }
+  }
+
+  /// Adds every element of `x`.
+  @inlinable
+  public mutating func add<S>(contentsOf x: S)
+  where S: Sequence, S.Element == Value {
+    _withBuffer(x) { add(contentsOf: $0) }
+  }
+
+  /// Adds the values accumulated by `other`.
+  @inlinable
+  public mutating func merge(_ other: Self) {
+    guard other._count > 0 else { return }
+    guard _count > 0 else { self = other; return }
+    let n = _count + other._count
+    let a = Value(_count), b = Value(other._count)
+    let delta = (other._mean - _mean) + (other._meanTail - _meanTail)
+    let c = b / Value(n)
+    _addToMean(delta * c)
+    _m2 = Value._mulAdd(delta * delta * a, c, _m2 + other._m2)
+    _count = n
+  }
+}
@@ -19,6 +19,21 @@ extension Augmented {
     return (head, tail)
   }
   
+  /// The sum `a + b` as a head-tail pair, where `head` is the rounded sum
+  /// and `tail` is the rounding error, with no requirement on the relative
+  /// magnitude of `a` and `b` (Knuth's TwoSum).
+  ///
+  /// This is more expensive than `fastTwoSum`, which requires that
+  /// `a.magnitude >= b.magnitude`.
+  @_transparent
+  public static func twoSum<T:Real>(_ a: T, _ b: T) -> (head: T, tail: T) {
+    let head = a + b
+    let x = head - b
+    let y = head - x
+    let tail = (a - x) + (b - y)
+    return (head, tail)
+  }
+  
   @_transparent
   public static func fastTwoSum<T:Real>(_ a: T, _ b: T) -> (head: T, tail: T) {
     assert(!(b.magnitude > a.magnitude))
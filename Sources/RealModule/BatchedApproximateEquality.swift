@@ -0,0 +1,159 @@
+//===--- BatchedApproximateEquality.swift ---------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+/// The result of comparing two buffers elementwise with
+/// `isApproximatelyEqual`, along with statistics about how different they
+/// are.
+///
+/// Errors are measured with the same norm as the comparison, as
+/// `norm(a[i] - b[i])` (absolute) and that divided by
+/// `max(norm(a[i]), norm(b[i]))` (relative). Elements that are equal have
+/// zero error, and elements for which either error is nan do not contribute
+/// to the maxima.
+public struct ApproximateEqualityReport<Magnitude> where Magnitude: FloatingPoint {
+  /// The number of elements compared.
+  public var count: Int = 0
+
+  /// The number of elements that are not approximately equal.
+  public var failures: Int = 0
+
+  /// The index of the first element that is not approximately equal.
+  public var firstFailure: Int? = nil
+
+  /// The largest absolute error.
+  public var maxAbsoluteError: Magnitude = 0
+
+  /// The index of the element with the largest absolute error, or nil if
+  /// every element has zero error.
+  public var maxAbsoluteErrorIndex: Int? = nil
+
+  /// The largest relative error.
+  public var maxRelativeError: Magnitude = 0
+
+  /// The index of the element with the largest relative error, or nil if
+  /// every element has zero error.
+  public var maxRelativeErrorIndex: Int? = nil
+
+  /// The number of elements at each distance in ulps, by powers of two.
+  ///
+  /// The distance is the absolute error divided by the ulp of
+  /// `max(norm(a[i]), norm(b[i]), leastNormalMagnitude)`. Bucket 0 counts
+  /// elements at distance zero, bucket 1 those in (0, 1], and bucket k
+  /// those in (2^(k-2), 2^(k-1)], up to the last bucket, which also counts
+  /// every larger or non-finite distance.
+  public var ulpHistogram: [Int] = Array(repeating: 0, count: 34)
+
+  /// The number of buckets in `ulpHistogram`.
+  public static var bucketCount: Int { 34 }
+
+  /// True if every element is approximately equal.
+  public var allApproximatelyEqual: Bool { failures == 0 }
+
+  @inlinable
+  public init() { }
+}
+
+extension ApproximateEqualityReport {
+  /// Compares `a[i]` and `b[i]` for every `i`, using
+  /// `isApproximatelyEqual(to:absoluteTolerance:relativeTolerance:norm:)`
+  /// semantics, in a single pass.
+  ///
+  /// Each element costs a few comparisons and divisions, with no
+  /// allocation; the branches for elements that fail or set a new maximum
+  /// are rarely taken, so they predict well on large, mostly-equal
+  /// buffers.
+  @inlinable
+  public init<Element>(
+    comparing a: UnsafeBufferPointer<Element>,
+    to b: UnsafeBufferPointer<Element>,
+    absoluteTolerance: Magnitude,
+    relativeTolerance: Magnitude = 0,
+    norm: (Element) -> Magnitude
+  ) where Element: AdditiveArithmetic {
+    precondition(a.count == b.count, "a and b must have the same count.")
+    assert(
+      absoluteTolerance >= 0 && absoluteTolerance.isFinite,
+      "absoluteTolerance should be non-negative and finite, " +
+      "but is \(absoluteTolerance)."
+    )
+    assert(
+      relativeTolerance >= 0 && relativeTolerance <= 1,
+      "relativeTolerance should be non-negative and <= 1, " +
+      "but is \(relativeTolerance)."
+    )
+    self.init()
+    count = a.count
+    let last = Self.bucketCount - 1
+    for i in a.indices {
+      if a[i] == b[i] {
+        ulpHistogram[0] += 1
+        continue
+      }
+      let delta = norm(a[i] - b[i])
+      let scale = max(norm(a[i]), norm(b[i]))
+      let bound = max(absoluteTolerance, scale*relativeTolerance)
+      if !(delta.isFinite && delta <= bound) {
+        failures += 1
+        if firstFailure == nil { firstFailure = i }
+      }
+      if delta > maxAbsoluteError {
+        maxAbsoluteError = delta
+        maxAbsoluteErrorIndex = i
+      }
+      let relative = delta / scale
+      if relative > maxRelativeError {
+        maxRelativeError = relative
+        maxRelativeErrorIndex = i
+      }
+      let ulps = delta / max(scale, .leastNormalMagnitude).ulp
+      let bucket: Int
+      if ulps == 0 { bucket = 0 }
+      else if ulps <= 1 { bucket = 1 }
+      else if ulps.isFinite { bucket = min(Int(ulps.nextDown.exponent) + 2, last) }
+      else { bucket = last }
+      ulpHistogram[bucket] += 1
+    }
+  }
+
+  /// Compares `a[i]` and `b[i]` for every `i`, using
+  /// `isApproximatelyEqual(to:relativeTolerance:norm:)` semantics, in a
+  /// single pass.
+  @inlinable
+  public init<Element>(
+    comparing a: UnsafeBufferPointer<Element>,
+    to b: UnsafeBufferPointer<Element>,
+    relativeTolerance: Magnitude = Magnitude.ulpOfOne.squareRoot(),
+    norm: ((Element) -> Magnitude)? = nil
+  ) where Element: Numeric, Element.Magnitude == Magnitude {
+    let absoluteTolerance = relativeTolerance * Magnitude.leastNormalMagnitude
+    if let norm = norm {
+      self.init(comparing: a, to: b, absoluteTolerance: absoluteTolerance,
+                relativeTolerance: relativeTolerance, norm: norm)
+    } else {
+      self.init(comparing: a, to: b, absoluteTolerance: absoluteTolerance,
+                relativeTolerance: relativeTolerance, norm: { $0.magnitude })
+    }
+  }
+
+  /// Compares `a[i]` and `b[i]` for every `i`, using
+  /// `isApproximatelyEqual(to:absoluteTolerance:relativeTolerance:)`
+  /// semantics, in a single pass.
+  @inlinable
+  public init<Element>(
+    comparing a: UnsafeBufferPointer<Element>,
+    to b: UnsafeBufferPointer<Element>,
+    absoluteTolerance: Magnitude,
+    relativeTolerance: Magnitude = 0
+  ) where Element: Numeric, Element.Magnitude == Magnitude {
+    self.init(comparing: a, to: b, absoluteTolerance: absoluteTolerance,
+              relativeTolerance: relativeTolerance, norm: { $0.magnitude })
+  }
+}
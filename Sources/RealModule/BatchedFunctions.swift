@@ -0,0 +1,1064 @@
+//===--- BatchedFunctions.swift -------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+// Batched forms of the ElementaryFunctions and RealFunctions operations.
+//
+// Each function comes in two flavors: one that reads from an input buffer and
+// writes to an output buffer of the same count, and one that operates in
+// place on a single mutable buffer. The output buffer may be the same memory
+// as the input buffer, but the two must not partially overlap.
+//
+// The default implementations are simple loops over the scalar functions,
+// so they have exactly the same accuracy as the scalar versions. They exist
+// so that callers have a single entry point that concrete types can
+// specialize when they have something better to offer.
+//
+// Float and Double do: exp, expMinusOne, log, log(onePlus:), cos, sin,
+// tanh, erf, erfc and logGamma are evaluated by vectorizable kernels from
+// _NumericsShims when the buffer forms are called on those concrete types,
+// as is gamma for Float. The Float kernels are very nearly correctly
+// rounded; the Double kernels have errors of about one ulp (tanh about two
+// and a half, logGamma three, and erfc three and a half), comparable to the
+// host libm. The logGamma kernels never compute the sign of gamma, so
+// non-positive inputs, where it matters, take the scalar path.
+
+import _NumericsShims
+
+extension ElementaryFunctions {
+  @usableFromInline @_transparent
+  internal static func _map(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>,
+    _ f: (Self) -> Self
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    for i in 0 ..< x.count { result[i] = f(x[i]) }
+  }
+  
+  @usableFromInline @_transparent
+  internal static func _map(
+    _ x: UnsafeBufferPointer<Self>,
+    _ y: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>,
+    _ f: (Self, Self) -> Self
+  ) {
+    precondition(x.count == y.count && x.count == result.count,
+      "x, y, and result must all have the same count.")
+    for i in 0 ..< x.count { result[i] = f(x[i], y[i]) }
+  }
+
+  /// Applies `float` or `double` to `x` in place when `Self` is Float or
+  /// Double, and `scalar` to each element otherwise.
+  ///
+  /// The batched functions are not protocol requirements, so generic code
+  /// (here, and in ComplexModule) has to select the concrete kernels
+  /// itself; the type checks are resolved at compile time once this is
+  /// specialized.
+  @_transparent
+  public static func _applyBatched(
+    _ x: UnsafeMutableBufferPointer<Self>,
+    float: (UnsafeMutableBufferPointer<Float>) -> Void,
+    double: (UnsafeMutableBufferPointer<Double>) -> Void,
+    scalar: (Self) -> Self
+  ) {
+    guard let base = x.baseAddress else { return }
+    if Self.self == Float.self {
+      base.withMemoryRebound(to: Float.self, capacity: x.count) {
+        float(UnsafeMutableBufferPointer(start: $0, count: x.count))
+      }
+      return
+    }
+    if Self.self == Double.self {
+      base.withMemoryRebound(to: Double.self, capacity: x.count) {
+        double(UnsafeMutableBufferPointer(start: $0, count: x.count))
+      }
+      return
+    }
+    for i in x.indices { x[i] = scalar(x[i]) }
+  }
+  
+  /// Computes `exp()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func exp(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.exp($0) }
+  }
+  
+  /// Replaces each element of `x` with `exp()` of that element.
+  @inlinable
+  public static func exp(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.exp($0) }
+  }
+  
+  /// Computes `expMinusOne()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func expMinusOne(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.expMinusOne($0) }
+  }
+  
+  /// Replaces each element of `x` with `expMinusOne()` of that element.
+  @inlinable
+  public static func expMinusOne(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.expMinusOne($0) }
+  }
+  
+  /// Computes `cosh()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func cosh(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.cosh($0) }
+  }
+  
+  /// Replaces each element of `x` with `cosh()` of that element.
+  @inlinable
+  public static func cosh(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.cosh($0) }
+  }
+  
+  /// Computes `sinh()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func sinh(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.sinh($0) }
+  }
+  
+  /// Replaces each element of `x` with `sinh()` of that element.
+  @inlinable
+  public static func sinh(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.sinh($0) }
+  }
+  
+  /// Computes `tanh()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func tanh(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.tanh($0) }
+  }
+  
+  /// Replaces each element of `x` with `tanh()` of that element.
+  @inlinable
+  public static func tanh(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.tanh($0) }
+  }
+  
+  /// Computes `cos()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func cos(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.cos($0) }
+  }
+  
+  /// Replaces each element of `x` with `cos()` of that element.
+  @inlinable
+  public static func cos(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.cos($0) }
+  }
+  
+  /// Computes `sin()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func sin(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.sin($0) }
+  }
+  
+  /// Replaces each element of `x` with `sin()` of that element.
+  @inlinable
+  public static func sin(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.sin($0) }
+  }
+  
+  /// Computes `tan()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func tan(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.tan($0) }
+  }
+  
+  /// Replaces each element of `x` with `tan()` of that element.
+  @inlinable
+  public static func tan(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.tan($0) }
+  }
+  
+  /// Computes `log()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func log(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.log($0) }
+  }
+  
+  /// Replaces each element of `x` with `log()` of that element.
+  @inlinable
+  public static func log(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.log($0) }
+  }
+  
+  /// Computes `log(onePlus:)` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func log(
+    onePlus x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.log(onePlus: $0) }
+  }
+  
+  /// Replaces each element of `x` with `log(onePlus:)` of that element.
+  @inlinable
+  public static func log(onePlus x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.log(onePlus: $0) }
+  }
+  
+  /// Computes `acosh()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func acosh(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.acosh($0) }
+  }
+  
+  /// Replaces each element of `x` with `acosh()` of that element.
+  @inlinable
+  public static func acosh(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.acosh($0) }
+  }
+  
+  /// Computes `asinh()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func asinh(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.asinh($0) }
+  }
+  
+  /// Replaces each element of `x` with `asinh()` of that element.
+  @inlinable
+  public static func asinh(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.asinh($0) }
+  }
+  
+  /// Computes `atanh()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func atanh(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.atanh($0) }
+  }
+  
+  /// Replaces each element of `x` with `atanh()` of that element.
+  @inlinable
+  public static func atanh(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.atanh($0) }
+  }
+  
+  /// Computes `acos()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func acos(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.acos($0) }
+  }
+  
+  /// Replaces each element of `x` with `acos()` of that element.
+  @inlinable
+  public static func acos(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.acos($0) }
+  }
+  
+  /// Computes `asin()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func asin(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.asin($0) }
+  }
+  
+  /// Replaces each element of `x` with `asin()` of that element.
+  @inlinable
+  public static func asin(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.asin($0) }
+  }
+  
+  /// Computes `atan()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func atan(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.atan($0) }
+  }
+  
+  /// Replaces each element of `x` with `atan()` of that element.
+  @inlinable
+  public static func atan(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.atan($0) }
+  }
+  
+  /// Computes `sqrt()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func sqrt(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.sqrt($0) }
+  }
+  
+  /// Replaces each element of `x` with `sqrt()` of that element.
+  @inlinable
+  public static func sqrt(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.sqrt($0) }
+  }
+  
+  /// Computes `pow(x[i], y[i])` for each index `i`, storing the results to
+  /// `result`.
+  @inlinable
+  public static func pow(
+    _ x: UnsafeBufferPointer<Self>,
+    _ y: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, y, into: result) { Self.pow($0, $1) }
+  }
+  
+  /// Computes `pow(_:_:)` of each element of `x` raised to the nth power,
+  /// storing the results to `result`.
+  @inlinable
+  public static func pow(
+    _ x: UnsafeBufferPointer<Self>,
+    _ n: Int,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.pow($0, n) }
+  }
+  
+  /// Replaces each element of `x` with that element raised to the nth power.
+  @inlinable
+  public static func pow(_ x: UnsafeMutableBufferPointer<Self>, _ n: Int) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.pow($0, n) }
+  }
+  
+  /// Computes the nth root of each element of `x`, storing the results to
+  /// `result`.
+  @inlinable
+  public static func root(
+    _ x: UnsafeBufferPointer<Self>,
+    _ n: Int,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.root($0, n) }
+  }
+  
+  /// Replaces each element of `x` with the nth root of that element.
+  @inlinable
+  public static func root(_ x: UnsafeMutableBufferPointer<Self>, _ n: Int) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.root($0, n) }
+  }
+}
+
+extension RealFunctions {
+  /// Computes `atan2(y: y[i], x: x[i])` for each index `i`, storing the
+  /// results to `result`.
+  @inlinable
+  public static func atan2(
+    y: UnsafeBufferPointer<Self>,
+    x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(y, x, into: result) { Self.atan2(y: $0, x: $1) }
+  }
+  
+  /// Computes `hypot(x[i], y[i])` for each index `i`, storing the results to
+  /// `result`.
+  @inlinable
+  public static func hypot(
+    _ x: UnsafeBufferPointer<Self>,
+    _ y: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, y, into: result) { Self.hypot($0, $1) }
+  }
+  
+  /// Computes `erf()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func erf(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.erf($0) }
+  }
+  
+  /// Replaces each element of `x` with `erf()` of that element.
+  @inlinable
+  public static func erf(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.erf($0) }
+  }
+  
+  /// Computes `erfc()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func erfc(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.erfc($0) }
+  }
+  
+  /// Replaces each element of `x` with `erfc()` of that element.
+  @inlinable
+  public static func erfc(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.erfc($0) }
+  }
+  
+  /// Computes `exp2()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func exp2(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.exp2($0) }
+  }
+  
+  /// Replaces each element of `x` with `exp2()` of that element.
+  @inlinable
+  public static func exp2(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.exp2($0) }
+  }
+  
+  /// Computes `exp10()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func exp10(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.exp10($0) }
+  }
+  
+  /// Replaces each element of `x` with `exp10()` of that element.
+  @inlinable
+  public static func exp10(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.exp10($0) }
+  }
+  
+  /// Computes `gamma()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func gamma(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.gamma($0) }
+  }
+  
+  /// Replaces each element of `x` with `gamma()` of that element.
+  @inlinable
+  public static func gamma(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.gamma($0) }
+  }
+  
+  /// Computes `log2()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func log2(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.log2($0) }
+  }
+  
+  /// Replaces each element of `x` with `log2()` of that element.
+  @inlinable
+  public static func log2(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.log2($0) }
+  }
+  
+  /// Computes `log10()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func log10(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.log10($0) }
+  }
+  
+  /// Replaces each element of `x` with `log10()` of that element.
+  @inlinable
+  public static func log10(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.log10($0) }
+  }
+  
+  #if !os(Windows)
+  /// Computes `logGamma()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func logGamma(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.logGamma($0) }
+  }
+  
+  /// Replaces each element of `x` with `logGamma()` of that element.
+  @inlinable
+  public static func logGamma(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.logGamma($0) }
+  }
+  #endif
+}
+
+extension Float {
+  @_transparent
+  public static func exp(
+    _ x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_expf(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func exp(_ x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_expf(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func expMinusOne(
+    _ x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_expm1f(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func expMinusOne(_ x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_expm1f(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func log(
+    _ x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_logf(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func log(_ x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_logf(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func log(
+    onePlus x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_log1pf(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func log(onePlus x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_log1pf(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func cos(
+    _ x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_cosf(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func cos(_ x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_cosf(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func sin(
+    _ x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_sinf(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func sin(_ x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_sinf(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func tanh(
+    _ x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_tanhf(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func tanh(_ x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_tanhf(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func erf(
+    _ x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_erff(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func erf(_ x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_erff(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func erfc(
+    _ x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_erfcf(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func erfc(_ x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_erfcf(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func gamma(
+    _ x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_tgammaf(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func gamma(_ x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_tgammaf(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  #if !os(Windows)
+  @_transparent
+  public static func logGamma(
+    _ x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_lgammaf(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func logGamma(_ x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_lgammaf(x.baseAddress, x.baseAddress, x.count)
+  }
+  #endif
+}
+
+extension Double {
+  @_transparent
+  public static func exp(
+    _ x: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_exp(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func exp(_ x: UnsafeMutableBufferPointer<Double>) {
+    _numerics_batch_exp(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func expMinusOne(
+    _ x: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_expm1(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func expMinusOne(_ x: UnsafeMutableBufferPointer<Double>) {
+    _numerics_batch_expm1(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func log(
+    _ x: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_log(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func log(_ x: UnsafeMutableBufferPointer<Double>) {
+    _numerics_batch_log(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func log(
+    onePlus x: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_log1p(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func log(onePlus x: UnsafeMutableBufferPointer<Double>) {
+    _numerics_batch_log1p(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func cos(
+    _ x: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_cos(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func cos(_ x: UnsafeMutableBufferPointer<Double>) {
+    _numerics_batch_cos(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func sin(
+    _ x: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_sin(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func sin(_ x: UnsafeMutableBufferPointer<Double>) {
+    _numerics_batch_sin(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func tanh(
+    _ x: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_tanh(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func tanh(_ x: UnsafeMutableBufferPointer<Double>) {
+    _numerics_batch_tanh(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func erf(
+    _ x: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_erf(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func erf(_ x: UnsafeMutableBufferPointer<Double>) {
+    _numerics_batch_erf(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func erfc(
+    _ x: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_erfc(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func erfc(_ x: UnsafeMutableBufferPointer<Double>) {
+    _numerics_batch_erfc(x.baseAddress, x.baseAddress, x.count)
+  }
+  
+  #if !os(Windows)
+  @_transparent
+  public static func logGamma(
+    _ x: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_lgamma(x.baseAddress, result.baseAddress, x.count)
+  }
+  
+  @_transparent
+  public static func logGamma(_ x: UnsafeMutableBufferPointer<Double>) {
+    _numerics_batch_lgamma(x.baseAddress, x.baseAddress, x.count)
+  }
+  #endif
+}
+
+// Float16 has no kernels of its own. Instead, each block of 64 elements is
+// widened into a Float buffer on the stack, evaluated by the corresponding
+// Float buffer function, and narrowed into the result. The conversions are
+// single vector instructions on targets with hardware Float16 support, and
+// the full round trip stays in registers and L1, so memory traffic remains
+// that of Float16 data. Because the Float kernels are very nearly correctly
+// rounded, the results are within one Float16 ulp of the scalar functions
+// (and usually identical).
+#if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+@available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *)
+extension Float16 {
+  @usableFromInline @_transparent
+  internal static func _widened(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>,
+    _ f: (UnsafeMutableBufferPointer<Float>) -> Void
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    var block = SIMD64<Float>()
+    withUnsafeMutablePointer(to: &block) {
+      $0.withMemoryRebound(to: Float.self, capacity: 64) { storage in
+        var start = 0
+        while start < x.count {
+          let count = min(64, x.count - start)
+          let buffer = UnsafeMutableBufferPointer(start: storage, count: count)
+          for i in 0 ..< count { buffer[i] = Float(x[start + i]) }
+          f(buffer)
+          for i in 0 ..< count { result[start + i] = Float16(buffer[i]) }
+          start += count
+        }
+      }
+    }
+  }
+  
+  @_transparent
+  public static func exp(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.exp($0) }
+  }
+  
+  @_transparent
+  public static func exp(_ x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.exp($0) }
+  }
+  
+  @_transparent
+  public static func expMinusOne(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.expMinusOne($0) }
+  }
+  
+  @_transparent
+  public static func expMinusOne(_ x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.expMinusOne($0) }
+  }
+  
+  @_transparent
+  public static func log(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.log($0) }
+  }
+  
+  @_transparent
+  public static func log(_ x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.log($0) }
+  }
+  
+  @_transparent
+  public static func log(
+    onePlus x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.log(onePlus: $0) }
+  }
+  
+  @_transparent
+  public static func log(onePlus x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.log(onePlus: $0) }
+  }
+  
+  @_transparent
+  public static func cos(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.cos($0) }
+  }
+  
+  @_transparent
+  public static func cos(_ x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.cos($0) }
+  }
+  
+  @_transparent
+  public static func sin(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.sin($0) }
+  }
+  
+  @_transparent
+  public static func sin(_ x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.sin($0) }
+  }
+  
+  @_transparent
+  public static func tanh(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.tanh($0) }
+  }
+  
+  @_transparent
+  public static func tanh(_ x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.tanh($0) }
+  }
+  
+  @_transparent
+  public static func erf(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.erf($0) }
+  }
+  
+  @_transparent
+  public static func erf(_ x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.erf($0) }
+  }
+  
+  @_transparent
+  public static func erfc(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.erfc($0) }
+  }
+  
+  @_transparent
+  public static func erfc(_ x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.erfc($0) }
+  }
+  
+  @_transparent
+  public static func gamma(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.gamma($0) }
+  }
+  
+  @_transparent
+  public static func gamma(_ x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.gamma($0) }
+  }
+  
+  #if !os(Windows)
+  @_transparent
+  public static func logGamma(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.logGamma($0) }
+  }
+  
+  @_transparent
+  public static func logGamma(_ x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.logGamma($0) }
+  }
+  #endif
+}
+#endif
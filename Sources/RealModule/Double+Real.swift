@@ -22,6 +22,14 @@ extension Double: Real {
     libm_sin(x)
   }
   
+  @_transparent
+  public static func sincos(_ x: Double) -> (sin: Double, cos: Double) {
+    var s: Double = 0
+    var c: Double = 0
+    libm_sincos(x, &s, &c)
+    return (s, c)
+  }
+  
   @_transparent
   public static func tan(_ x: Double) -> Double {
     libm_tan(x)
@@ -155,6 +163,9 @@ extension Double: Real {
   
   @_transparent
   public static func pow(_ x: Double, _ n: Int) -> Double {
+    // Small exponents are handled by repeated squaring, which is much
+    // cheaper than the libm function.
+    if let result = _powBySquaring(x, n) { return result }
     // If n is exactly representable as Double, we can just call pow:
     // Note that all calls on a 32b platform go down this path.
     if let y = Double(exactly: n) { return libm_pow(x, y) }
@@ -0,0 +1,600 @@
+//===--- DoubleDouble.swift -----------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+/// A double-word floating-point number: the unevaluated sum of two `Double`
+/// values, which gives about 106 bits of precision with the exponent range
+/// of `Double`.
+///
+/// The value is always normalized, meaning `head` is `head + tail` rounded
+/// to `Double`, so the representation of each value is unique. The basic
+/// operations are built on the error-free transformations in `Augmented`
+/// and are accurate to a few units in the 106th bit; the elementary
+/// functions are accurate to about 100 bits. This makes `DoubleDouble` a
+/// convenient reference for checking `Double` results, much faster than
+/// arbitrary-precision arithmetic, and available on every platform (unlike
+/// `Float80`, which is also far less precise). It is also useful as a
+/// compensated accumulator, through `add(_:)` and `addProduct(_:_:)`.
+///
+/// `DoubleDouble` conforms to `AlgebraicField` and to `ElementaryFunctions`,
+/// but not to `Real`, because it is not a `FloatingPoint` type: it has no
+/// fixed significand width near zero, its `ulp` would not be well defined,
+/// and there is no hardware rounding for it to follow. Non-finite results
+/// and overflow are handled by returning the `Double` result for the head,
+/// with a zero tail. Subnormal results have only the precision of `Double`.
+@frozen
+public struct DoubleDouble: Hashable {
+  /// The leading part of the value, which is the value rounded to `Double`.
+  public let head: Double
+
+  /// The rounding error of `head`, at most half an ulp of `head` in
+  /// magnitude.
+  public let tail: Double
+
+  // A value from parts that are already normalized.
+  @_transparent @usableFromInline
+  internal init(uncheckedHead head: Double, tail: Double) {
+    self.head = head
+    self.tail = tail
+  }
+
+  /// The value `head + tail`, computed exactly and normalized.
+  @_transparent
+  public init(head: Double, tail: Double) {
+    let s = Augmented.twoSum(head, tail)
+    self = s.head.isFinite ? DoubleDouble(uncheckedHead: s.head, tail: s.tail) :
+                             DoubleDouble(s.head)
+  }
+
+  /// The value `x`, exactly.
+  @_transparent
+  public init(_ x: Double) {
+    self.init(uncheckedHead: x, tail: 0)
+  }
+
+  /// The value `n`, exactly.
+  @inlinable
+  public init(_ n: Int) {
+    // Both halves are exactly representable, and so is their sum.
+    let m = Int64(n)
+    let high = m & ~0xffff_ffff
+    let s = Augmented.twoSum(Double(high), Double(m - high))
+    self.init(uncheckedHead: s.head, tail: s.tail)
+  }
+
+  /// `head + tail`, where `|a| >= |b|` or `a` is zero.
+  ///
+  /// This is `Augmented.fastTwoSum` without its assertion, which does not
+  /// allow for the cases where a larger `b` is harmless because `a + b`
+  /// is exact.
+  @_transparent @usableFromInline
+  internal static func _normalize(_ a: Double, _ b: Double) -> DoubleDouble {
+    let head = a + b
+    guard head.isFinite else { return DoubleDouble(head) }
+    return DoubleDouble(uncheckedHead: head, tail: a - head + b)
+  }
+
+  /// `self * 2**e`, for `e` between -2098 and 2046.
+  @inlinable
+  internal func _scaled(by e: Int) -> DoubleDouble {
+    // Two steps, so that both scale factors are representable.
+    let s1 = Double(sign: .plus, exponent: e / 2, significand: 1)
+    let s2 = Double(sign: .plus, exponent: e - e / 2, significand: 1)
+    let h = head * s1 * s2
+    guard h.isFinite && h != 0 else { return DoubleDouble(h) }
+    return DoubleDouble(uncheckedHead: h, tail: tail * s1 * s2)
+  }
+}
+
+extension Double {
+  /// `x` rounded to `Double`.
+  @_transparent
+  public init(_ x: DoubleDouble) {
+    // Because x is normalized, this sum is correctly rounded.
+    self = x.head + x.tail
+  }
+}
+
+// MARK: - Arithmetic
+extension DoubleDouble: Comparable {
+  @_transparent
+  public static func <(a: DoubleDouble, b: DoubleDouble) -> Bool {
+    a.head < b.head || (a.head == b.head && a.tail < b.tail)
+  }
+}
+
+extension DoubleDouble: ExpressibleByIntegerLiteral {
+  @_transparent
+  public init(integerLiteral value: Int) {
+    self.init(value)
+  }
+}
+
+extension DoubleDouble: AlgebraicField {
+  public typealias Magnitude = DoubleDouble
+
+  @_transparent
+  public static var zero: DoubleDouble {
+    DoubleDouble(0)
+  }
+
+  /// `n`, if it is representable as an `Int`.
+  @inlinable
+  public init?<Source>(exactly source: Source) where Source: BinaryInteger {
+    guard let n = Int(exactly: source) else { return nil }
+    self.init(n)
+  }
+
+  @_transparent
+  public var magnitude: DoubleDouble {
+    head.sign == .minus ? -self : self
+  }
+
+  @_transparent
+  public static prefix func -(x: DoubleDouble) -> DoubleDouble {
+    DoubleDouble(uncheckedHead: -x.head, tail: -x.tail)
+  }
+
+  /// The sum `a + b`, with relative error at most 3·2⁻¹⁰⁶.
+  @inlinable
+  public static func +(a: DoubleDouble, b: DoubleDouble) -> DoubleDouble {
+    // Joldes, Muller & Popescu, "Tight and rigorous error bounds for basic
+    // building blocks of double-word arithmetic", Algorithm 6.
+    let s = Augmented.twoSum(a.head, b.head)
+    guard s.head.isFinite else { return DoubleDouble(s.head) }
+    let t = Augmented.twoSum(a.tail, b.tail)
+    let v = _normalize(s.head, s.tail + t.head)
+    return _normalize(v.head, v.tail + t.tail)
+  }
+
+  @_transparent
+  public static func +=(a: inout DoubleDouble, b: DoubleDouble) {
+    a = a + b
+  }
+
+  @_transparent
+  public static func -(a: DoubleDouble, b: DoubleDouble) -> DoubleDouble {
+    a + -b
+  }
+
+  @_transparent
+  public static func -=(a: inout DoubleDouble, b: DoubleDouble) {
+    a = a - b
+  }
+
+  /// The product `a * b`, with relative error at most 4·2⁻¹⁰⁶.
+  @inlinable
+  public static func *(a: DoubleDouble, b: DoubleDouble) -> DoubleDouble {
+    // Algorithm 12 of Joldes, Muller & Popescu.
+    let p = Augmented.twoProdFMA(a.head, b.head)
+    guard p.head.isFinite else { return DoubleDouble(p.head) }
+    let low = (a.tail * b.tail).addingProduct(a.head, b.tail)
+    return _normalize(p.head, p.tail + low.addingProduct(a.tail, b.head))
+  }
+
+  @_transparent
+  public static func *=(a: inout DoubleDouble, b: DoubleDouble) {
+    a = a * b
+  }
+
+  /// The quotient `a / b`, with relative error of a few units in 2⁻¹⁰⁶.
+  @inlinable
+  public static func /(a: DoubleDouble, b: DoubleDouble) -> DoubleDouble {
+    // Long division: each partial quotient is computed in Double, and its
+    // remainder is exact enough for the next one to be accurate.
+    let q1 = a.head / b.head
+    guard q1.isFinite && b.head.isFinite else { return DoubleDouble(q1) }
+    var r = a - b.multiplied(by: q1)
+    let q2 = r.head / b.head
+    r = r - b.multiplied(by: q2)
+    let q3 = r.head / b.head
+    return _normalize(q1, q2).adding(q3)
+  }
+
+  @_transparent
+  public static func /=(a: inout DoubleDouble, b: DoubleDouble) {
+    a = a / b
+  }
+
+  @inlinable
+  public var reciprocal: DoubleDouble? {
+    let r = 1 / self
+    // The same rule as Real: zero and infinity are reciprocal, but results
+    // that are not normal have lost precision.
+    if r.head.isNormal || head == 0 || !head.isFinite {
+      return r
+    }
+    return nil
+  }
+}
+
+extension DoubleDouble {
+  /// The sum `self + x`, with relative error at most 2·2⁻¹⁰⁶.
+  @inlinable
+  public func adding(_ x: Double) -> DoubleDouble {
+    // Algorithm 4 of Joldes, Muller & Popescu.
+    let s = Augmented.twoSum(head, x)
+    guard s.head.isFinite else { return DoubleDouble(s.head) }
+    return DoubleDouble._normalize(s.head, tail + s.tail)
+  }
+
+  /// The product `self * x`, with relative error at most 2·2⁻¹⁰⁶.
+  @inlinable
+  public func multiplied(by x: Double) -> DoubleDouble {
+    // Algorithm 9 of Joldes, Muller & Popescu.
+    let p = Augmented.twoProdFMA(head, x)
+    guard p.head.isFinite else { return DoubleDouble(p.head) }
+    return DoubleDouble._normalize(p.head, p.tail.addingProduct(tail, x))
+  }
+
+  /// The quotient `self / x`, with relative error at most 3·2⁻¹⁰⁶.
+  @inlinable
+  public func divided(by x: Double) -> DoubleDouble {
+    // Algorithm 15 of Joldes, Muller & Popescu; head - p.head is exact.
+    let q = head / x
+    guard q.isFinite && x.isFinite else { return DoubleDouble(q) }
+    let p = Augmented.twoProdFMA(q, x)
+    let r = (head - p.head - p.tail + tail) / x
+    return DoubleDouble._normalize(q, r)
+  }
+
+  /// Adds `x` to this value, with no rounding error beyond that of `+`.
+  ///
+  /// Accumulating a sum this way gives a result about as accurate as if
+  /// every term were added exactly and the total rounded to 106 bits.
+  @inlinable
+  public mutating func add(_ x: Double) {
+    self = adding(x)
+  }
+
+  /// Adds the product `a * b`, computed exactly, to this value.
+  @inlinable
+  public mutating func addProduct(_ a: Double, _ b: Double) {
+    let p = Augmented.twoProdFMA(a, b)
+    self += DoubleDouble(uncheckedHead: p.head, tail: p.tail)
+  }
+
+  /// True if the value is neither infinite nor nan.
+  @_transparent
+  public var isFinite: Bool { head.isFinite }
+
+  /// True if the value is nan.
+  @_transparent
+  public var isNaN: Bool { head.isNaN }
+}
+
+extension DoubleDouble: CustomStringConvertible {
+  public var description: String {
+    "\(head) + \(tail)"
+  }
+}
+
+// MARK: - Elementary functions
+//
+// Each function starts from the Double result for the head (which supplies
+// the handling of every special case) and either refines it by one Newton
+// step, which doubles the number of correct bits, or reduces the argument
+// to a small interval where a Taylor series converges quickly. None of
+// these are inlinable: they are long, and the constants are private.
+
+extension DoubleDouble {
+  // ln(2), π/2 and 2/π, split into Doubles whose sum is correct to about
+  // 160 bits, so that multiples of them can be subtracted accurately.
+  private static let ln2 = (0x1.62e42fefa39efp-1, 0x1.abc9e3b39803fp-56,
+                            0x1.7b57a079a1934p-111)
+  private static let halfPi = (0x1.921fb54442d18p+0, 0x1.1a62633145c07p-54,
+                               -0x1.f1976b7ed8fbcp-110)
+  private static let twoOverPi = 0x1.45f306dc9c883p-1
+
+  /// π, correctly rounded.
+  public static var pi: DoubleDouble {
+    DoubleDouble(uncheckedHead: 0x1.921fb54442d18p+1, tail: 0x1.1a62633145c07p-53)
+  }
+
+  private static var _ln2: DoubleDouble {
+    DoubleDouble(uncheckedHead: ln2.0, tail: ln2.1)
+  }
+
+  private static var _halfPi: DoubleDouble {
+    DoubleDouble(uncheckedHead: halfPi.0, tail: halfPi.1)
+  }
+
+  /// `self - k*c`, where `c` is a constant split into three parts and `k`
+  /// is an integer of moderate size, so that `k*c.0` and `k*c.1` can be
+  /// subtracted exactly; this is Cody & Waite's argument reduction.
+  private func subtracting(
+    _ k: Double, times c: (Double, Double, Double)
+  ) -> DoubleDouble {
+    let p0 = Augmented.twoProdFMA(k, c.0)
+    let p1 = Augmented.twoProdFMA(k, c.1)
+    return (self - DoubleDouble(uncheckedHead: p0.head, tail: p0.tail)
+                 - DoubleDouble(uncheckedHead: p1.head, tail: p1.tail)
+           ).adding(-k * c.2)
+  }
+
+  /// exp(x) - 1, for |x| at most ln(2)/2.
+  private static func expMinusOneKernel(_ x: DoubleDouble) -> DoubleDouble {
+    // The Taylor series for x/256 converges to 106 bits in ten terms, and
+    // each doubling, expm1(2y) = expm1(y)(expm1(y) + 2), loses very little.
+    let y = x._scaled(by: -8)
+    var term = y
+    var sum = y
+    for n in 2 ... 11 {
+      term = (term * y).divided(by: Double(n))
+      sum += term
+    }
+    for _ in 0 ..< 8 { sum = sum * (sum + 2) }
+    return sum
+  }
+
+  /// The integer k nearest x/ln(2), and exp(x - k ln(2)) - 1.
+  private static func expReduced(_ x: DoubleDouble) -> (k: Int, m: DoubleDouble) {
+    let k = (x.head / ln2.0).rounded()
+    return (Int(k), expMinusOneKernel(x.subtracting(k, times: ln2)))
+  }
+
+  public static func exp(_ x: DoubleDouble) -> DoubleDouble {
+    // Outside this range, the result (or the reduction) overflows or
+    // underflows, and the Double result is also the double-double one.
+    guard x.head > -746 && x.head < 710 else { return DoubleDouble(.exp(x.head)) }
+    let (k, m) = expReduced(x)
+    return (1 + m)._scaled(by: k)
+  }
+
+  public static func expMinusOne(_ x: DoubleDouble) -> DoubleDouble {
+    if x.head.magnitude <= 0.34 { return expMinusOneKernel(x) }
+    guard x.head > -40 && x.head < 100 else { return exp(x) - 1 }
+    // 2**k(1 + m) - 1 = (2**k - 1) + 2**k m, where 2**k - 1 is exact.
+    let (k, m) = expReduced(x)
+    let p = Double(sign: .plus, exponent: k, significand: 1)
+    return DoubleDouble(head: p, tail: -1) + m._scaled(by: k)
+  }
+
+  public static func cosh(_ x: DoubleDouble) -> DoubleDouble {
+    let a = x.magnitude
+    // exp(-a) is negligible, and exp(a) alone may overflow.
+    if a.head > 700 {
+      let e = exp(a._scaled(by: -1))
+      return e * e._scaled(by: -1)
+    }
+    let e = exp(a)
+    return (e + 1/e)._scaled(by: -1)
+  }
+
+  public static func sinh(_ x: DoubleDouble) -> DoubleDouble {
+    let a = x.magnitude
+    let r: DoubleDouble
+    if a.head > 700 {
+      let e = exp(a._scaled(by: -1))
+      r = e * e._scaled(by: -1)
+    } else {
+      // sinh(a) = (m + m/(m + 1))/2, where m = expm1(a), has no
+      // cancellation for small a.
+      let m = expMinusOne(a)
+      r = (m + m / (m + 1))._scaled(by: -1)
+    }
+    return x.head.sign == .minus ? -r : r
+  }
+
+  public static func tanh(_ x: DoubleDouble) -> DoubleDouble {
+    let a = x.magnitude
+    let r: DoubleDouble
+    // Beyond 40, 1 - tanh(a) < 2**-114.
+    if a.head > 40 || a.head.isNaN { r = DoubleDouble(Double.tanh(a.head)) }
+    else {
+      let m = expMinusOne(a._scaled(by: 1))
+      r = m / (m + 2)
+    }
+    return x.head.sign == .minus ? -r : r
+  }
+
+  /// sin(x) and cos(x), for |x| at most about π/4.
+  private static func sinCosKernel(_ x: DoubleDouble) -> (sin: DoubleDouble, cos: DoubleDouble) {
+    // The Taylor series, through the terms in x²⁹ and x²⁸.
+    let x2 = x * x
+    var s = x, ts = x
+    var c: DoubleDouble = 1, tc: DoubleDouble = 1
+    for n in stride(from: 2, through: 28, by: 2) {
+      tc = -(tc * x2).divided(by: Double((n - 1) * n))
+      ts = -(ts * x2).divided(by: Double(n * (n + 1)))
+      c += tc
+      s += ts
+    }
+    return (s, c)
+  }
+
+  /// sin(x) and cos(x).
+  ///
+  /// The argument is reduced by the nearest multiple of π/2; the reduction
+  /// is accurate for |x| up to about 2²⁰, except extremely close to
+  /// multiples of π/2, and loses accuracy progressively beyond that.
+  private static func sinCos(_ x: DoubleDouble) -> (sin: DoubleDouble, cos: DoubleDouble) {
+    guard x.head.isFinite else {
+      let nan = DoubleDouble(.nan)
+      return (nan, nan)
+    }
+    let k = (x.head * twoOverPi).rounded()
+    let (s, c) = sinCosKernel(x.subtracting(k, times: halfPi))
+    switch Int(k.truncatingRemainder(dividingBy: 4)) & 3 {
+    case 0: return (s, c)
+    case 1: return (c, -s)
+    case 2: return (-s, -c)
+    default: return (-c, s)
+    }
+  }
+
+  public static func cos(_ x: DoubleDouble) -> DoubleDouble {
+    sinCos(x).cos
+  }
+
+  public static func sin(_ x: DoubleDouble) -> DoubleDouble {
+    sinCos(x).sin
+  }
+
+  public static func tan(_ x: DoubleDouble) -> DoubleDouble {
+    let (s, c) = sinCos(x)
+    return s / c
+  }
+
+  /// log(onePlus: x), for x in about [-1/2, 1].
+  private static func logOnePlusKernel(_ x: DoubleDouble) -> DoubleDouble {
+    // One Newton step for expm1(y) = x.
+    let y = DoubleDouble(Double.log(onePlus: x.head))
+    let e = expMinusOne(y)
+    return y - (e - x) / (e + 1)
+  }
+
+  public static func log(_ x: DoubleDouble) -> DoubleDouble {
+    guard x.head > 0 && x.head.isFinite else { return DoubleDouble(.log(x.head)) }
+    // x = 2**e m, with m in [1/√2, √2], so that there is no cancellation
+    // between e ln(2) and log(m), which is computed as log(onePlus: m - 1).
+    var e = x.head.exponent
+    var m = x._scaled(by: -e)
+    if m.head > 0x1.6a09e667f3bcdp+0 {
+      e += 1
+      m = m._scaled(by: -1)
+    }
+    let y = logOnePlusKernel(m - 1)
+    if e == 0 { return y }
+    let p = Augmented.twoProdFMA(Double(e), ln2.0)
+    return DoubleDouble(uncheckedHead: p.head, tail: p.tail)
+      .adding(Double(e) * ln2.1) + y
+  }
+
+  public static func log(onePlus x: DoubleDouble) -> DoubleDouble {
+    if x.head >= -0.5 && x.head <= 1 { return logOnePlusKernel(x) }
+    return log(1 + x)
+  }
+
+  public static func acosh(_ x: DoubleDouble) -> DoubleDouble {
+    // For large x, acosh(x) = log(2x) to full precision, and x² overflows.
+    if x.head > 0x1p100 { return log(x) + _ln2 }
+    // acosh(x) = log1p(t + √(t(t + 2))), with t = x - 1; this is nan for
+    // x < 1.
+    let t = x - 1
+    return log(onePlus: t + sqrt(t * (t + 2)))
+  }
+
+  public static func asinh(_ x: DoubleDouble) -> DoubleDouble {
+    let a = x.magnitude
+    let r: DoubleDouble
+    if a.head > 0x1p100 || !a.head.isFinite { r = log(a) + _ln2 }
+    else {
+      // asinh(a) = log1p(a + a²/(1 + √(1 + a²))), without cancellation.
+      let a2 = a * a
+      r = log(onePlus: a + a2 / (1 + sqrt(1 + a2)))
+    }
+    return x.head.sign == .minus ? -r : r
+  }
+
+  public static func atanh(_ x: DoubleDouble) -> DoubleDouble {
+    // atanh(a) = log1p(2a/(1 - a))/2; for a > 1, the argument of log1p is
+    // less than -1, and the result is nan.
+    let a = x.magnitude
+    let r = log(onePlus: (2 * a) / (1 - a))._scaled(by: -1)
+    return x.head.sign == .minus ? -r : r
+  }
+
+  public static func acos(_ x: DoubleDouble) -> DoubleDouble {
+    atan2(y: sqrt((1 - x) * (1 + x)), x: x)
+  }
+
+  public static func asin(_ x: DoubleDouble) -> DoubleDouble {
+    atan2(y: x, x: sqrt((1 - x) * (1 + x)))
+  }
+
+  public static func atan(_ x: DoubleDouble) -> DoubleDouble {
+    guard x.head.isFinite else {
+      if x.head.isNaN { return x }
+      return x.head > 0 ? _halfPi : -_halfPi
+    }
+    // One Newton step: if y is close to atan(x), the remaining angle has
+    // tangent (x cos(y) - sin(y))/(cos(y) + x sin(y)), and is tiny enough
+    // to be its own arctangent.
+    let y = DoubleDouble(Double.atan(x.head))
+    let (s, c) = sinCos(y)
+    return y + (x * c - s) / (c + x * s)
+  }
+
+  /// The angle of the point (x, y) from the positive x axis, in (-π, π].
+  public static func atan2(y: DoubleDouble, x: DoubleDouble) -> DoubleDouble {
+    let t = Double.atan2(y: y.head, x: x.head)
+    guard x.head.isFinite && y.head.isFinite && (x.head != 0 || y.head != 0)
+    else { return DoubleDouble(t) }
+    // The same Newton step as atan, scaled so that the products cannot
+    // overflow or underflow.
+    let e = max(x.head.exponent, y.head.exponent)
+    let u = x._scaled(by: -e)
+    let v = y._scaled(by: -e)
+    let a = DoubleDouble(t)
+    let (s, c) = sinCos(a)
+    return a + (v * c - u * s) / (u * c + v * s)
+  }
+
+  /// The length of the vector (x, y), without undue overflow or
+  /// underflow.
+  public static func hypot(_ x: DoubleDouble, _ y: DoubleDouble) -> DoubleDouble {
+    guard x.head.isFinite && y.head.isFinite else {
+      return DoubleDouble(Double.hypot(x.head, y.head))
+    }
+    let e = max(x.head.exponent, y.head.exponent)
+    if e == Int.min { return 0 }
+    let u = x._scaled(by: -e)
+    let v = y._scaled(by: -e)
+    return sqrt(u * u + v * v)._scaled(by: e)
+  }
+
+  /// `exp(y * log(x))`, or nan if x is negative.
+  ///
+  /// The error grows with the magnitude of the result's logarithm, to
+  /// about 2⁻⁹⁴ for results near the overflow or underflow thresholds.
+  public static func pow(_ x: DoubleDouble, _ y: DoubleDouble) -> DoubleDouble {
+    guard x.head >= 0 else { return DoubleDouble(.nan) }
+    guard x.head != 0 && x.head.isFinite && y.head.isFinite else {
+      return DoubleDouble(.pow(x.head, y.head))
+    }
+    return exp(y * log(x))
+  }
+
+  /// `x` raised to the power `n`, computed by repeated squaring.
+  public static func pow(_ x: DoubleDouble, _ n: Int) -> DoubleDouble {
+    var base = x
+    var result: DoubleDouble = 1
+    var m = n.magnitude
+    while m != 0 {
+      if m & 1 != 0 { result *= base }
+      m >>= 1
+      if m != 0 { base *= base }
+    }
+    return n < 0 ? 1 / result : result
+  }
+
+  /// The square root of `x`, with relative error of a few units in 2⁻¹⁰⁶.
+  public static func sqrt(_ x: DoubleDouble) -> DoubleDouble {
+    let s = Double.sqrt(x.head)
+    guard s > 0 && s.isFinite else { return DoubleDouble(s) }
+    // One Newton step. s² is computed exactly; x.head - p.head is exact
+    // because the two are within a factor of two of each other.
+    let p = Augmented.twoProdFMA(s, s)
+    let r = x.head - p.head - p.tail + x.tail
+    return _normalize(s, r / (2 * s))
+  }
+
+  /// The `n`th root of `x`, or nan if `x` is negative and `n` is even.
+  public static func root(_ x: DoubleDouble, _ n: Int) -> DoubleDouble {
+    let y = Double.root(x.head, n)
+    guard y != 0 && y.isFinite else { return DoubleDouble(y) }
+    // One Newton step for y**n = x.
+    let r = DoubleDouble(y)
+    return r + (x / pow(r, n - 1) - r).divided(by: Double(n))
+  }
+}
+
+extension DoubleDouble: ElementaryFunctions { }
@@ -22,6 +22,14 @@ extension Float: Real {
     libm_sinf(x)
   }
   
+  @_transparent
+  public static func sincos(_ x: Float) -> (sin: Float, cos: Float) {
+    var s: Float = 0
+    var c: Float = 0
+    libm_sincosf(x, &s, &c)
+    return (s, c)
+  }
+  
   @_transparent
   public static func tan(_ x: Float) -> Float {
     libm_tanf(x)
@@ -142,6 +150,9 @@ extension Float: Real {
   
   @_transparent
   public static func pow(_ x: Float, _ n: Int) -> Float {
+    // Small exponents are handled by repeated squaring, which is much
+    // cheaper than the libm function.
+    if let result = _powBySquaring(x, n) { return result }
     // If n is exactly representable as Float, we can just call powf:
     if let y = Float(exactly: n) {
       return libm_powf(x, y)
@@ -27,6 +27,12 @@ extension Float16: Real {
     Float16(.sin(Float(x)))
   }
   
+  @_transparent
+  public static func sincos(_ x: Float16) -> (sin: Float16, cos: Float16) {
+    let (s, c) = Float.sincos(Float(x))
+    return (Float16(s), Float16(c))
+  }
+  
   @_transparent
   public static func tan(_ x: Float16) -> Float16 {
     Float16(.tan(Float(x)))
@@ -151,10 +157,10 @@ extension Float16: Real {
     // "interesting" exponents is pretty small; anything outside of
     // -22707 ... 34061 simply overflows or underflows for every
     // x that isn't zero or one. This whole range is representable
-    // as Float, so we can just use powf as long as we're a little
+    // as Float, so we can just use Float's pow as long as we're a little
     // bit (get it?) careful to preserve parity.
     let clamped = min(max(n, -0x10000), 0x10000) | (n & 1)
-    return Float16(libm_powf(Float(x), Float(clamped)))
+    return Float16(Float.pow(Float(x), clamped))
   }
   
   @_transparent
@@ -192,6 +198,12 @@ extension Float16: Real {
     Float16(.sin(Float(x)))
   }
   
+  @_transparent
+  public static func sincos(_ x: Float16) -> (sin: Float16, cos: Float16) {
+    let (s, c) = Float.sincos(Float(x))
+    return (Float16(s), Float16(c))
+  }
+  
   @_transparent
   public static func tan(_ x: Float16) -> Float16 {
     Float16(.tan(Float(x)))
@@ -316,10 +328,10 @@ extension Float16: Real {
     // "interesting" exponents is pretty small; anything outside of
     // -22707 ... 34061 simply overflows or underflows for every
     // x that isn't zero or one. This whole range is representable
-    // as Float, so we can just use powf as long as we're a little
+    // as Float, so we can just use Float's pow as long as we're a little
     // bit (get it?) careful to preserve parity.
     let clamped = min(max(n, -0x10000), 0x10000) | (n & 1)
-    return Float16(libm_powf(Float(x), Float(clamped)))
+    return Float16(Float.pow(Float(x), clamped))
   }
   
   @_transparent
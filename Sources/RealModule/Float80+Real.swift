@@ -24,6 +24,14 @@ extension Float80: Real {
     libm_sinl(x)
   }
   
+  @_transparent
+  public static func sincos(_ x: Float80) -> (sin: Float80, cos: Float80) {
+    var s: Float80 = 0
+    var c: Float80 = 0
+    libm_sincosl(x, &s, &c)
+    return (s, c)
+  }
+  
   @_transparent
   public static func tan(_ x: Float80) -> Float80 {
     libm_tanl(x)
@@ -139,8 +147,10 @@ extension Float80: Real {
   public static func pow(_ x: Float80, _ n: Int) -> Float80 {
     // Every Int value is exactly representable as Float80, so we don't need
     // to do anything fancy--unlike Float and Double, we can just call the
-    // libm pow function.
-    libm_powl(x, Float80(n))
+    // libm pow function (except for small exponents, which are handled
+    // by repeated squaring, as for the other types).
+    if let result = _powBySquaring(x, n) { return result }
+    return libm_powl(x, Float80(n))
   }
   
   @_transparent
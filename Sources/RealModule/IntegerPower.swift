@@ -0,0 +1,104 @@
+//===--- IntegerPower.swift -----------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+// Fast path for pow(x, n) with small integer exponents, shared by the
+// concrete implementations of pow(_:Int).
+//
+// Plain repeated squaring is not accurate enough to replace the libm pow
+// function: each squaring doubles the relative error already accumulated,
+// so x**64 may be off by dozens of ulps. Instead, everything but the
+// trivial cases is computed in double-word arithmetic (an unevaluated sum
+// head + tail, with every product computed exactly by Augmented.twoProdFMA),
+// which makes the result very nearly correctly rounded.
+
+extension Real {
+  /// `x**n` computed by repeated squaring, or `nil` if the result should
+  /// come from the general libm path instead.
+  ///
+  /// This returns `nil` if |n| is too large, and whenever the result would
+  /// not be a normal number (zero, subnormal, infinite or nan), so that
+  /// the handling of those cases is exactly that of libm.
+  ///
+  /// This is transparent so that a constant n folds down to the
+  /// straight-line code for that case.
+  @_transparent @usableFromInline
+  internal static func _powBySquaring(_ x: Self, _ n: Int) -> Self? {
+    switch n {
+    // These are exact or correctly rounded, including every edge case.
+    case 0: return 1
+    case 1: return x
+    case -1: return 1/x
+    case 2: return x*x
+    case 3:
+      let s = Augmented.twoProdFMA(x, x)
+      let p = Augmented.twoProdFMA(s.head, x)
+      let r = p.head + _mulAdd(s.tail, x, p.tail)
+      return r.isNormal ? r : nil
+    case 4:
+      let s = Augmented.twoProdFMA(x, x)
+      let p = Augmented.twoProdFMA(s.head, s.head)
+      let r = p.head + _mulAdd(2*s.head, s.tail, p.tail)
+      return r.isNormal ? r : nil
+    default:
+      guard n.magnitude <= 64 else { return nil }
+      return _powBySquaringCompensated(x, n)
+    }
+  }
+
+  // The general case of _powBySquaring, for 2 < |n| <= 64.
+  @inlinable
+  internal static func _powBySquaringCompensated(_ x: Self, _ n: Int) -> Self? {
+    var m = n.magnitude
+    var b = (head: x, tail: Self.zero)
+    while m & 1 == 0 {
+      b = _squareDoubleWord(b)
+      m >>= 1
+    }
+    var p = b
+    m >>= 1
+    while m != 0 {
+      b = _squareDoubleWord(b)
+      if m & 1 != 0 { p = _multiplyDoubleWord(p, b) }
+      m >>= 1
+    }
+    guard p.head.isNormal else { return nil }
+    if n > 0 { return p.head + p.tail }
+    // 1/(h + t): q = 1/h is refined by one Newton step, using the residual
+    // e = 1 - (h + t)q. hq is computed exactly by twoProdFMA (_mulAdd may
+    // not be fused), and its head is within an ulp of 1, so subtracting it
+    // from 1 is exact as well.
+    let q = 1/p.head
+    let hq = Augmented.twoProdFMA(p.head, q)
+    let e = ((1 - hq.head) - hq.tail) - p.tail*q
+    let r = _mulAdd(q, e, q)
+    return r.isNormal ? r : nil
+  }
+
+  // The square of a double-word value, which is itself double-word.
+  @usableFromInline @_transparent
+  internal static func _squareDoubleWord(
+    _ a: (head: Self, tail: Self)
+  ) -> (head: Self, tail: Self) {
+    let p = Augmented.twoProdFMA(a.head, a.head)
+    let tail = _mulAdd(2*a.head, a.tail, p.tail)
+    return Augmented.fastTwoSum(p.head, tail)
+  }
+
+  // The product of two double-word values, which is itself double-word.
+  @usableFromInline @_transparent
+  internal static func _multiplyDoubleWord(
+    _ a: (head: Self, tail: Self), _ b: (head: Self, tail: Self)
+  ) -> (head: Self, tail: Self) {
+    let p = Augmented.twoProdFMA(a.head, b.head)
+    let tail = _mulAdd(a.head, b.tail, _mulAdd(a.tail, b.head, p.tail))
+    return Augmented.fastTwoSum(p.head, tail)
+  }
+}
@@ -0,0 +1,324 @@
+//===--- NormalDistribution.swift -----------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import _NumericsShims
+
+// The cumulative distribution function of the standard normal distribution
+// and its inverse, in scalar and batched forms.
+//
+// Φ(x) = erfc(-x/√2)/2 is a one-liner, but not an accurate one: -x/√2 is
+// rounded, and erfc magnifies that relative error by about 2x² in the lower
+// tail, where Φ is small and relative accuracy is what matters. normalCDF
+// corrects for the rounding to first order. normalQuantile refines a
+// rational approximation with a single step of Halley's method, which
+// triples its number of correct digits.
+//
+// For Float and Double, the batched normalCDF is evaluated by a kernel from
+// _NumericsShims, and the batched normalQuantile is built from the batched
+// log, exp, erf and normalCDF, one block at a time.
+
+extension Real where Self: BinaryFloatingPoint {
+  /// The cumulative distribution function of the standard normal
+  /// distribution, Φ(x) = erfc(-x/√2)/2.
+  ///
+  /// This is the probability that a normally distributed value with mean
+  /// zero and standard deviation one is at most `x`. It has small relative
+  /// error wherever erfc does, including far into the lower tail, where it
+  /// underflows only for x below about -38 for Double (-14 for Float).
+  @inlinable
+  public static func normalCDF(_ x: Self) -> Self {
+    guard x.isFinite else { return x.isNaN ? x : x < 0 ? 0 : 1 }
+    // z + d = -x/√2 to about twice working precision, with √½ = c + cTail.
+    let c = _sqrtHalf
+    let cc = Augmented.twoProdFMA(c, c)
+    let cTail = ((1/2 - cc.head) - cc.tail) / (2*c)
+    let (z, e) = Augmented.twoProdFMA(-x, c)
+    let d = _mulAdd(-x, cTail, e)
+    // erfc(z + d) ≈ erfc(z) - d·2exp(-z²)/√π.
+    let twoOverSqrtPi: Self = 1.1283791670955125738961589031215451717
+    return (Self.erfc(z) - twoOverSqrtPi * d * Self.exp(-z*z)) / 2
+  }
+
+  /// The quantile function of the standard normal distribution, Φ⁻¹(p).
+  ///
+  /// This is the inverse of `normalCDF`: the value `x` such that a normally
+  /// distributed value with mean zero and standard deviation one is at
+  /// most `x` with probability `p`. It has small relative error throughout
+  /// (0, 1), including far into both tails. (For `p` less than
+  /// `leastNormalMagnitude`, the relative error is about 1e-9.)
+  ///
+  /// Edge cases:
+  /// - The quantile of zero is `-infinity`, and of one is `infinity`.
+  /// - The quantile of nan, or of a value outside [0, 1], is nan.
+  @inlinable
+  public static func normalQuantile(_ p: Self) -> Self {
+    guard p > 0 && p < 1 else {
+      return p == 0 ? -.infinity : p == 1 ? .infinity : .nan
+    }
+    // Φ⁻¹(1 - q) = -Φ⁻¹(q), and 1 - p is exact for p > 1/2.
+    let q = p > 1/2 ? 1 - p : p
+    let x = _normalQuantileEstimate(q, log: Self.log(q))
+    let e = q < .leastNormalMagnitude ? 0 :
+      4*q < 1 ? normalCDF(x) - q : Self.erf(x * _sqrtHalf)/2 - (q - 1/2)
+    let y = _normalQuantileStep(x, residual: e, exp: Self.exp(x*x/4))
+    return p > 1/2 ? -y : y
+  }
+
+  @usableFromInline @_transparent
+  internal static var _sqrtHalf: Self {
+    0.70710678118654752440084436210484903928
+  }
+
+  // Acklam's rational approximation of Φ⁻¹(q) for q in (0, 1/2], given
+  // log(q), with relative error less than 1.15e-9. Both branches are
+  // evaluated and one is selected, so that a loop over this vectorizes.
+  @inlinable
+  internal static func _normalQuantileEstimate(
+    _ q: Self, log logQ: Self
+  ) -> Self {
+    let t = (-2 * logQ).squareRoot()
+    var n: Self = -7.784894002430293e-03
+    n = n*t - 3.223964580411365e-01
+    n = n*t - 2.400758277161838e+00
+    n = n*t - 2.549732539343734e+00
+    n = n*t + 4.374664141464968e+00
+    n = n*t + 2.938163982698783e+00
+    var d: Self = 7.784695709041462e-03
+    d = d*t + 3.224671290700398e-01
+    d = d*t + 2.445134137142996e+00
+    d = d*t + 3.754408661907416e+00
+    d = d*t + 1
+    let tail = n / d
+    let r = q - 1/2
+    let s = r*r
+    var m: Self = -3.969683028665376e+01
+    m = m*s + 2.209460984245205e+02
+    m = m*s - 2.759285104469687e+02
+    m = m*s + 1.383577518672690e+02
+    m = m*s - 3.066479806614716e+01
+    m = m*s + 2.506628277459239e+00
+    var e: Self = -5.447609879822406e+01
+    e = e*s + 1.615858368580409e+02
+    e = e*s - 1.556989798598866e+02
+    e = e*s + 6.680131188771972e+01
+    e = e*s - 1.328068155288572e+01
+    e = e*s + 1
+    let central = m * r / e
+    return q < 0.02425 ? tail : central
+  }
+
+  // One step of Halley's method for Φ(x) = q, given the residual
+  // e = Φ(x) - q and h = exp(x²/4).
+  //
+  // The residual is computed from Φ(x) in the tail, and from
+  // erf(x/√2)/2 = Φ(x) - 1/2 near the median, where it is much more
+  // accurate. Where Φ(x) is subnormal it is too coarse to be of any use,
+  // so the residual is taken to be zero, and the estimate is returned as
+  // is. e/φ(x) = e·exp(x²/2)·√(2π) is evaluated as (e·h)·h, which does
+  // not overflow even though exp(x²/2) does in the far tail.
+  @inlinable
+  internal static func _normalQuantileStep(
+    _ x: Self, residual e: Self, exp h: Self
+  ) -> Self {
+    let sqrtTwoPi: Self = 2.5066282746310005024157652848110452530
+    let u = e * h * h * sqrtTwoPi
+    return x - u / (1 + x*u/2)
+  }
+
+  /// Computes `normalCDF()` of each element of `x`, storing the results
+  /// to `result`.
+  @inlinable
+  public static func normalCDF(
+    _ x: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(x, into: result) { Self.normalCDF($0) }
+  }
+
+  /// Replaces each element of `x` with `normalCDF()` of that element.
+  @inlinable
+  public static func normalCDF(_ x: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(x), into: x) { Self.normalCDF($0) }
+  }
+
+  /// Computes `normalQuantile()` of each element of `p`, storing the
+  /// results to `result`.
+  @inlinable
+  public static func normalQuantile(
+    _ p: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>
+  ) {
+    _map(p, into: result) { Self.normalQuantile($0) }
+  }
+
+  /// Replaces each element of `p` with `normalQuantile()` of that element.
+  @inlinable
+  public static func normalQuantile(_ p: UnsafeMutableBufferPointer<Self>) {
+    _map(UnsafeBufferPointer(p), into: p) { Self.normalQuantile($0) }
+  }
+
+  // normalQuantile of each element of p, with the batched functions passed
+  // in. This is the scalar algorithm, split into passes over blocks of
+  // elements, so that each function is evaluated by a batched kernel. The
+  // input is copied first, so result may be the same buffer as p.
+  @inlinable
+  internal static func _normalQuantile(
+    _ p: UnsafeBufferPointer<Self>,
+    into result: UnsafeMutableBufferPointer<Self>,
+    log: (UnsafeMutableBufferPointer<Self>) -> Void,
+    exp: (UnsafeMutableBufferPointer<Self>) -> Void,
+    erf: (UnsafeMutableBufferPointer<Self>) -> Void,
+    cdf: (UnsafeMutableBufferPointer<Self>) -> Void
+  ) {
+    precondition(p.count == result.count,
+      "result must have the same count as p.")
+    let blockSize = 256
+    let storage = UnsafeMutableBufferPointer<Self>.allocate(
+      capacity: 5 * min(blockSize, p.count)
+    )
+    defer { storage.deallocate() }
+    var start = 0
+    while start < p.count {
+      let n = min(blockSize, p.count - start)
+      let pb = UnsafeMutableBufferPointer(rebasing: storage[0 ..< n])
+      let q = UnsafeMutableBufferPointer(rebasing: storage[n ..< 2*n])
+      let a = UnsafeMutableBufferPointer(rebasing: storage[2*n ..< 3*n])
+      let b = UnsafeMutableBufferPointer(rebasing: storage[3*n ..< 4*n])
+      let c = UnsafeMutableBufferPointer(rebasing: storage[4*n ..< 5*n])
+      // Elements outside (0, 1) get q = 1/2 here, which is harmless, and
+      // are fixed up at the end of the block.
+      for j in 0 ..< n {
+        let pj = p[start + j]
+        pb[j] = pj
+        let qj = pj > 1/2 ? 1 - pj : pj
+        q[j] = qj > 0 ? qj : 1/2
+        a[j] = q[j]
+      }
+      log(a)
+      for j in 0 ..< n {
+        let x = _normalQuantileEstimate(q[j], log: a[j])
+        result[start + j] = x
+        a[j] = x
+        b[j] = x * _sqrtHalf
+        c[j] = x*x/4
+      }
+      cdf(a)
+      erf(b)
+      exp(c)
+      for j in 0 ..< n {
+        let x = result[start + j]
+        let e = q[j] < .leastNormalMagnitude ? 0 :
+          4*q[j] < 1 ? a[j] - q[j] : b[j]/2 - (q[j] - 1/2)
+        let y = _normalQuantileStep(x, residual: e, exp: c[j])
+        result[start + j] = pb[j] > 1/2 ? -y : y
+      }
+      for j in 0 ..< n where !(pb[j] > 0 && pb[j] < 1) {
+        result[start + j] = normalQuantile(pb[j])
+      }
+      start += n
+    }
+  }
+}
+
+extension Float {
+  @_transparent
+  public static func normalCDF(
+    _ x: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_normal_cdff(x.baseAddress, result.baseAddress, x.count)
+  }
+
+  @_transparent
+  public static func normalCDF(_ x: UnsafeMutableBufferPointer<Float>) {
+    _numerics_batch_normal_cdff(x.baseAddress, x.baseAddress, x.count)
+  }
+
+  @inlinable
+  public static func normalQuantile(
+    _ p: UnsafeBufferPointer<Float>,
+    into result: UnsafeMutableBufferPointer<Float>
+  ) {
+    _normalQuantile(p, into: result,
+      log: { Float.log($0) }, exp: { Float.exp($0) },
+      erf: { Float.erf($0) }, cdf: { Float.normalCDF($0) })
+  }
+
+  @inlinable
+  public static func normalQuantile(_ p: UnsafeMutableBufferPointer<Float>) {
+    normalQuantile(UnsafeBufferPointer(p), into: p)
+  }
+}
+
+extension Double {
+  @_transparent
+  public static func normalCDF(
+    _ x: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    _numerics_batch_normal_cdf(x.baseAddress, result.baseAddress, x.count)
+  }
+
+  @_transparent
+  public static func normalCDF(_ x: UnsafeMutableBufferPointer<Double>) {
+    _numerics_batch_normal_cdf(x.baseAddress, x.baseAddress, x.count)
+  }
+
+  @inlinable
+  public static func normalQuantile(
+    _ p: UnsafeBufferPointer<Double>,
+    into result: UnsafeMutableBufferPointer<Double>
+  ) {
+    _normalQuantile(p, into: result,
+      log: { Double.log($0) }, exp: { Double.exp($0) },
+      erf: { Double.erf($0) }, cdf: { Double.normalCDF($0) })
+  }
+
+  @inlinable
+  public static func normalQuantile(_ p: UnsafeMutableBufferPointer<Double>) {
+    normalQuantile(UnsafeBufferPointer(p), into: p)
+  }
+}
+
+#if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+@available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *)
+extension Float16 {
+  @_transparent
+  public static func normalCDF(
+    _ x: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(x, into: result) { Float.normalCDF($0) }
+  }
+
+  @_transparent
+  public static func normalCDF(_ x: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(x), into: x) { Float.normalCDF($0) }
+  }
+
+  @_transparent
+  public static func normalQuantile(
+    _ p: UnsafeBufferPointer<Float16>,
+    into result: UnsafeMutableBufferPointer<Float16>
+  ) {
+    _widened(p, into: result) { Float.normalQuantile($0) }
+  }
+
+  @_transparent
+  public static func normalQuantile(_ p: UnsafeMutableBufferPointer<Float16>) {
+    _widened(UnsafeBufferPointer(p), into: p) { Float.normalQuantile($0) }
+  }
+}
+#endif
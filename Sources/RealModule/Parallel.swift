@@ -0,0 +1,236 @@
+//===--- Parallel.swift ---------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+#if canImport(Dispatch)
+import Dispatch
+
+/// Drivers that run the batched functions and reductions on several cores.
+///
+/// Buffers are split into chunks of `chunkSize` consecutive elements (by
+/// default, see `defaultChunkSize(for:)`), which are processed with
+/// `DispatchQueue.concurrentPerform`. That balances the chunks over the
+/// available cores, with threads that finish early taking the remaining
+/// chunks.
+///
+/// The reductions are deterministic. The chunks depend only on the count
+/// and `chunkSize`, never on the number of threads or on how they are
+/// scheduled; each chunk is reduced serially, and the partial results are
+/// combined in chunk order. For a given input, method and chunk size, the
+/// result is therefore the same on every run, however many cores there
+/// are. It is generally not the same as the result of the serial reduction,
+/// which combines its terms in a different order; with `.doubleDouble`,
+/// both are about as accurate as a sum computed in twice the precision, so
+/// they rarely differ.
+///
+/// Parallelism only pays off for buffers of many chunks; smaller buffers
+/// are processed on the calling thread.
+public enum Parallel { }
+
+extension Parallel {
+  /// The default number of elements per chunk for buffers of `T`.
+  ///
+  /// This is 64 KiB of each buffer, small enough that a chunk of input and
+  /// output stays in the L2 cache of the core processing it, and large
+  /// enough that dispatching it costs little in comparison. It depends only
+  /// on the size of `T`, so reductions with the default chunk size give the
+  /// same result on every machine.
+  @inlinable
+  public static func defaultChunkSize<T>(for type: T.Type) -> Int {
+    max(1024, (1 << 16) / MemoryLayout<T>.stride)
+  }
+
+  /// Calls `body` once for each chunk of `0 ..< count`, in parallel.
+  ///
+  /// The chunks are the ranges `k*chunkSize ..< (k+1)*chunkSize`, with the
+  /// last one truncated at `count`. `body` may be called concurrently from
+  /// several threads, in any order.
+  @inlinable
+  public static func forEachChunk(
+    count: Int,
+    chunkSize: Int,
+    _ body: (Range<Int>) -> Void
+  ) {
+    precondition(count >= 0, "count must not be negative.")
+    precondition(chunkSize > 0, "chunkSize must be positive.")
+    if count <= chunkSize {
+      if count > 0 { body(0 ..< count) }
+      return
+    }
+    let chunks = (count - 1) / chunkSize + 1
+    DispatchQueue.concurrentPerform(iterations: chunks) { k in
+      let start = k * chunkSize
+      body(start ..< min(start + chunkSize, count))
+    }
+  }
+
+  /// Applies `function` to corresponding chunks of `x` and `result`, in
+  /// parallel.
+  ///
+  /// `function` is usually one of the batched functions, for example:
+  /// ```
+  /// Parallel.apply(Double.exp(_:into:), to: x, into: y)
+  /// ```
+  /// Because each chunk is processed independently, the results are exactly
+  /// those of `function(x, result)`. As for the batched functions, `result`
+  /// may be the same buffer as `x`.
+  @inlinable
+  public static func apply<T>(
+    _ function: (UnsafeBufferPointer<T>, UnsafeMutableBufferPointer<T>) -> Void,
+    to x: UnsafeBufferPointer<T>,
+    into result: UnsafeMutableBufferPointer<T>,
+    chunkSize: Int? = nil
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    let chunkSize = chunkSize ?? defaultChunkSize(for: T.self)
+    forEachChunk(count: x.count, chunkSize: chunkSize) { range in
+      function(UnsafeBufferPointer(rebasing: x[range]),
+               UnsafeMutableBufferPointer(rebasing: result[range]))
+    }
+  }
+
+  /// Applies `function` to each chunk of `x` in place, in parallel.
+  ///
+  /// See `apply(_:to:into:chunkSize:)` for details.
+  @inlinable
+  public static func apply<T>(
+    _ function: (UnsafeMutableBufferPointer<T>) -> Void,
+    to x: UnsafeMutableBufferPointer<T>,
+    chunkSize: Int? = nil
+  ) {
+    let chunkSize = chunkSize ?? defaultChunkSize(for: T.self)
+    forEachChunk(count: x.count, chunkSize: chunkSize) { range in
+      function(UnsafeMutableBufferPointer(rebasing: x[range]))
+    }
+  }
+}
+
+// MARK: - Reductions
+extension Parallel {
+  /// The sum of the elements of `x`, computed in parallel.
+  ///
+  /// See `Real.sum(_:method:)` for the methods, and `Parallel` for how the
+  /// result depends on `chunkSize`.
+  @inlinable
+  public static func sum<T: Real>(
+    _ x: UnsafeBufferPointer<T>,
+    method: SummationMethod = .pairwise,
+    chunkSize: Int? = nil
+  ) -> T {
+    let chunkSize = chunkSize ?? defaultChunkSize(for: T.self)
+    return _parallelSum(_SumTerms(x), method: method, chunkSize: chunkSize).0
+  }
+
+  /// The sum of the products of corresponding elements of `x` and `y`,
+  /// computed in parallel.
+  @inlinable
+  public static func dot<T: Real>(
+    _ x: UnsafeBufferPointer<T>,
+    _ y: UnsafeBufferPointer<T>,
+    method: SummationMethod = .pairwise,
+    chunkSize: Int? = nil
+  ) -> T {
+    precondition(x.count == y.count, "x and y must have the same count.")
+    let chunkSize = chunkSize ?? defaultChunkSize(for: T.self)
+    return _parallelSum(_DotTerms(x, y), method: method, chunkSize: chunkSize).0
+  }
+
+  /// The sum of the squares of the elements of `x`, computed in parallel.
+  @inlinable
+  public static func sum<T: Real>(
+    ofSquares x: UnsafeBufferPointer<T>,
+    method: SummationMethod = .pairwise,
+    chunkSize: Int? = nil
+  ) -> T {
+    let chunkSize = chunkSize ?? defaultChunkSize(for: T.self)
+    return _parallelSum(_SquareTerms(x), method: method, chunkSize: chunkSize).0
+  }
+}
+
+/// Sums `terms` with the specified method, reducing chunks of `chunkSize`
+/// terms in parallel, and returns the values of the two accumulators.
+///
+/// This is public only so that ComplexModule can use it.
+@inlinable
+public func _parallelSum<Terms>(
+  _ terms: Terms, method: SummationMethod, chunkSize: Int
+) -> (Terms.Value, Terms.Value) where Terms: _SummationTerms {
+  switch method {
+  case .naive:
+    return _parallelSumLanes(terms, chunkSize, _NaiveSum<Terms.Value>.self)
+  case .pairwise:
+    // The chunk sums are combined pairwise as well, so the error bound
+    // still grows only logarithmically.
+    let partials = _parallelPartials(terms, chunkSize) {
+      _sumPairwise(terms, $0)
+    }
+    return _combinePairwise(partials[...])
+  case .kahanBabuska:
+    return _parallelSumLanes(
+      terms, chunkSize, _KahanBabuskaSum<Terms.Value>.self
+    )
+  case .doubleDouble:
+    return _parallelSumLanes(
+      terms, chunkSize, _DoubleDoubleSum<Terms.Value>.self
+    )
+  }
+}
+
+// Accumulates each chunk with A, and merges the accumulators in order, so
+// that nothing is rounded until the end.
+@inlinable
+internal func _parallelSumLanes<Terms, A>(
+  _ terms: Terms, _ chunkSize: Int, _ type: A.Type
+) -> (Terms.Value, Terms.Value)
+where Terms: _SummationTerms, A: _SumAccumulator, A.Value == Terms.Value {
+  let partials = _parallelPartials(terms, chunkSize) {
+    _accumulateLanes(terms, $0, type)
+  }
+  var a = A(), b = A()
+  for p in partials {
+    a.merge(p.0)
+    b.merge(p.1)
+  }
+  return (a.value, b.value)
+}
+
+// The result of partial for each chunk of terms, in chunk order.
+@inlinable
+internal func _parallelPartials<Terms, P>(
+  _ terms: Terms, _ chunkSize: Int, _ partial: (Range<Int>) -> P
+) -> [P] where Terms: _SummationTerms {
+  precondition(chunkSize > 0, "chunkSize must be positive.")
+  let n = terms.count
+  let chunks = n == 0 ? 0 : (n - 1) / chunkSize + 1
+  return [P](unsafeUninitializedCapacity: chunks) { buffer, count in
+    Parallel.forEachChunk(count: n, chunkSize: chunkSize) { range in
+      let k = range.lowerBound / chunkSize
+      (buffer.baseAddress! + k).initialize(to: partial(range))
+    }
+    count = chunks
+  }
+}
+
+@inlinable
+internal func _combinePairwise<T: Real>(
+  _ partials: ArraySlice<(T, T)>
+) -> (T, T) {
+  switch partials.count {
+  case 0: return (0, 0)
+  case 1: return partials.first!
+  default:
+    let mid = partials.startIndex + partials.count/2
+    let lower = _combinePairwise(partials[..<mid])
+    let upper = _combinePairwise(partials[mid...])
+    return (lower.0 + upper.0, lower.1 + upper.1)
+  }
+}
+#endif
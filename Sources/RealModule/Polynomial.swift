@@ -0,0 +1,203 @@
+//===--- Polynomial.swift -------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+/// The algorithm used to evaluate a polynomial with real coefficients.
+///
+/// - `horner` is Horner's rule: one multiply-add per coefficient, each of
+///   which depends on the one before. This is the cheapest method, and the
+///   usual choice when evaluating at many points, where the evaluations at
+///   different points run in parallel.
+///
+/// - `estrin` evaluates blocks of eight coefficients with Estrin's scheme
+///   (as linear polynomials in x, combined with x² and x⁴), and combines
+///   the blocks with Horner's rule in x⁸. The blocks are independent, so
+///   their multiply-adds overlap; the chain of dependent operations is
+///   about a quarter as long as Horner's, which makes this faster for high
+///   degree polynomials evaluated at a single point. The error bound is
+///   similar to Horner's.
+///
+/// - `compensatedHorner` is Horner's rule in which the exact rounding error
+///   of every step is computed with `Augmented.twoProdFMA` and
+///   `Augmented.twoSum`, and evaluated by a second recurrence. The result
+///   is about as accurate as if Horner's rule had been computed with twice
+///   the precision and then rounded, which matters near the roots of the
+///   polynomial, where the other methods may lose all accuracy. It is
+///   several times slower.
+public enum PolynomialEvaluationMethod {
+  case horner
+  case estrin
+  case compensatedHorner
+}
+
+/// A polynomial c[0] + c[1]x + c[2]x² + ... with coefficients in a field.
+public struct Polynomial<Coefficient> where Coefficient: AlgebraicField {
+  /// The coefficients, starting with the constant term.
+  public var coefficients: [Coefficient]
+
+  /// The polynomial with the given coefficients, starting with the constant
+  /// term.
+  @inlinable
+  public init(coefficients: [Coefficient]) {
+    self.coefficients = coefficients
+  }
+
+  /// The value of the polynomial at `x`, by Horner's rule.
+  @inlinable
+  public func evaluate(at x: Coefficient) -> Coefficient {
+    var p = Coefficient.zero
+    for c in coefficients.reversed() { p = p*x + c }
+    return p
+  }
+}
+
+extension Polynomial: ExpressibleByArrayLiteral {
+  @inlinable
+  public init(arrayLiteral coefficients: Coefficient...) {
+    self.init(coefficients: coefficients)
+  }
+}
+
+extension Polynomial: Equatable { }
+
+// MARK: - Real coefficients
+extension Polynomial where Coefficient: Real {
+  /// The value of the polynomial at `x`, by Horner's rule using fused
+  /// multiply-adds where they are fast.
+  @inlinable
+  public func evaluate(at x: Coefficient) -> Coefficient {
+    evaluate(at: x, method: .horner)
+  }
+
+  /// The value of the polynomial at `x`, evaluated with `method`.
+  @inlinable
+  public func evaluate(
+    at x: Coefficient,
+    method: PolynomialEvaluationMethod
+  ) -> Coefficient {
+    coefficients.withUnsafeBufferPointer { c in
+      switch method {
+      case .horner: return Coefficient._horner(c, x)
+      case .estrin: return Coefficient._estrin(c, x)
+      case .compensatedHorner: return Coefficient._compensatedHorner(c, x)
+      }
+    }
+  }
+
+  /// Evaluates the polynomial at each element of `x`, storing the results
+  /// to `result`.
+  ///
+  /// `result` may be the same buffer as `x`. With `.horner`, the recurrence
+  /// runs over blocks of points at once, so it vectorizes; the results are
+  /// exactly those of `evaluate(at:method: .horner)`.
+  @inlinable
+  public func evaluate(
+    at x: UnsafeBufferPointer<Coefficient>,
+    into result: UnsafeMutableBufferPointer<Coefficient>,
+    method: PolynomialEvaluationMethod = .horner
+  ) {
+    precondition(x.count == result.count,
+      "result must have the same count as x.")
+    guard method == .horner else {
+      for i in x.indices { result[i] = evaluate(at: x[i], method: method) }
+      return
+    }
+    coefficients.withUnsafeBufferPointer { c in
+      guard let last = c.last else {
+        for i in result.indices { result[i] = 0 }
+        return
+      }
+      // The points of each block are copied first, so that result can be
+      // used as the accumulator even when it is x.
+      let blockSize = 256
+      let points = UnsafeMutableBufferPointer<Coefficient>.allocate(
+        capacity: Swift.min(blockSize, x.count)
+      )
+      defer { points.deallocate() }
+      var start = 0
+      while start < x.count {
+        let n = Swift.min(blockSize, x.count - start)
+        for i in 0 ..< n { points[i] = x[start + i] }
+        for i in 0 ..< n { result[start + i] = last }
+        for k in (0 ..< c.count - 1).reversed() {
+          let ck = c[k]
+          for i in 0 ..< n {
+            result[start + i] = Coefficient._mulAdd(result[start + i], points[i], ck)
+          }
+        }
+        start += n
+      }
+    }
+  }
+
+  /// Replaces each element of `x` with the value of the polynomial at that
+  /// element.
+  ///
+  /// See `evaluate(at:into:method:)` for details.
+  @inlinable
+  public func evaluate(
+    at x: UnsafeMutableBufferPointer<Coefficient>,
+    method: PolynomialEvaluationMethod = .horner
+  ) {
+    evaluate(at: UnsafeBufferPointer(x), into: x, method: method)
+  }
+}
+
+extension Real {
+  @inlinable
+  internal static func _horner(_ c: UnsafeBufferPointer<Self>, _ x: Self) -> Self {
+    guard var p = c.last else { return 0 }
+    for k in (0 ..< c.count - 1).reversed() { p = _mulAdd(p, x, c[k]) }
+    return p
+  }
+
+  @inlinable
+  internal static func _estrin(_ c: UnsafeBufferPointer<Self>, _ x: Self) -> Self {
+    if c.count <= 4 { return _horner(c, x) }
+    let x2 = x*x
+    let x4 = x2*x2
+    let x8 = x4*x4
+    // Coefficients past the end of c read as zero in the top block.
+    @inline(__always)
+    func coefficient(_ i: Int) -> Self { i < c.count ? c[i] : 0 }
+    @inline(__always)
+    func block(_ i: Int) -> Self {
+      let a = _mulAdd(coefficient(i + 1), x, coefficient(i))
+      let b = _mulAdd(coefficient(i + 3), x, coefficient(i + 2))
+      let d = _mulAdd(coefficient(i + 5), x, coefficient(i + 4))
+      let e = _mulAdd(coefficient(i + 7), x, coefficient(i + 6))
+      return _mulAdd(_mulAdd(e, x2, d), x4, _mulAdd(b, x2, a))
+    }
+    var i = (c.count - 1) / 8 * 8
+    var p = block(i)
+    while i > 0 {
+      i -= 8
+      p = _mulAdd(p, x8, block(i))
+    }
+    return p
+  }
+
+  @inlinable
+  internal static func _compensatedHorner(
+    _ c: UnsafeBufferPointer<Self>, _ x: Self
+  ) -> Self {
+    guard var s = c.last else { return 0 }
+    var e: Self = 0
+    for k in (0 ..< c.count - 1).reversed() {
+      // s*x + c[k] = t + π + σ exactly, and t is the new s.
+      let (p, π) = Augmented.twoProdFMA(s, x)
+      let (t, σ) = Augmented.twoSum(p, c[k])
+      s = t
+      // The errors are propagated by the same recurrence.
+      e = _mulAdd(e, x, π + σ)
+    }
+    return s + e
+  }
+}
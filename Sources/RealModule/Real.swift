@@ -53,7 +53,54 @@ extension Real {
     return -2*sinxOver2*sinxOver2
   }
   
+  /// cos(x) - 1, given the sine and cosine of x, as computed by `sincos`.
+  ///
+  /// This has the same accuracy as `cosMinusOne(x)`, but requires no
+  /// further evaluation of a trigonometric function, so callers that need
+  /// sin(x), cos(x) and cos(x) - 1 pay for a single argument reduction.
+  ///
+  /// See also:
+  /// -
+  /// - `cosMinusOne()`
+  /// - `sincos()`
+  @_transparent
+  public static func cosMinusOne(sin s: Self, cos c: Self) -> Self {
+    // cos(x) - 1 = -sin²(x)/(1 + cos(x)) has no cancellation when
+    // cos(x) >= 0, and when cos(x) < 0, c - 1 has none either.
+    c >= 0 ? -s*s/(1 + c) : c - 1
+  }
+  
+  // Most math libraries do not provide sincos, so by default it is simply
+  // the two separate functions.
+  @_transparent
+  public static func sincos(_ x: Self) -> (sin: Self, cos: Self) {
+    (sin(x), cos(x))
+  }
+  
+  // No math library provides sinhcosh; it is computed from a single
+  // expMinusOne.
+  @inlinable
+  @_specialize(where Self == Float)
+  @_specialize(where Self == Double)
+  public static func sinhcosh(_ x: Self) -> (sinh: Self, cosh: Self) {
+    // With e = expMinusOne(|x|) and r = e/(1 + e) = 1 - exp(-|x|):
+    //
+    //   sinh(|x|) = (exp(|x|) - exp(-|x|))/2 = (e + r)/2
+    //   cosh(|x|) = (exp(|x|) + exp(-|x|))/2 = 1 + e*r/2
+    //
+    // Neither sum cancels. If e overflows, cosh(x) may still be finite,
+    // so defer to the separate functions.
+    let e = expMinusOne(x.magnitude)
+    guard e.isFinite else { return (sinh(x), cosh(x)) }
+    let r = e/(1 + e)
+    return (Self(signOf: x, magnitudeOf: (e + r)/2), 1 + e*r/2)
+  }
+  
   #if !os(Windows)
+  // Not inlinable, so the concrete types that use this default get it
+  // through these specializations.
+  @_specialize(where Self == Float)
+  @_specialize(where Self == Double)
   public static func signGamma(_ x: Self) -> FloatingPointSign {
     // Gamma is strictly positive for x >= 0.
     if x >= 0 { return .plus }
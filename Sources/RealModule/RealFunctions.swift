@@ -114,6 +114,31 @@ public protocol RealFunctions: ElementaryFunctions {
   static func signGamma(_ x: Self) -> FloatingPointSign
 #endif
   
+  /// The sine and cosine of `x`, computed together.
+  ///
+  /// This is equivalent to `(sin(x), cos(x))`, but is usually faster,
+  /// because the two functions share a single argument reduction.
+  ///
+  /// See also:
+  /// -
+  /// - `sinhcosh()`
+  /// - `ElementaryFunctions.cos()`
+  /// - `ElementaryFunctions.sin()`
+  static func sincos(_ x: Self) -> (sin: Self, cos: Self)
+  
+  /// The hyperbolic sine and cosine of `x`, computed together.
+  ///
+  /// This is equivalent to `(sinh(x), cosh(x))`, with an error of at most
+  /// a few ulps, but is usually faster, because only a single exponential
+  /// is evaluated.
+  ///
+  /// See also:
+  /// -
+  /// - `sincos()`
+  /// - `ElementaryFunctions.cosh()`
+  /// - `ElementaryFunctions.sinh()`
+  static func sinhcosh(_ x: Self) -> (sinh: Self, cosh: Self)
+  
   /// a*b + c, computed _either_ with an FMA or with separate multiply and add.
   ///
   /// Whichever is faster should be chosen by the compiler statically.
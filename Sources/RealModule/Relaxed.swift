@@ -0,0 +1,55 @@
+//===--- Relaxed.swift ----------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+/// Relaxed-accuracy versions of operations whose default implementations
+/// go to some trouble to be robust.
+///
+/// The functions in this namespace trade edge-case behavior for speed:
+///
+/// - For well-scaled inputs, results have a relative error of at most a
+///   few ulps (the bound for each function is given in its documentation;
+///   for complex results it is normwise). This is usually slightly worse
+///   than the default implementations, which are built to be nearly
+///   correctly rounded.
+///
+/// - There are no guarantees for subnormal inputs or results, or where
+///   intermediate values overflow or underflow (for example, squared
+///   lengths of complex values larger than about the square root of
+///   `greatestFiniteMagnitude`). The results in those cases may be zero,
+///   infinite or nan.
+///
+/// - Multiplies and adds may or may not be contracted into fused
+///   multiply-adds, whichever is faster on the target (see `_mulAdd`), so
+///   results can differ between platforms in the last bit.
+///
+/// There is no rescaling, no slow path and no compensated arithmetic, so
+/// these functions are branch-free or nearly so, which also lets loops that
+/// call them vectorize. ComplexModule extends this namespace with relaxed
+/// complex arithmetic and elementary functions.
+public enum Relaxed { }
+
+extension Relaxed {
+  /// `a*b + c`, computed with or without a fused multiply-add, whichever
+  /// is faster.
+  @_transparent
+  public static func multiplyAdd<T: Real>(_ a: T, _ b: T, _ c: T) -> T {
+    T._mulAdd(a, b, c)
+  }
+
+  /// `sqrt(x*x + y*y)`, without the rescaling of `hypot`.
+  ///
+  /// The error is at most 1.5 ulps, unless `x*x + y*y` overflows or
+  /// underflows.
+  @_transparent
+  public static func hypot<T: Real>(_ x: T, _ y: T) -> T {
+    .sqrt(T._mulAdd(x, x, y*y))
+  }
+}
@@ -0,0 +1,184 @@
+//===--- SIMD+ElementaryFunctions.swift -----------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+// The standard library SIMD types conform to `ElementaryFunctions` when
+// their scalars are `Real`, with every function applied lanewise. This lets
+// generic code written against `ElementaryFunctions` run directly on vectors:
+//
+//   func softplus<T: ElementaryFunctions>(_ x: T) -> T {
+//     .log(onePlus: .exp(x))
+//   }
+//   let y = softplus(SIMD8<Float>(repeating: 1))
+//
+// When the scalar type is Float or Double, the functions that have batched
+// kernels (exp, expMinusOne, log, log(onePlus:), cos, sin and tanh) evaluate
+// all lanes with those kernels, so they have the accuracy documented in
+// BatchedFunctions.swift. sqrt uses the hardware lanewise square root. All
+// other functions, and all functions of other scalar types, are evaluated
+// one lane at a time with the scalar function.
+
+extension SIMD where Scalar: ElementaryFunctions {
+  @usableFromInline @_transparent
+  internal static func _lanewise(_ x: Self, _ f: (Scalar) -> Scalar) -> Self {
+    var result = Self()
+    for i in x.indices { result[i] = f(x[i]) }
+    return result
+  }
+
+  @usableFromInline @_transparent
+  internal static func _lanewise(
+    _ x: Self, _ y: Self, _ f: (Scalar, Scalar) -> Scalar
+  ) -> Self {
+    var result = Self()
+    for i in x.indices { result[i] = f(x[i], y[i]) }
+    return result
+  }
+
+  /// Evaluates all lanes of `x` with the Float or Double batched kernel when
+  /// `Scalar` is one of those types, falling back on `scalar` otherwise.
+  @usableFromInline @_transparent
+  internal static func _kernel(
+    _ x: Self,
+    float: (UnsafeMutableBufferPointer<Float>) -> Void,
+    double: (UnsafeMutableBufferPointer<Double>) -> Void,
+    scalar: (Scalar) -> Scalar
+  ) -> Self {
+    var result = x
+    let count = x.scalarCount
+    withUnsafeMutablePointer(to: &result) {
+      $0.withMemoryRebound(to: Scalar.self, capacity: count) {
+        Scalar._applyBatched(UnsafeMutableBufferPointer(start: $0, count: count),
+                             float: float, double: double, scalar: scalar)
+      }
+    }
+    return result
+  }
+}
+
+extension ElementaryFunctions
+where Self: SIMD, Scalar: ElementaryFunctions & FloatingPoint {
+  @_transparent
+  public static func exp(_ x: Self) -> Self {
+    _kernel(x, float: { Float.exp($0) }, double: { Double.exp($0) },
+            scalar: { Scalar.exp($0) })
+  }
+
+  @_transparent
+  public static func expMinusOne(_ x: Self) -> Self {
+    _kernel(x, float: { Float.expMinusOne($0) },
+            double: { Double.expMinusOne($0) },
+            scalar: { Scalar.expMinusOne($0) })
+  }
+
+  @_transparent
+  public static func cosh(_ x: Self) -> Self {
+    _lanewise(x) { Scalar.cosh($0) }
+  }
+
+  @_transparent
+  public static func sinh(_ x: Self) -> Self {
+    _lanewise(x) { Scalar.sinh($0) }
+  }
+
+  @_transparent
+  public static func tanh(_ x: Self) -> Self {
+    _kernel(x, float: { Float.tanh($0) }, double: { Double.tanh($0) },
+            scalar: { Scalar.tanh($0) })
+  }
+
+  @_transparent
+  public static func cos(_ x: Self) -> Self {
+    _kernel(x, float: { Float.cos($0) }, double: { Double.cos($0) },
+            scalar: { Scalar.cos($0) })
+  }
+
+  @_transparent
+  public static func sin(_ x: Self) -> Self {
+    _kernel(x, float: { Float.sin($0) }, double: { Double.sin($0) },
+            scalar: { Scalar.sin($0) })
+  }
+
+  @_transparent
+  public static func tan(_ x: Self) -> Self {
+    _lanewise(x) { Scalar.tan($0) }
+  }
+
+  @_transparent
+  public static func log(_ x: Self) -> Self {
+    _kernel(x, float: { Float.log($0) }, double: { Double.log($0) },
+            scalar: { Scalar.log($0) })
+  }
+
+  @_transparent
+  public static func log(onePlus x: Self) -> Self {
+    _kernel(x, float: { Float.log(onePlus: $0) },
+            double: { Double.log(onePlus: $0) },
+            scalar: { Scalar.log(onePlus: $0) })
+  }
+
+  @_transparent
+  public static func acosh(_ x: Self) -> Self {
+    _lanewise(x) { Scalar.acosh($0) }
+  }
+
+  @_transparent
+  public static func asinh(_ x: Self) -> Self {
+    _lanewise(x) { Scalar.asinh($0) }
+  }
+
+  @_transparent
+  public static func atanh(_ x: Self) -> Self {
+    _lanewise(x) { Scalar.atanh($0) }
+  }
+
+  @_transparent
+  public static func acos(_ x: Self) -> Self {
+    _lanewise(x) { Scalar.acos($0) }
+  }
+
+  @_transparent
+  public static func asin(_ x: Self) -> Self {
+    _lanewise(x) { Scalar.asin($0) }
+  }
+
+  @_transparent
+  public static func atan(_ x: Self) -> Self {
+    _lanewise(x) { Scalar.atan($0) }
+  }
+
+  @_transparent
+  public static func pow(_ x: Self, _ y: Self) -> Self {
+    _lanewise(x, y) { Scalar.pow($0, $1) }
+  }
+
+  @_transparent
+  public static func pow(_ x: Self, _ n: Int) -> Self {
+    _lanewise(x) { Scalar.pow($0, n) }
+  }
+
+  @_transparent
+  public static func sqrt(_ x: Self) -> Self {
+    x.squareRoot()
+  }
+
+  @_transparent
+  public static func root(_ x: Self, _ n: Int) -> Self {
+    _lanewise(x) { Scalar.root($0, n) }
+  }
+}
+
+extension SIMD2: ElementaryFunctions where Scalar: Real { }
+extension SIMD3: ElementaryFunctions where Scalar: Real { }
+extension SIMD4: ElementaryFunctions where Scalar: Real { }
+extension SIMD8: ElementaryFunctions where Scalar: Real { }
+extension SIMD16: ElementaryFunctions where Scalar: Real { }
+extension SIMD32: ElementaryFunctions where Scalar: Real { }
+extension SIMD64: ElementaryFunctions where Scalar: Real { }
@@ -0,0 +1,391 @@
+//===--- Summation.swift --------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+/// The algorithm used to accumulate a sum.
+///
+/// In order of increasing accuracy and cost:
+///
+/// - `naive` adds the terms in sequence (into several independent partial
+///   sums, so that it is not limited by the latency of addition). The error
+///   bound grows linearly with the number of terms.
+///
+/// - `pairwise` sums short blocks naively, and then combines the block sums
+///   pairwise. The error bound grows only logarithmically with the number
+///   of terms, and it is nearly as fast as `naive`.
+///
+/// - `kahanBabuska` is Neumaier's improvement of Kahan's compensated
+///   summation: the rounding error of every addition is accumulated
+///   separately and added back at the end. To first order, the error bound
+///   does not depend on the number of terms.
+///
+/// - `doubleDouble` accumulates the sum as an unevaluated pair of values
+///   using `Augmented.twoSum`, so that the result is about as accurate as if
+///   the sum had been computed with twice the precision and then rounded.
+///
+/// For dot products and sums of squares, the compensated methods also
+/// compute each product exactly with `Augmented.twoProdFMA`.
+///
+/// Whatever the method, a sum with an infinite term, or one that overflows,
+/// is infinite (or nan, if infinities of opposite sign meet), just as it
+/// would be for naive summation.
+public enum SummationMethod {
+  case naive
+  case pairwise
+  case kahanBabuska
+  case doubleDouble
+}
+
+// MARK: - Sums, dot products and sums of squares
+extension Real {
+  /// The sum of the elements of `x`.
+  @inlinable
+  public static func sum(
+    _ x: UnsafeBufferPointer<Self>,
+    method: SummationMethod = .pairwise
+  ) -> Self {
+    _sum(_SumTerms(x), method: method).0
+  }
+
+  /// The sum of the elements of `x`.
+  @inlinable
+  public static func sum<S>(
+    _ x: S,
+    method: SummationMethod = .pairwise
+  ) -> Self where S: Sequence, S.Element == Self {
+    _withBuffer(x) { sum($0, method: method) }
+  }
+
+  /// The sum of the products of corresponding elements of `x` and `y`.
+  @inlinable
+  public static func dot(
+    _ x: UnsafeBufferPointer<Self>,
+    _ y: UnsafeBufferPointer<Self>,
+    method: SummationMethod = .pairwise
+  ) -> Self {
+    precondition(x.count == y.count, "x and y must have the same count.")
+    return _sum(_DotTerms(x, y), method: method).0
+  }
+
+  /// The sum of the products of corresponding elements of `x` and `y`.
+  @inlinable
+  public static func dot<S, T>(
+    _ x: S,
+    _ y: T,
+    method: SummationMethod = .pairwise
+  ) -> Self
+  where S: Sequence, S.Element == Self, T: Sequence, T.Element == Self {
+    _withBuffer(x) { x in _withBuffer(y) { y in dot(x, y, method: method) } }
+  }
+
+  /// The sum of the squares of the elements of `x`.
+  @inlinable
+  public static func sum(
+    ofSquares x: UnsafeBufferPointer<Self>,
+    method: SummationMethod = .pairwise
+  ) -> Self {
+    _sum(_SquareTerms(x), method: method).0
+  }
+
+  /// The sum of the squares of the elements of `x`.
+  @inlinable
+  public static func sum<S>(
+    ofSquares x: S,
+    method: SummationMethod = .pairwise
+  ) -> Self where S: Sequence, S.Element == Self {
+    _withBuffer(x) { sum(ofSquares: $0, method: method) }
+  }
+}
+
+/// Calls `body` with the contiguous storage of `x`, copying `x` to an array
+/// first if it has none.
+@inlinable
+public func _withBuffer<S, Result>(
+  _ x: S, _ body: (UnsafeBufferPointer<S.Element>) -> Result
+) -> Result where S: Sequence {
+  if let result = x.withContiguousStorageIfAvailable(body) { return result }
+  return Array(x).withUnsafeBufferPointer(body)
+}
+
+// MARK: - Implementation
+//
+// The reductions are written in terms of two protocols: a _SumAccumulator
+// implements one of the summation methods for a single real sum, and
+// _SummationTerms describes the terms to be added. Each term is added to a
+// pair of accumulators, so that complex reductions (in ComplexModule) can
+// accumulate real and imaginary parts in a single pass; real reductions
+// simply leave the second accumulator unused.
+//
+// These are public only so that ComplexModule can use them.
+
+/// An accumulator for one of the summation methods.
+public protocol _SumAccumulator {
+  associatedtype Value: Real
+  init()
+  /// Adds x to the sum.
+  mutating func add(_ x: Value)
+  /// Adds a*b to the sum.
+  mutating func addProduct(_ a: Value, _ b: Value)
+  /// Adds the sum accumulated by other to this sum.
+  mutating func merge(_ other: Self)
+  /// The value of the sum.
+  var value: Value { get }
+}
+
+/// The terms of a sum.
+public protocol _SummationTerms {
+  associatedtype Value: Real
+  var count: Int { get }
+  /// Adds term i to the accumulators.
+  func add<A>(_ i: Int, to a: inout A, _ b: inout A)
+  where A: _SumAccumulator, A.Value == Value
+}
+
+@frozen
+public struct _NaiveSum<Value>: _SumAccumulator where Value: Real {
+  @usableFromInline
+  internal var s: Value
+
+  @_transparent
+  public init() { s = 0 }
+
+  @_transparent
+  public mutating func add(_ x: Value) { s += x }
+
+  @_transparent
+  public mutating func addProduct(_ a: Value, _ b: Value) {
+    s = Value._mulAdd(a, b, s)
+  }
+
+  @_transparent
+  public mutating func merge(_ other: Self) { s += other.s }
+
+  @_transparent
+  public var value: Value { s }
+}
+
+@frozen
+public struct _KahanBabuskaSum<Value>: _SumAccumulator where Value: Real {
+  @usableFromInline
+  internal var s: Value
+
+  @usableFromInline
+  internal var c: Value
+
+  @_transparent
+  public init() { s = 0; c = 0 }
+
+  @_transparent
+  public mutating func add(_ x: Value) {
+    // Written as a select rather than a branch, so that it vectorizes.
+    let (a, b) = s.magnitude >= x.magnitude ? (s, x) : (x, s)
+    let t = Augmented.fastTwoSum(a, b)
+    s = t.head
+    c += t.tail
+  }
+
+  @_transparent
+  public mutating func addProduct(_ a: Value, _ b: Value) {
+    let p = Augmented.twoProdFMA(a, b)
+    add(p.head)
+    c += p.tail
+  }
+
+  @_transparent
+  public mutating func merge(_ other: Self) {
+    add(other.s)
+    c += other.c
+  }
+
+  // Once s is infinite, the tails are nan (∞ - ∞), but s itself is still
+  // the IEEE 754 sum of the terms, so it is the result.
+  @_transparent
+  public var value: Value { s.isFinite ? s + c : s }
+}
+
+@frozen
+public struct _DoubleDoubleSum<Value>: _SumAccumulator where Value: Real {
+  @usableFromInline
+  internal var hi: Value
+
+  @usableFromInline
+  internal var lo: Value
+
+  @_transparent
+  public init() { hi = 0; lo = 0 }
+
+  @_transparent
+  public mutating func add(_ x: Value) {
+    let t = Augmented.twoSum(hi, x)
+    _renormalize(t.head, t.tail + lo)
+  }
+
+  @_transparent
+  public mutating func addProduct(_ a: Value, _ b: Value) {
+    let p = Augmented.twoProdFMA(a, b)
+    let t = Augmented.twoSum(hi, p.head)
+    _renormalize(t.head, t.tail + (lo + p.tail))
+  }
+
+  @_transparent
+  public mutating func merge(_ other: Self) {
+    let t = Augmented.twoSum(hi, other.hi)
+    _renormalize(t.head, t.tail + (lo + other.lo))
+  }
+
+  // Sets (hi, lo) to head + tail, where tail is small compared to head.
+  // When head is infinite or nan, tail is nan (∞ - ∞), and folding it in
+  // would turn an overflowing or infinite sum into nan; such sums carry
+  // no compensation.
+  @usableFromInline @_transparent
+  internal mutating func _renormalize(_ head: Value, _ tail: Value) {
+    guard head.isFinite else { (hi, lo) = (head, 0); return }
+    (hi, lo) = Augmented.twoSum(head, tail)
+    if !hi.isFinite { lo = 0 }
+  }
+
+  @_transparent
+  public var value: Value { hi + lo }
+}
+
+@frozen
+public struct _SumTerms<Value>: _SummationTerms where Value: Real {
+  @usableFromInline
+  internal let x: UnsafeBufferPointer<Value>
+
+  @_transparent
+  public init(_ x: UnsafeBufferPointer<Value>) { self.x = x }
+
+  @_transparent
+  public var count: Int { x.count }
+
+  @_transparent
+  public func add<A>(_ i: Int, to a: inout A, _ b: inout A)
+  where A: _SumAccumulator, A.Value == Value {
+    a.add(x[i])
+  }
+}
+
+@frozen
+public struct _DotTerms<Value>: _SummationTerms where Value: Real {
+  @usableFromInline
+  internal let x: UnsafeBufferPointer<Value>
+
+  @usableFromInline
+  internal let y: UnsafeBufferPointer<Value>
+
+  @_transparent
+  public init(_ x: UnsafeBufferPointer<Value>, _ y: UnsafeBufferPointer<Value>) {
+    self.x = x
+    self.y = y
+  }
+
+  @_transparent
+  public var count: Int { x.count }
+
+  @_transparent
+  public func add<A>(_ i: Int, to a: inout A, _ b: inout A)
+  where A: _SumAccumulator, A.Value == Value {
+    a.addProduct(x[i], y[i])
+  }
+}
+
+@frozen
+public struct _SquareTerms<Value>: _SummationTerms where Value: Real {
+  @usableFromInline
+  internal let x: UnsafeBufferPointer<Value>
+
+  @_transparent
+  public init(_ x: UnsafeBufferPointer<Value>) { self.x = x }
+
+  @_transparent
+  public var count: Int { x.count }
+
+  @_transparent
+  public func add<A>(_ i: Int, to a: inout A, _ b: inout A)
+  where A: _SumAccumulator, A.Value == Value {
+    a.addProduct(x[i], x[i])
+  }
+}
+
+/// Sums `terms` with the specified method, returning the values of the two
+/// accumulators.
+@inlinable
+public func _sum<Terms>(
+  _ terms: Terms, method: SummationMethod
+) -> (Terms.Value, Terms.Value) where Terms: _SummationTerms {
+  let all = 0 ..< terms.count
+  switch method {
+  case .naive:
+    return _sumLanes(terms, all, _NaiveSum<Terms.Value>.self)
+  case .pairwise:
+    return _sumPairwise(terms, all)
+  case .kahanBabuska:
+    return _sumLanes(terms, all, _KahanBabuskaSum<Terms.Value>.self)
+  case .doubleDouble:
+    return _sumLanes(terms, all, _DoubleDoubleSum<Terms.Value>.self)
+  }
+}
+
+// Sums the terms in range using four independent pairs of accumulators,
+// so that consecutive additions do not depend on each other.
+@inlinable
+internal func _sumLanes<Terms, A>(
+  _ terms: Terms, _ range: Range<Int>, _ type: A.Type
+) -> (Terms.Value, Terms.Value)
+where Terms: _SummationTerms, A: _SumAccumulator, A.Value == Terms.Value {
+  let (a, b) = _accumulateLanes(terms, range, type)
+  return (a.value, b.value)
+}
+
+// The accumulators of _sumLanes, before they are rounded to values.
+@inlinable
+internal func _accumulateLanes<Terms, A>(
+  _ terms: Terms, _ range: Range<Int>, _: A.Type
+) -> (A, A)
+where Terms: _SummationTerms, A: _SumAccumulator, A.Value == Terms.Value {
+  var a0 = A(), b0 = A()
+  var a1 = A(), b1 = A()
+  var a2 = A(), b2 = A()
+  var a3 = A(), b3 = A()
+  var i = range.lowerBound
+  while i + 4 <= range.upperBound {
+    terms.add(i, to: &a0, &b0)
+    terms.add(i + 1, to: &a1, &b1)
+    terms.add(i + 2, to: &a2, &b2)
+    terms.add(i + 3, to: &a3, &b3)
+    i += 4
+  }
+  while i < range.upperBound {
+    terms.add(i, to: &a0, &b0)
+    i += 1
+  }
+  a0.merge(a1); a2.merge(a3); a0.merge(a2)
+  b0.merge(b1); b2.merge(b3); b0.merge(b2)
+  return (a0, b0)
+}
+
+// Sums blocks of up to 128 terms naively, and combines the block sums
+// pairwise.
+@inlinable
+internal func _sumPairwise<Terms>(
+  _ terms: Terms, _ range: Range<Int>
+) -> (Terms.Value, Terms.Value) where Terms: _SummationTerms {
+  if range.count <= 128 {
+    return _sumLanes(terms, range, _NaiveSum<Terms.Value>.self)
+  }
+  // Split at a multiple of the block size, so that every block but the
+  // last is full.
+  let half = (range.count/2 + 127) & ~127
+  let mid = range.lowerBound + half
+  let lower = _sumPairwise(terms, range.lowerBound ..< mid)
+  let upper = _sumPairwise(terms, mid ..< range.upperBound)
+  return (lower.0 + upper.0, lower.1 + upper.1)
+}
@@ -35,6 +35,18 @@ HEADER_SHIM float libm_sinf(float x) {
   return __builtin_sinf(x);
 }
 
+// sin and cos of the same argument, sharing the argument reduction. Darwin
+// and Windows have no sincos entry point with this signature; on Darwin the
+// compiler combines the separate calls into __sincosf_stret.
+HEADER_SHIM void libm_sincosf(float x, float *s, float *c) {
+#if defined(__APPLE__) || defined(_WIN32)
+  *s = __builtin_sinf(x);
+  *c = __builtin_cosf(x);
+#else
+  __builtin_sincosf(x, s, c);
+#endif
+}
+
 HEADER_SHIM float libm_tanf(float x) {
   return __builtin_tanf(x);
 }
@@ -160,6 +172,15 @@ HEADER_SHIM double libm_sin(double x) {
   return __builtin_sin(x);
 }
 
+HEADER_SHIM void libm_sincos(double x, double *s, double *c) {
+#if defined(__APPLE__) || defined(_WIN32)
+  *s = __builtin_sin(x);
+  *c = __builtin_cos(x);
+#else
+  __builtin_sincos(x, s, c);
+#endif
+}
+
 HEADER_SHIM double libm_tan(double x) {
   return __builtin_tan(x);
 }
@@ -280,6 +301,15 @@ HEADER_SHIM long double libm_sinl(long double x) {
   return __builtin_sinl(x);
 }
 
+HEADER_SHIM void libm_sincosl(long double x, long double *s, long double *c) {
+#if defined(__APPLE__)
+  *s = __builtin_sinl(x);
+  *c = __builtin_cosl(x);
+#else
+  __builtin_sincosl(x, s, c);
+#endif
+}
+
 HEADER_SHIM long double libm_tanl(long double x) {
   return __builtin_tanl(x);
 }
@@ -397,3 +427,761 @@ HEADER_SHIM double _numerics_muladd(double a, double b, double c) {
 
 // No long-double muladd operation, because no one has built an FMA for it
 // (except for Itanium, which Swift doesn't support).
+
+// MARK: - batched elementary function kernels
+//
+// These back the batched Float and Double elementary functions in
+// RealModule. Each kernel is a branch-free polynomial evaluation that is
+// valid on a "fast" domain covering nearly all inputs that matter in
+// practice; the batch drivers evaluate the kernel on every element, and then
+// make a second pass over only those elements that fell outside the fast
+// domain, recomputing them with the scalar libm function.
+//
+// We do not write any ISA-specific code here; the kernels are written so
+// that the loops in the drivers have no calls and no data-dependent control
+// flow, which allows the autovectorizer to target whatever vector extension
+// (SSE, AVX2, AVX-512, NEON, ...) the client module is compiled for.
+//
+// The Double kernels have a maximum observed error of about one ulp on the
+// fast domain (tanh is about two and a half). The Float kernels evaluate the
+// Double kernels internally, and so are very nearly correctly rounded.
+
+HEADER_SHIM unsigned long long _numerics_asuint64(double x) {
+  unsigned long long bits;
+  __builtin_memcpy(&bits, &x, sizeof bits);
+  return bits;
+}
+
+HEADER_SHIM double _numerics_asdouble(unsigned long long bits) {
+  double x;
+  __builtin_memcpy(&x, &bits, sizeof x);
+  return x;
+}
+
+/// exp(x), valid for |x| <= 708, where the result is normal and 2^k can be
+/// formed directly from its bit pattern.
+HEADER_SHIM double _numerics_exp_kernel(double x) {
+  // Round x/log(2) to the nearest integer k with the usual "add and subtract
+  // 1.5*2^52" trick; this leaves k in the low-order bits of t, which lets us
+  // recover 2^k with integer arithmetic only.
+  const double shift = 0x1.8p52;
+  const double t = x*0x1.71547652b82fep0 + shift;
+  const double k = t - shift;
+  // Cody-Waite reduction; k*ln2_hi is exact for any k we see here.
+  double r = x - k*0x1.62e42feep-1;
+  r = r - k*0x1.a39ef35793c76p-33;
+  // |r| <= log(2)/2; Taylor series of degree 13 is accurate to ~2^-57.
+  double p = 0x1.6124613a86d09p-33;           // 1/13!
+  p = p*r + 0x1.1eed8eff8d898p-29;            // 1/12!
+  p = p*r + 0x1.ae64567f544e4p-26;            // 1/11!
+  p = p*r + 0x1.27e4fb7789f5cp-22;            // 1/10!
+  p = p*r + 0x1.71de3a556c734p-19;            // 1/9!
+  p = p*r + 0x1.a01a01a01a01ap-16;            // 1/8!
+  p = p*r + 0x1.a01a01a01a01ap-13;            // 1/7!
+  p = p*r + 0x1.6c16c16c16c17p-10;            // 1/6!
+  p = p*r + 0x1.1111111111111p-7;             // 1/5!
+  p = p*r + 0x1.5555555555555p-5;             // 1/4!
+  p = p*r + 0x1.5555555555555p-3;             // 1/3!
+  p = p*r + 0.5;
+  p = 1 + (r + r*r*p);
+  const double scale = _numerics_asdouble((_numerics_asuint64(t) + 1023) << 52);
+  return p*scale;
+}
+
+/// exp(x) - 1, valid for |x| <= 708.
+HEADER_SHIM double _numerics_expm1_kernel(double x) {
+  // Same reduction as exp, except that we don't reduce at all when |x| is
+  // small; this avoids cancellation between 2^k and 1 in the reconstruction
+  // below, at the cost of a longer polynomial.
+  const double shift = 0x1.8p52;
+  double k = (x*0x1.71547652b82fep0 + shift) - shift;
+  k = __builtin_fabs(x) < 0.6875 ? 0 : k;
+  double r = x - k*0x1.62e42feep-1;
+  r = r - k*0x1.a39ef35793c76p-33;
+  // |r| <= 0.6875; Taylor series for exp(r) - 1 of degree 17.
+  double p = 0x1.952c77030ad4ap-49;           // 1/17!
+  p = p*r + 0x1.ae7f3e733b81fp-45;            // 1/16!
+  p = p*r + 0x1.ae7f3e733b81fp-41;            // 1/15!
+  p = p*r + 0x1.93974a8c07c9dp-37;            // 1/14!
+  p = p*r + 0x1.6124613a86d09p-33;            // 1/13!
+  p = p*r + 0x1.1eed8eff8d898p-29;            // 1/12!
+  p = p*r + 0x1.ae64567f544e4p-26;            // 1/11!
+  p = p*r + 0x1.27e4fb7789f5cp-22;            // 1/10!
+  p = p*r + 0x1.71de3a556c734p-19;            // 1/9!
+  p = p*r + 0x1.a01a01a01a01ap-16;            // 1/8!
+  p = p*r + 0x1.a01a01a01a01ap-13;            // 1/7!
+  p = p*r + 0x1.6c16c16c16c17p-10;            // 1/6!
+  p = p*r + 0x1.1111111111111p-7;             // 1/5!
+  p = p*r + 0x1.5555555555555p-5;             // 1/4!
+  p = p*r + 0x1.5555555555555p-3;             // 1/3!
+  // The leading terms r + r^2/2 are evaluated as an exact head-tail pair;
+  // the high half of r is found by Dekker's splitting so that its square
+  // is exact, and the sum is exact by Fast2Sum because |r| > r^2/2.
+  const double rs = r*0x1.0000002p27;
+  const double rh = rs - (rs - r);
+  const double rl = r - rh;
+  const double h2 = 0.5*rh*rh;
+  const double s = r + h2;
+  const double tail = (h2 - (s - r)) + (0.5*rl*(rh + r) + r*r*r*p);
+  // expm1(x) = 2^k (1 + q) - 1 = 2^k s + (2^k - 1) + 2^k tail. 2^k s and
+  // 2^k - 1 are exact (the latter for any k where it matters), and the
+  // second is always at least as large as the first, so we can add them
+  // with Fast2Sum and fold the rounding error in with the tail.
+  const double scale = _numerics_asdouble(
+    (_numerics_asuint64(k + shift) + 1023) << 52
+  );
+  const double c = scale - 1;
+  const double head = c + scale*s;
+  const double result = head + ((scale*s - (head - c)) + scale*tail);
+  // Preserve the sign of zero.
+  return x == 0 ? x : result;
+}
+
+/// Splits a positive normal x into k and f such that x = 2^k (1 + f), with
+/// 1 + f in [sqrt(2)/2, sqrt(2)), and evaluates the fdlibm approximation of
+/// log(1 + f) - f + f^2/2 in the form needed by the log kernels.
+HEADER_SHIM void _numerics_log_reduce(double x, double *k, double *f,
+                                      double *hfsq, double *sR) {
+  // Subtracting the representation of sqrt(2)/2 from the representation of
+  // x puts the exponent k we want in the high-order bits.
+  const unsigned long long off = 0x3fe6a09e667f3bcdULL;
+  const unsigned long long tmp = _numerics_asuint64(x) - off;
+  // (Sign-extend the 12-bit exponent by hand; 64-bit arithmetic shifts are
+  // not available in most vector ISAs.)
+  const unsigned long long kbits = ((tmp >> 52) ^ 0x800) - 0x800;
+  const double m = _numerics_asdouble(
+    _numerics_asuint64(x) - (tmp & 0xfff0000000000000ULL)
+  );
+  // Convert k to double without int64 -> double conversion instructions,
+  // which are not available in most vector ISAs.
+  *k = _numerics_asdouble(0x4338000000000000ULL + kbits) - 0x1.8p52;
+  *f = m - 1;
+  const double s = *f/(2 + *f);
+  const double z = s*s;
+  double R = 0x1.2f112df3e5244p-3;            // Lg7
+  R = R*z + 0x1.39a09d078c69fp-3;             // Lg6
+  R = R*z + 0x1.7466496cb03dep-3;             // Lg5
+  R = R*z + 0x1.c71c51d8e78afp-3;             // Lg4
+  R = R*z + 0x1.2492494229359p-2;             // Lg3
+  R = R*z + 0x1.999999997fa04p-2;             // Lg2
+  R = R*z + 0x1.5555555555593p-1;             // Lg1
+  R = R*z;
+  *hfsq = 0.5*(*f)*(*f);
+  *sR = s*(*hfsq + R);
+}
+
+/// log(x), valid for positive normal finite x.
+HEADER_SHIM double _numerics_log_kernel(double x) {
+  double k, f, hfsq, sR;
+  _numerics_log_reduce(x, &k, &f, &hfsq, &sR);
+  return k*0x1.62e42feep-1 - ((hfsq - (sR + k*0x1.a39ef35793c76p-33)) - f);
+}
+
+/// log(1 + x), valid for finite x > -1.
+HEADER_SHIM double _numerics_log1p_kernel(double x) {
+  // Compute log(u) for u = 1 + x rounded, and correct for the rounding
+  // error c = (1 + x) - u with log(1 + x) = log(u) + c/u. Both expressions
+  // for c are exact in the range in which they are used.
+  const double u = 1 + x;
+  const double c = u < 2 ? x - (u - 1) : 1 - (u - x);
+  double k, f, hfsq, sR;
+  _numerics_log_reduce(u, &k, &f, &hfsq, &sR);
+  const double result = k*0x1.62e42feep-1 -
+    ((hfsq - (sR + (k*0x1.a39ef35793c76p-33 + c/u))) - f);
+  return x == 0 ? x : result;
+}
+
+/// sin(r + e) and cos(r + e) for |r| <= π/4, |e| <= ulp(r)/2, using the
+/// fdlibm polynomials.
+HEADER_SHIM void _numerics_sincos_poly(double r, double e,
+                                       double *sinr, double *cosr) {
+  const double z = r*r;
+  const double v = z*r;
+  double s = 0x1.5d93a5acfd57cp-33;           // S6
+  s = s*z - 0x1.ae5e68a2b9cebp-26;            // S5
+  s = s*z + 0x1.71de357b1fe7dp-19;            // S4
+  s = s*z - 0x1.a01a019c161d5p-13;            // S3
+  s = s*z + 0x1.111111110f8a6p-7;             // S2
+  *sinr = r - ((z*(0.5*e - v*s) - e) - v*-0x1.5555555555549p-3);
+  double c = -0x1.8fae9be8838d4p-37;          // C6
+  c = c*z + 0x1.1ee9ebdb4b1c4p-29;            // C5
+  c = c*z - 0x1.27e4f809c52adp-22;            // C4
+  c = c*z + 0x1.a01a019cb1590p-16;            // C3
+  c = c*z - 0x1.6c16c16c15177p-10;            // C2
+  c = c*z + 0x1.555555555554cp-5;             // C1
+  c = z*c;
+  const double hz = 0.5*z;
+  const double w = 1 - hz;
+  *cosr = w + (((1 - w) - hz) + (z*c - r*e));
+}
+
+/// sin(x) and cos(x), valid for |x| <= 2^20.
+HEADER_SHIM void _numerics_sincos_kernel(double x, double *sinx, double *cosx) {
+  // k = x*2/π rounded to integer; n = k mod 4 selects the quadrant.
+  const double shift = 0x1.8p52;
+  const double t = x*0x1.45f306dc9c883p-1 + shift;
+  const double k = t - shift;
+  const unsigned long long n = _numerics_asuint64(t) & 3;
+  // Three-stage Cody-Waite reduction with π/2 = p1 + p2 + p2t. p1 and p2
+  // have 33 significant bits, so k*p1 and k*p2 are exact for |k| < 2^20,
+  // and x - k*p1 is exact by Sterbenz' lemma. The remaining subtraction is
+  // done in two-sum form to keep the rounding error.
+  const double r1 = x - k*0x1.921fb544p0;
+  const double w = k*0x1.0b4611a6p-34;
+  const double r2 = r1 - w;
+  const double bp = r2 - r1;
+  const double e2 = (r1 - (r2 - bp)) - (w + bp);
+  const double lo = e2 - k*0x1.3198a2e037073p-69;
+  const double r = r2 + lo;
+  const double e = (r2 - r) + lo;
+  double s, c;
+  _numerics_sincos_poly(r, e, &s, &c);
+  // Select based on quadrant:
+  //   n:    0    1    2    3
+  //   sin:  s    c   -s   -c
+  //   cos:  c   -s   -c    s
+  // The reduction loses the sign of zero (-0 - 0 is +0), so sin(±0) is
+  // taken from x directly.
+  const double sq = n & 1 ? c : s;
+  const double cq = n & 1 ? s : c;
+  *sinx = x == 0 ? x : n & 2 ? -sq : sq;
+  *cosx = (n + 1) & 2 ? -cq : cq;
+}
+
+HEADER_SHIM double _numerics_sin_kernel(double x) {
+  double s, c;
+  _numerics_sincos_kernel(x, &s, &c);
+  return s;
+}
+
+HEADER_SHIM double _numerics_cos_kernel(double x) {
+  double s, c;
+  _numerics_sincos_kernel(x, &s, &c);
+  return c;
+}
+
+/// tanh(x), valid for all x.
+HEADER_SHIM double _numerics_tanh_kernel(double x) {
+  // tanh|x| = t/(t + 2) where t = expm1(2|x|); the error in t is damped by
+  // a factor of 2/(t + 2) in the result, so this is accurate everywhere.
+  // For |x| > 22, tanh(x) rounds to ±1, so we can clamp |x| to keep expm1
+  // in its fast domain (this also handles infinity; nan propagates through
+  // the comparison).
+  double a = __builtin_fabs(x);
+  a = a > 22 ? 22 : a;
+  const double t = _numerics_expm1_kernel(2*a);
+  return __builtin_copysign(t/(t + 2), x);
+}
+
+// Evaluates the polynomial of degree 21 with coefficients T[I] at X, into P.
+// The row is selected per element; writing the steps out, and indexing the
+// table directly, lets loops over the elements vectorize with gathers for
+// the coefficients.
+#define _NUMERICS_POLY21(P, T, I, X)                                          \
+  P = T[I][21];                                                               \
+  P = P*(X) + T[I][20];                                                       \
+  P = P*(X) + T[I][19];                                                       \
+  P = P*(X) + T[I][18];                                                       \
+  P = P*(X) + T[I][17];                                                       \
+  P = P*(X) + T[I][16];                                                       \
+  P = P*(X) + T[I][15];                                                       \
+  P = P*(X) + T[I][14];                                                       \
+  P = P*(X) + T[I][13];                                                       \
+  P = P*(X) + T[I][12];                                                       \
+  P = P*(X) + T[I][11];                                                       \
+  P = P*(X) + T[I][10];                                                       \
+  P = P*(X) + T[I][9];                                                        \
+  P = P*(X) + T[I][8];                                                        \
+  P = P*(X) + T[I][7];                                                        \
+  P = P*(X) + T[I][6];                                                        \
+  P = P*(X) + T[I][5];                                                        \
+  P = P*(X) + T[I][4];                                                        \
+  P = P*(X) + T[I][3];                                                        \
+  P = P*(X) + T[I][2];                                                        \
+  P = P*(X) + T[I][1];                                                        \
+  P = P*(X) + T[I][0];
+
+/// erf(x) - x, valid for |x| < 0.84375.
+HEADER_SHIM double _numerics_erf_poly(double x) {
+  // erf(x) = x P(x^2), with P a polynomial interpolant of degree 11 at the
+  // Chebyshev nodes. The leading 1 of P is added by the callers, so that
+  // the rounding error of the sum is that of a single addition.
+  const double s = x*x;
+  double p = -0x1.e82ab4a2799adp-31;
+  p = p*s + 0x1.e819bbd6706fep-27;
+  p = p*s - 0x1.5e1b368bdf09ep-23;
+  p = p*s + 0x1.b9c9ed1d47fd5p-20;
+  p = p*s - 0x1.f4d0c17daf57fp-17;
+  p = p*s + 0x1.f9a317b0dcb87p-14;
+  p = p*s - 0x1.c02db3a033205p-11;
+  p = p*s + 0x1.565bcd0ceb1d7p-8;
+  p = p*s - 0x1.b82ce31281a71p-6;
+  p = p*s + 0x1.ce2f21a042acfp-4;
+  p = p*s - 0x1.812746b0379e6p-2;
+  p = p*s + 0x1.06eba8214db68p-3;
+  return x*p;
+}
+
+/// exp(-c a^2) for c = 1 or c = 1/2, valid when c a^2 <= 708.
+HEADER_SHIM double _numerics_exp_minus_square(double a, double c) {
+  // a^2 = hi + lo exactly, by Dekker's splitting, which keeps the rounding
+  // error of a^2 (which is magnified by a^2 in the result) out entirely.
+  const double as = a*0x1.0000002p27;
+  const double ah = as - (as - a);
+  const double al = a - ah;
+  const double hi = a*a;
+  const double lo = ((ah*ah - hi) + 2*ah*al) + al*al;
+  const double e = _numerics_exp_kernel(-c*hi);
+  return e - e*(c*lo);
+}
+
+/// exp(a^2) erfc(a) for 0.5 <= a < 32.
+HEADER_SHIM double _numerics_erfcx_poly(double a) {
+  // One polynomial interpolant of degree 21 for each binade, in the
+  // variable t = 2m - 3, where m in [1, 2) is the significand of a.
+  static const double table[6][22] = {
+    {
+      0x1.038d54ea3d834p-1, -0x1.78cdd551ee51ap-4, 0x1.d90093ae10928p-7,
+      -0x1.09e77d40e0239p-9, 0x1.1192f5bd6877dp-12, -0x1.054d68295b244p-15,
+      0x1.d43a7c7a661b3p-19, -0x1.8c97dd4ea4906p-22, 0x1.3f81897ce8652p-25,
+      -0x1.ec0cf4e3344b9p-29, 0x1.6b982c1d4a62bp-32, -0x1.02b1604028e4ap-35,
+      0x1.6372355c89958p-39, -0x1.d8bafbaea518bp-43, 0x1.30ecbdb1ed1a9p-46,
+      -0x1.7e469e23c49a4p-50, 0x1.d27f421233091p-54, -0x1.15777b023bfp-57,
+      0x1.421443086c5d1p-61, -0x1.6d78fea5e2e8cp-65, 0x1.a009a51e8ba2fp-69,
+      -0x1.c3cda5e8ba2e9p-73
+    },
+    {
+      0x1.494daffa2ad68p-2, -0x1.4f1988444caf7p-4, 0x1.37ea271bc54bdp-6,
+      -0x1.0dc51d2941e6dp-8, 0x1.b65944f34f7adp-11, -0x1.513ed7600d1c1p-13,
+      0x1.ee705e736463cp-16, -0x1.5b0abfe65a326p-18, 0x1.d4509d0d4281fp-21,
+      -0x1.30c0ec743c47cp-23, 0x1.7f997922bc632p-26, -0x1.d4157188212dap-29,
+      0x1.156c93a1e0e3dp-31, -0x1.4004f02a762e3p-34, 0x1.67cf4505fecb4p-37,
+      -0x1.8adc028c4f899p-40, 0x1.a7815567b639ep-43, -0x1.bc5eab92cd551p-46,
+      0x1.c7329e350cc85p-49, -0x1.caa5b00ad7c4cp-52, 0x1.ec52338741717p-55,
+      -0x1.dc7462edb45d1p-58
+    },
+    {
+      0x1.6e9827d229d2dp-3, -0x1.bd6ae4d14b16fp-5, 0x1.043fe1a98c0cdp-6,
+      -0x1.259061ba85692p-8, 0x1.409cc2ed3ff31p-10, -0x1.53dec9d08957bp-12,
+      0x1.5e73930481c7cp-14, -0x1.6025103c17179p-16, 0x1.595f1b5f62556p-18,
+      -0x1.4b1462877e572p-20, 0x1.3699043f265d5p-22, -0x1.1d7913fabd32p-24,
+      0x1.0150a4318885dp-26, -0x1.c75227b0b98ap-29, 0x1.8bba0e32339d5p-31,
+      -0x1.522424a8e7909p-33, 0x1.1ca1848ccf70fp-35, -0x1.d702714aa4fdfp-38,
+      0x1.76b837ca50cd2p-40, -0x1.2d603e8e53ac1p-42, 0x1.2c8a181a21409p-44,
+      -0x1.d30fc9b85e9dfp-47
+    },
+    {
+      0x1.7c0348489d721p-4, -0x1.ed7f66d9d09fep-6, 0x1.3c7764a81f453p-7,
+      -0x1.9106a7cd79e2cp-9, 0x1.f64cd9c07dc28p-11, -0x1.370d06417898fp-12,
+      0x1.7d0e03ec8b2b5p-14, -0x1.cde4cecbb11a2p-16, 0x1.151346e8ae22cp-17,
+      -0x1.491bb11845652p-19, 0x1.832004ec3d6e4p-21, -0x1.c312b391f19fap-23,
+      0x1.0461f39621b5ap-24, -0x1.29e7ea64ec2e6p-26, 0x1.519ffa4478e24p-28,
+      -0x1.7ba3218ba50eap-30, 0x1.aba7e0d93601cp-32, -0x1.d8b4cc0837307p-34,
+      0x1.d27c095dabbcp-36, -0x1.fd76e574c83dbp-38, 0x1.c2ad9ac6b4efap-39,
+      -0x1.e0432d2d9df08p-41
+    },
+    {
+      0x1.7fd46c5e0864dp-5, -0x1.fc477b46d665ap-7, 0x1.4f67f473cc46bp-8,
+      -0x1.b92eddb6a4b8ep-10, 0x1.21338ab43a335p-11, -0x1.79e921ac737fdp-13,
+      0x1.ec3b2640e2029p-15, -0x1.3f89d9a59e1e3p-16, 0x1.9d8bfbd11b41fp-18,
+      -0x1.0ac36de13aa98p-19, 0x1.57151861417dp-21, -0x1.b7df8adf80e41p-23,
+      0x1.192823cf27f5cp-24, -0x1.6647709a9a8f6p-26, 0x1.c61d5dceb849p-28,
+      -0x1.1f9ffea411ca9p-29, 0x1.7582b1f9c45dap-31, -0x1.d61965f3d91b1p-33,
+      0x1.d3de269f43a48p-35, -0x1.25ca2a867daf7p-36, 0x1.858d7b97d086p-37,
+      -0x1.e362445bd4878p-39
+    },
+    {
+      0x1.80d1e88d3c62p-6, -0x1.001a68f1b5449p-7, 0x1.54964558f63abp-9,
+      -0x1.c48d27f6c7b9p-11, 0x1.2c675fe086f99p-12, -0x1.8e79b81923fd8p-14,
+      0x1.080e891206132p-15, -0x1.5daa87ab2b63ap-17, 0x1.cea357550e912p-19,
+      -0x1.31cbb5d2995fap-20, 0x1.93e8349a0eec9p-22, -0x1.0a86942bde563p-23,
+      0x1.5f859dc5791efp-25, -0x1.cf235523dd81cp-27, 0x1.2fbf41f9a2761p-28,
+      -0x1.8f89707e9aba1p-30, 0x1.11105fa35861p-31, -0x1.667f9ab2df296p-33,
+      0x1.58eb303caf64cp-35, -0x1.c4c34871d29fcp-37, 0x1.67954d55c9b7fp-37,
+      -0x1.d62375e7c9464p-39
+    }
+  };
+  const unsigned long long bits = _numerics_asuint64(a);
+  const double m = _numerics_asdouble(
+    (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL
+  );
+  const double t = 2*m - 3;
+  const long long i = (long long)(bits >> 52) - 1022;
+  double p;
+  _NUMERICS_POLY21(p, table, i, t);
+  return p;
+}
+
+/// erfc(a), clamping a to [0.5, 26.5]; the result is normal and accurate
+/// for 0.84375 <= a <= 26.5.
+HEADER_SHIM double _numerics_erfc_large(double a) {
+  // (Written so that nan is clamped as well, which keeps the table index
+  // in range.)
+  a = a >= 0.5 ? a : 0.5;
+  a = a <= 26.5 ? a : 26.5;
+  return _numerics_exp_minus_square(a, 1)*_numerics_erfcx_poly(a);
+}
+
+/// erf(x), valid for all x except nan.
+HEADER_SHIM double _numerics_erf_kernel(double x) {
+  // Above 0.84375, erf(x) = 1 - erfc(x) with erfc(x) < 0.24, so there is
+  // little cancellation; beyond 6, erf(x) rounds to ±1.
+  const double a = __builtin_fabs(x);
+  const double small = x + _numerics_erf_poly(x);
+  const double large = __builtin_copysign(
+    1 - _numerics_erfc_large(a > 6 ? 6 : a), x
+  );
+  return a < 0.84375 ? small : large;
+}
+
+/// erfc(x) for |x| < 0.84375, given q = erf(x) - x.
+HEADER_SHIM double _numerics_erfc_small(double x, double q) {
+  // erfc(x) = 1 - (x + q). When x >= 1/4, arranging this as
+  // 1/2 - ((x - 1/2) + q), where x - 1/2 is exact, avoids the cancellation
+  // between 1 and x + q.
+  return x < 0.25 ? 1 - (x + q) : 0.5 - ((x - 0.5) + q);
+}
+
+/// erfc(x), valid for x <= 26.5, where the result is normal.
+HEADER_SHIM double _numerics_erfc_kernel(double x) {
+  const double a = __builtin_fabs(x);
+  const double small = _numerics_erfc_small(x, _numerics_erf_poly(x));
+  const double c = _numerics_erfc_large(a);
+  return a < 0.84375 ? small : x < 0 ? 2 - c : c;
+}
+
+/// Φ(x) = erfc(-x/√2)/2, the standard normal cumulative distribution
+/// function, valid for x >= -37.5, where the result is normal.
+HEADER_SHIM double _numerics_normal_cdf_kernel(double x) {
+  // The same formulas as erfc, except that exp(-z^2) for z = x/√2 is
+  // computed as exp(-x^2/2), which avoids the relative error of about
+  // z^2 ulps that rounding z would cost in the tail.
+  const double z = -x*0x1.6a09e667f3bcdp-1;
+  const double small = 0.5*_numerics_erfc_small(z, _numerics_erf_poly(z));
+  double a = __builtin_fabs(x);
+  a = a <= 37.5 ? a : 37.5;
+  const double za = a*0x1.6a09e667f3bcdp-1;
+  const double c = 0.5*_numerics_exp_minus_square(a, 0.5)*
+    _numerics_erfcx_poly(za >= 0.5 ? za : 0.5);
+  return __builtin_fabs(z) < 0.84375 ? small : x < 0 ? c : 1 - c;
+}
+
+/// log(Γ(x)), valid for 2^-1022 <= x <= 2^1000.
+HEADER_SHIM double _numerics_lgamma_kernel(double x) {
+  // For y = x in [0.5, 16), log(Γ(y)) = (y - 1)(y - 2) R(y), which has the
+  // zeros at 1 and 2 exactly, with a polynomial interpolant of degree 21
+  // for R in each binade. Below 0.5, log(Γ(x)) = log(Γ(x + 1)) - log(x).
+  static const double table[5][22] = {
+    {
+      0x1.4d0e35f51a18bp-1, -0x1.68d0e724a2f56p-4, 0x1.2d24b6e9d82b8p-6,
+      -0x1.27d8568c437d5p-8, 0x1.3aa2bb2038fadp-10, -0x1.5e2fbad65e6cdp-12,
+      0x1.915a51ac16cap-14, -0x1.d592181172e47p-16, 0x1.16f3ffa1a9bc4p-17,
+      -0x1.4f701d571d0a7p-19, 0x1.9749944703bbcp-21, -0x1.f280e6f823101p-23,
+      0x1.332d55af2632ap-24, -0x1.7cb25b50c7f77p-26, 0x1.d8eb3328546dap-28,
+      -0x1.27c60897e8749p-29, 0x1.7f505cb9e97c8p-31, -0x1.e32ef7f80c408p-33,
+      0x1.d4a97bdb15046p-35, -0x1.2826690bbbf72p-36, 0x1.ab30d1e0199a9p-37,
+      -0x1.108eb0b2adcd9p-38
+    },
+    {
+      0x1.eeb95b094c191p-2, -0x1.2aed059bd608ap-4, 0x1.01af62a2929cp-6,
+      -0x1.007aa83cee1acp-8, 0x1.133423527f1f2p-10, -0x1.34dbda14971e2p-12,
+      0x1.64f0664c4f943p-14, -0x1.a5035232a7d25p-16, 0x1.f814bab49d011p-18,
+      -0x1.313e8a3ddad6fp-19, 0x1.750a7900f071ep-21, -0x1.cb44dee9facp-23,
+      0x1.1c7e3a261c9ebp-24, -0x1.623f109df00eep-26, 0x1.b9e43433855c2p-28,
+      -0x1.156abea920aefp-29, 0x1.68f13e0fbb796p-31, -0x1.c85e4bc95846cp-33,
+      0x1.ba730a9784e06p-35, -0x1.18598e23bb974p-36, 0x1.9759e019683dp-37,
+      -0x1.0467902760469p-38
+    },
+    {
+      0x1.62e42fefa39efp-2, -0x1.def8bd73867fep-5, 0x1.aede3660fcb1dp-7,
+      -0x1.b4c4ca54839d2p-9, 0x1.d8cdb770c0008p-11, -0x1.0ab1113fc4d66p-12,
+      0x1.35711f3c308a9p-14, -0x1.6e6092720e9c7p-16, 0x1.b8665915a72a2p-18,
+      -0x1.0bcc10dc6eccfp-19, 0x1.48b471bf57e16p-21, -0x1.967e58e524e5dp-23,
+      0x1.f9de2f0cca925p-25, -0x1.3c593b04fb373p-26, 0x1.8c4b723f28677p-28,
+      -0x1.f3ab8d8095ba7p-30, 0x1.469b2bcb098d2p-31, -0x1.9e863a4a2893bp-33,
+      0x1.91711c2abc6d2p-35, -0x1.fe9411730cbe9p-37, 0x1.76e64b128041bp-37,
+      -0x1.e0b13f1dfab83p-39
+    },
+    {
+      0x1.ea3d393a0c2dcp-3, -0x1.6f3598c0d5f23p-5, 0x1.5b58f3d4d702cp-7,
+      -0x1.69e6e8aae79d3p-9, 0x1.8e0aa1ae8c40bp-11, -0x1.c559a0f4c9896p-13,
+      0x1.0891bc9bb422dp-14, -0x1.3a718ec1eb36bp-16, 0x1.7af6ede96b597p-18,
+      -0x1.cdcaf99310e8ep-20, 0x1.1be30c5845077p-21, -0x1.5f9f5d47ac57ap-23,
+      0x1.b647d9cf31d9dp-25, -0x1.128a5bf69fb24p-26, 0x1.58838ff627952p-28,
+      -0x1.b334bd2d89e47p-30, 0x1.1d3218632bb41p-31, -0x1.6abca851fad0ap-33,
+      0x1.5ec3f28a5cc29p-35, -0x1.bf1c0904246bfp-37, 0x1.4b1687cf2c435p-37,
+      -0x1.a98543ea0ddc6p-39
+    },
+    {
+      0x1.45dc744ebb29p-3, -0x1.0bb603208f2ap-5, 0x1.0a77409dc0bf5p-7,
+      -0x1.1ed211ec4809p-9, 0x1.4292b43670956p-11, -0x1.7544318dbbd74p-13,
+      0x1.b8b9fe86c1d76p-15, -0x1.08268bb60320ep-16, 0x1.40640eaf5ffecp-18,
+      -0x1.884cb364f02c6p-20, 0x1.e4185b8379f4bp-22, -0x1.2ca31808c7ec5p-23,
+      0x1.778933a1b66f5p-25, -0x1.d7432b7c34015p-27, 0x1.28131e3ffaf8p-28,
+      -0x1.766b4961e6493p-30, 0x1.eb3f8223d91ap-32, -0x1.38a6cc73064f6p-33,
+      0x1.2e38187500d93p-35, -0x1.8179a7fbd900cp-37, 0x1.1e2692c652355p-37,
+      -0x1.70050e4fb0d77p-39
+    }
+  };
+  const double y = x < 0.5 ? x + 1 : x;
+  // (The batch drivers evaluate the kernel on every element, so b must
+  // index the table even for x outside the domain, including nan.)
+  const double b = (y >= 0.5) & (y < 16) ? y : 8;
+  const unsigned long long bits = _numerics_asuint64(b);
+  const double m = _numerics_asdouble(
+    (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL
+  );
+  const double t = 2*m - 3;
+  const long long i = (long long)(bits >> 52) - 1022;
+  double p;
+  _NUMERICS_POLY21(p, table, i, t);
+  // (Adding zero turns the -0 at 1 into the +0 that libm returns.)
+  const double near = (b - 1)*(b - 2)*p + 0;
+  // At most one of the logarithms is needed, so only one is computed.
+  const double l = _numerics_log_kernel(x < 0.5 ? x : y);
+  // From 16 on, Stirling's series, truncated after terms of order y^-11.
+  const double w = 1/y;
+  const double ww = w*w;
+  double s = -0x1.f6ab0d9993c7dp-10;          // -691/360360
+  s = s*ww + 0x1.b951e2b18ff23p-11;           // 1/1188
+  s = s*ww - 0x1.3813813813814p-11;           // -1/1680
+  s = s*ww + 0x1.a01a01a01a01ap-11;           // 1/1260
+  s = s*ww - 0x1.6c16c16c16c17p-9;            // -1/360
+  s = s*ww + 0x1.5555555555555p-4;            // 1/12
+  // (y - 1/2) log(y) - y + log(2π)/2 + s/y
+  const double far = ((y - 0.5)*(l - 1) + 0x1.acfe390c97d69p-2) + s*w;
+  return y >= 16 ? far : x < 0.5 ? near - l : near;
+}
+
+#undef _NUMERICS_POLY21
+
+HEADER_SHIM double _numerics_exp_clampf(double x) {
+  // Every float x outside of this range has exp(x) rounding to 0 or inf
+  // as a float, and so do these clamped values.
+  x = x < -150 ? -150 : x;
+  return x > 128 ? 128 : x;
+}
+
+HEADER_SHIM float _numerics_expf_kernel(float x) {
+  return (float)_numerics_exp_kernel(_numerics_exp_clampf(x));
+}
+
+HEADER_SHIM float _numerics_expm1f_kernel(float x) {
+  return (float)_numerics_expm1_kernel(_numerics_exp_clampf(x));
+}
+
+HEADER_SHIM float _numerics_logf_kernel(float x) {
+  // Every positive float, including subnormals, is a normal double.
+  return (float)_numerics_log_kernel(x);
+}
+
+HEADER_SHIM float _numerics_log1pf_kernel(float x) {
+  return (float)_numerics_log1p_kernel(x);
+}
+
+HEADER_SHIM float _numerics_sinf_kernel(float x) {
+  return (float)_numerics_sin_kernel(x);
+}
+
+HEADER_SHIM float _numerics_cosf_kernel(float x) {
+  return (float)_numerics_cos_kernel(x);
+}
+
+HEADER_SHIM float _numerics_tanhf_kernel(float x) {
+  return (float)_numerics_tanh_kernel(x);
+}
+
+HEADER_SHIM float _numerics_erff_kernel(float x) {
+  return (float)_numerics_erf_kernel(x);
+}
+
+HEADER_SHIM float _numerics_erfcf_kernel(float x) {
+  // erfc(x) rounds to zero as a float from about 10.06 on.
+  return (float)_numerics_erfc_kernel(x < 26 ? x : 26);
+}
+
+HEADER_SHIM float _numerics_lgammaf_kernel(float x) {
+  // Every positive float is in the domain of the double kernel.
+  return (float)_numerics_lgamma_kernel(x);
+}
+
+HEADER_SHIM float _numerics_tgammaf_kernel(float x) {
+  // Γ(x) = exp(log(Γ(x))) for positive x; the double kernel is accurate
+  // enough that the error of the exponential is far below a float ulp.
+  // Negative (non-integer) x use the reflection formula
+  // Γ(x) = π/(sin(πx) Γ(1 - x)), where 1 - x is exact, and sin(πx) is
+  // computed from the exact reduction x = n + r with |r| <= 1/2.
+  const double y = x;
+  const double shift = 0x1.8p52;
+  const double t = y + shift;
+  const double r = y - (t - shift);
+  const double s = _numerics_sin_kernel(0x1.921fb54442d18p1*r);
+  const double sinpi = _numerics_asuint64(t) & 1 ? -s : s;
+  // Γ(x) overflows as a float beyond 35.04, and so does Γ(36); Γ(1 - x)
+  // is clamped to exp(708), which leaves the reflected result below the
+  // float subnormals.
+  const double z = y < 0 ? 1 - y : y < 36 ? y : 36;
+  double l = _numerics_lgamma_kernel(z);
+  l = l < 708 ? l : 708;
+  const double g = _numerics_exp_kernel(l);
+  return (float)(y < 0 ? 0x1.921fb54442d18p1/(sinpi*g) : g);
+}
+
+HEADER_SHIM float _numerics_normal_cdff_kernel(float x) {
+  return (float)_numerics_normal_cdf_kernel(x > -37.5f ? x : -37.5f);
+}
+
+// Fallbacks for the kernels above that do not correspond directly to a
+// libm function.
+HEADER_SHIM double _numerics_normal_cdf_fallback(double x) {
+  // As in the scalar normalCDF: z + d = -x/√2 to about twice working
+  // precision, with √½ split into head and tail, and then
+  // erfc(z + d) ≈ erfc(z) - d·2exp(-z²)/√π. Without the correction, the
+  // rounding of -x/√2 alone costs up to about 1700 ulp in this range.
+  const double z = -x*0x1.6a09e667f3bcdp-1;
+  const double e = __builtin_fma(-x, 0x1.6a09e667f3bcdp-1, -z);
+  const double d = __builtin_fma(-x, -0x1.bdd3413b26455p-55, e);
+  const double r = 0.5*(libm_erfc(z) - 0x1.20dd750429b6dp0*d*libm_exp(-z*z));
+  // For x = -∞, e and d are nan (∞ - ∞), but erfc(∞) is the result.
+  return x == -__builtin_inf() ? 0 : r;
+}
+
+HEADER_SHIM float _numerics_normal_cdff_fallback(float x) {
+  return (float)_numerics_normal_cdf_fallback(x);
+}
+
+#if !defined _WIN32
+HEADER_SHIM double _numerics_lgamma_fallback(double x) {
+  int sign;
+  return libm_lgamma(x, &sign);
+}
+
+HEADER_SHIM float _numerics_lgammaf_fallback(float x) {
+  int sign;
+  return libm_lgammaf(x, &sign);
+}
+#endif
+
+// Drivers for the kernels above. Elements are processed in blocks, so that
+// the slow path can still read the original input even when result and x
+// are the same buffer.
+#define _NUMERICS_BATCH(NAME, T, KERNEL, IN_DOMAIN, FALLBACK)                 \
+HEADER_SHIM void NAME(const T *x, T *result, long count) {                    \
+  for (long i = 0; i < count; i += 64) {                                      \
+    const long n = count - i < 64 ? count - i : 64;                           \
+    T block[64];                                                              \
+    int slow = 0;                                                             \
+    for (long j = 0; j < n; ++j) {                                            \
+      const T xj = x[i + j];                                                  \
+      block[j] = KERNEL(xj);                                                  \
+      slow |= !(IN_DOMAIN);                                                   \
+    }                                                                         \
+    if (slow) {                                                               \
+      for (long j = 0; j < n; ++j) {                                          \
+        const T xj = x[i + j];                                                \
+        if (!(IN_DOMAIN)) block[j] = FALLBACK(xj);                            \
+      }                                                                       \
+    }                                                                         \
+    for (long j = 0; j < n; ++j) result[i + j] = block[j];                    \
+  }                                                                           \
+}
+
+_NUMERICS_BATCH(_numerics_batch_exp, double, _numerics_exp_kernel,
+                __builtin_fabs(xj) <= 708, libm_exp)
+_NUMERICS_BATCH(_numerics_batch_expm1, double, _numerics_expm1_kernel,
+                __builtin_fabs(xj) <= 708, libm_expm1)
+_NUMERICS_BATCH(_numerics_batch_log, double, _numerics_log_kernel,
+                (xj >= 0x1p-1022) & (xj <= 0x1.fffffffffffffp1023), libm_log)
+_NUMERICS_BATCH(_numerics_batch_log1p, double, _numerics_log1p_kernel,
+                (xj > -1) & (xj <= 0x1.fffffffffffffp1023), libm_log1p)
+_NUMERICS_BATCH(_numerics_batch_sin, double, _numerics_sin_kernel,
+                __builtin_fabs(xj) <= 0x1p20, libm_sin)
+_NUMERICS_BATCH(_numerics_batch_cos, double, _numerics_cos_kernel,
+                __builtin_fabs(xj) <= 0x1p20, libm_cos)
+_NUMERICS_BATCH(_numerics_batch_tanh, double, _numerics_tanh_kernel,
+                1, libm_tanh)
+_NUMERICS_BATCH(_numerics_batch_erf, double, _numerics_erf_kernel,
+                xj == xj, libm_erf)
+_NUMERICS_BATCH(_numerics_batch_erfc, double, _numerics_erfc_kernel,
+                xj <= 26.5, libm_erfc)
+_NUMERICS_BATCH(_numerics_batch_normal_cdf, double, _numerics_normal_cdf_kernel,
+                xj >= -37.5, _numerics_normal_cdf_fallback)
+#if !defined _WIN32
+_NUMERICS_BATCH(_numerics_batch_lgamma, double, _numerics_lgamma_kernel,
+                (xj >= 0x1p-1022) & (xj <= 0x1p1000), _numerics_lgamma_fallback)
+#endif
+
+_NUMERICS_BATCH(_numerics_batch_expf, float, _numerics_expf_kernel,
+                1, libm_expf)
+_NUMERICS_BATCH(_numerics_batch_expm1f, float, _numerics_expm1f_kernel,
+                1, libm_expm1f)
+_NUMERICS_BATCH(_numerics_batch_logf, float, _numerics_logf_kernel,
+                (xj > 0) & (xj <= 0x1.fffffep127f), libm_logf)
+_NUMERICS_BATCH(_numerics_batch_log1pf, float, _numerics_log1pf_kernel,
+                (xj > -1) & (xj <= 0x1.fffffep127f), libm_log1pf)
+_NUMERICS_BATCH(_numerics_batch_sinf, float, _numerics_sinf_kernel,
+                __builtin_fabsf(xj) <= 0x1p20f, libm_sinf)
+_NUMERICS_BATCH(_numerics_batch_cosf, float, _numerics_cosf_kernel,
+                __builtin_fabsf(xj) <= 0x1p20f, libm_cosf)
+_NUMERICS_BATCH(_numerics_batch_tanhf, float, _numerics_tanhf_kernel,
+                1, libm_tanhf)
+_NUMERICS_BATCH(_numerics_batch_erff, float, _numerics_erff_kernel,
+                xj == xj, libm_erff)
+_NUMERICS_BATCH(_numerics_batch_erfcf, float, _numerics_erfcf_kernel,
+                xj == xj, libm_erfcf)
+_NUMERICS_BATCH(_numerics_batch_tgammaf, float, _numerics_tgammaf_kernel,
+                ((xj > 0) & (xj <= 0x1.fffffep127f)) |
+                ((xj < 0) & ((double)xj != ((double)xj + 0x1.8p52) - 0x1.8p52)),
+                libm_tgammaf)
+_NUMERICS_BATCH(_numerics_batch_normal_cdff, float, _numerics_normal_cdff_kernel,
+                xj == xj, _numerics_normal_cdff_fallback)
+#if !defined _WIN32
+_NUMERICS_BATCH(_numerics_batch_lgammaf, float, _numerics_lgammaf_kernel,
+                (xj > 0) & (xj <= 0x1.fffffep127f), _numerics_lgammaf_fallback)
+#endif
+
+#undef _NUMERICS_BATCH
+
+// MARK: - atomic pointers
+// Just enough to publish immutable objects to other threads without a lock:
+// a pointer that is read with acquire ordering and replaced with
+// compare-and-swap (release ordering on success).
+HEADER_SHIM void *_numerics_atomic_load_pointer(void *const *p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+// Returns non-zero if *p was expected, in which case it is now desired;
+// otherwise returns zero and stores the current value of *p to *expected.
+HEADER_SHIM int _numerics_atomic_compare_exchange_pointer(void **p,
+                                                          void **expected,
+                                                          void *desired) {
+  return __atomic_compare_exchange_n(p, expected, desired, 0,
+                                     __ATOMIC_RELEASE, __ATOMIC_ACQUIRE);
+}
+
+// MARK: - relaxed counters
+// Event counters that many threads may increment at once. Only the counts
+// themselves matter, so every access is relaxed.
+HEADER_SHIM void _numerics_relaxed_increment(unsigned long long *p) {
+  __atomic_fetch_add(p, 1, __ATOMIC_RELAXED);
+}
+
+HEADER_SHIM unsigned long long
+_numerics_relaxed_load(const unsigned long long *p) {
+  return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+
+HEADER_SHIM void _numerics_relaxed_store(unsigned long long *p,
+                                         unsigned long long value) {
+  __atomic_store_n(p, value, __ATOMIC_RELAXED);
+}
+
+// A number in [0, 16) that depends only on the calling thread, used to
+// spread counters over several cache lines. It is a hash of the address of
+// a thread-local variable; every module that uses this gets its own copy of
+// the variable, but that is still distinct for each thread.
+HEADER_SHIM unsigned _numerics_thread_stripe(void) {
+  static _Thread_local char marker;
+  unsigned long long a = (unsigned long long)(__UINTPTR_TYPE__)&marker;
+  return (unsigned)((a * 0x9E3779B97F4A7C15ull) >> 60);
+}
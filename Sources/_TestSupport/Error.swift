@@ -29,3 +29,134 @@ public func relativeError(_ tst: Complex<Float>, _ ref: Complex<Double>) -> Doub
   let error = (dtst - ref).magnitude
   return error / scale
 }
+
+/// Statistics of the errors of a batch of results.
+public struct ErrorStatistics {
+  /// The number of results.
+  public var count: Int
+
+  /// The largest error, or nan if any error is nan.
+  public var max: Double
+
+  /// The index of the first result with error `max`, or nil if every
+  /// error is zero.
+  public var argmax: Int?
+
+  /// The sum of the errors.
+  public var sum: Double
+
+  /// The mean error.
+  public var mean: Double { count == 0 ? 0 : sum / Double(count) }
+
+  @inlinable
+  public init() {
+    count = 0
+    max = 0
+    argmax = nil
+    sum = 0
+  }
+
+  // Accumulates error(i) for i in 0 ..< count. This is a single tight loop
+  // over the buffers, with no call per element once error is inlined.
+  @inlinable
+  internal init(count: Int, _ error: (Int) -> Double) {
+    self.init()
+    self.count = count
+    for i in 0 ..< count {
+      let e = error(i)
+      sum += e
+      // The second clause keeps the first nan, which compares false with
+      // everything.
+      if e > max || (e.isNaN && !max.isNaN) {
+        max = e
+        argmax = i
+      }
+    }
+  }
+}
+
+/// The relative errors of `tst[i]` with respect to `ref[i]`, as computed
+/// by `relativeError(_:_:)`, for every `i`.
+@inlinable
+public func relativeError(
+  _ tst: UnsafeBufferPointer<Float>,
+  _ ref: UnsafeBufferPointer<Double>
+) -> ErrorStatistics {
+  precondition(tst.count == ref.count, "tst and ref must have the same count.")
+  let least = Double(Float.leastNormalMagnitude)
+  return ErrorStatistics(count: tst.count) { i in
+    (Double(tst[i]) - ref[i]).magnitude / max(ref[i].magnitude, least)
+  }
+}
+
+/// The normwise relative errors of `tst[i]` with respect to `ref[i]`, as
+/// computed by `relativeError(_:_:)`, for every `i`.
+@inlinable
+public func relativeError(
+  _ tst: UnsafeBufferPointer<Complex<Float>>,
+  _ ref: UnsafeBufferPointer<Complex<Double>>
+) -> ErrorStatistics {
+  precondition(tst.count == ref.count, "tst and ref must have the same count.")
+  let least = Double(Float.leastNormalMagnitude)
+  return ErrorStatistics(count: tst.count) { i in
+    let dtst = Complex(Double(tst[i].real), Double(tst[i].imaginary))
+    return (dtst - ref[i]).magnitude / max(ref[i].magnitude, least)
+  }
+}
+
+/// The componentwise relative errors of `tst[i]` with respect to `ref[i]`,
+/// as computed by `componentwiseError(_:_:)`, for every `i`.
+@inlinable
+public func componentwiseError(
+  _ tst: UnsafeBufferPointer<Complex<Float>>,
+  _ ref: UnsafeBufferPointer<Complex<Double>>
+) -> ErrorStatistics {
+  precondition(tst.count == ref.count, "tst and ref must have the same count.")
+  let least = Double(Float.leastNormalMagnitude)
+  return ErrorStatistics(count: tst.count) { i in
+    let re = (Double(tst[i].real) - ref[i].real).magnitude /
+      max(ref[i].real.magnitude, least)
+    let im = (Double(tst[i].imaginary) - ref[i].imaginary).magnitude /
+      max(ref[i].imaginary.magnitude, least)
+    return max(re, im)
+  }
+}
+
+/// The number of representable values between `a` and `b`, counting one of
+/// the endpoints, or nil if either is nan.
+///
+/// This is exact, and is computed from the bit patterns: the finite values
+/// and infinities are mapped in order onto consecutive integers, with both
+/// zeros mapped to the same integer, so the distance between +0 and -0 is
+/// zero, and the distance from greatestFiniteMagnitude to infinity is one.
+@inlinable
+public func ulpDistance(_ a: Float, _ b: Float) -> UInt32? {
+  guard !a.isNaN && !b.isNaN else { return nil }
+  let ka = _orderedBits(a.bitPattern), kb = _orderedBits(b.bitPattern)
+  return ka > kb ? ka - kb : kb - ka
+}
+
+/// The number of representable values between `a` and `b`, counting one of
+/// the endpoints, or nil if either is nan.
+///
+/// This is exact, and is computed from the bit patterns: the finite values
+/// and infinities are mapped in order onto consecutive integers, with both
+/// zeros mapped to the same integer, so the distance between +0 and -0 is
+/// zero, and the distance from greatestFiniteMagnitude to infinity is one.
+@inlinable
+public func ulpDistance(_ a: Double, _ b: Double) -> UInt64? {
+  guard !a.isNaN && !b.isNaN else { return nil }
+  let ka = _orderedBits(a.bitPattern), kb = _orderedBits(b.bitPattern)
+  return ka > kb ? ka - kb : kb - ka
+}
+
+// Maps the sign-magnitude bit pattern of a non-nan value onto an unsigned
+// integer with the same order, centered so that both zeros map to the same
+// value; the magnitude of a non-nan value is less than half the range, so
+// this cannot overflow.
+@usableFromInline @_transparent
+internal func _orderedBits<T>(_ bits: T) -> T where T: FixedWidthInteger & UnsignedInteger {
+  let signBit = T(1) << (T.bitWidth - 1)
+  let magnitude = bits & ~signBit
+  return bits & signBit == 0 ? signBit + magnitude : signBit - magnitude
+}
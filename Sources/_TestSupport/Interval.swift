@@ -10,42 +10,97 @@
 //
 //===----------------------------------------------------------------------===//
 
-// A not-particularly-clever floating-point iterval that is iterable for the
-// purposes of testing.
-public struct Interval<Element>: Sequence where Element: FloatingPoint {
+// A closed interval of floating-point values, as a random-access collection
+// of every representable value it contains, in increasing order.
+//
+// Positions are computed by mapping each value to its ordered integer
+// representation (the bit pattern without the sign, negated for negative
+// values), so intervals can be counted, indexed and split in constant time;
+// this is what lets an exhaustive sweep over all 2^32 Floats be sharded
+// across threads or machines. Both zeros map to the same position, so an
+// interval contains zero once, as +0.
+//
+// The representation must fit in an Int, so Float80 is not supported.
+public struct Interval<Element>: RandomAccessCollection
+where Element: BinaryFloatingPoint {
+  
+  public let lower: Element
+  
+  public let upper: Element
   
-  let lower: Element
+  // The ordered integer representation of lower.
+  @usableFromInline
+  let base: Int
   
-  let upper: Element
+  public let count: Int
   
   public init(from: Element, through: Element) {
+    precondition(Element.exponentBitCount + Element.significandBitCount < Int.bitWidth,
+                 "Interval does not support types wider than Int.")
+    precondition(!from.isNaN && !through.isNaN, "Interval bounds must not be nan.")
     precondition(from <= through)
     lower = from
     upper = through
+    base = Interval.ordinal(from)
+    count = Interval.ordinal(through) - base + 1
   }
   
   public init(from: Element, to: Element) {
     self.init(from: from, through: to.nextDown)
   }
   
-  public func makeIterator() -> Iterator {
-    Iterator(self)
+  // The subinterval of the values at positions in range.
+  init(_ parent: Interval, _ range: Range<Int>) {
+    lower = parent[range.lowerBound]
+    upper = parent[range.upperBound - 1]
+    base = parent.base + range.lowerBound
+    count = range.count
   }
   
-  public struct Iterator: IteratorProtocol {
-    let interval: Interval
-    var nextOutput: Element?
-    
-    init(_ interval: Interval) {
-      self.interval = interval
-      self.nextOutput = interval.lower
-    }
-    
-    public mutating func next() -> Element? {
-      let result = nextOutput
-      if nextOutput == interval.upper { nextOutput = nil }
-      else { nextOutput = nextOutput?.nextUp }
-      return result
+  public var startIndex: Int { 0 }
+  
+  public var endIndex: Int { count }
+  
+  @inlinable
+  public subscript(position: Int) -> Element {
+    precondition(position >= 0 && position < count, "Index out of range.")
+    return Interval.element(base + position)
+  }
+  
+  /// Splits the interval into `n` consecutive subintervals whose counts
+  /// differ by at most one, or into `count` single values if there are
+  /// fewer than `n` of them.
+  ///
+  /// The subintervals are independent values, so `split(into: n)[i]` can be
+  /// handed to the i-th of n threads or machines.
+  public func split(into n: Int) -> [Interval] {
+    precondition(n > 0, "n must be positive.")
+    let pieces = Swift.min(n, count)
+    let (quotient, remainder) = count.quotientAndRemainder(dividingBy: pieces)
+    var start = 0
+    return (0 ..< pieces).map { i in
+      let end = start + quotient + (i < remainder ? 1 : 0)
+      defer { start = end }
+      return Interval(self, start ..< end)
     }
   }
+  
+  @inlinable
+  static func ordinal(_ x: Element) -> Int {
+    let magnitude = Int(truncatingIfNeeded: x.exponentBitPattern) << Element.significandBitCount
+                  | Int(truncatingIfNeeded: x.significandBitPattern)
+    return x.sign == .minus ? -magnitude : magnitude
+  }
+  
+  @inlinable
+  static func element(_ ordinal: Int) -> Element {
+    let magnitude = ordinal.magnitude
+    return Element(
+      sign: ordinal < 0 ? .minus : .plus,
+      exponentBitPattern: Element.RawExponent(magnitude >> Element.significandBitCount),
+      significandBitPattern: Element.RawSignificand(
+        truncatingIfNeeded: magnitude & (1 << Element.significandBitCount - 1)
+      )
+    )
+  }
 }
@@ -0,0 +1,147 @@
+//===--- Sweep.swift ------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import Dispatch
+import ComplexModule
+import RealModule
+
+/// The largest error seen so far, and the input that produced it.
+public struct WorstError<Input> {
+  /// The largest error recorded, or the threshold if no larger error has
+  /// been recorded.
+  public var error: Double
+
+  /// The input for which `error` was recorded, if any.
+  public var input: Input?
+
+  /// A record in which only errors larger than `threshold` are kept.
+  @inlinable
+  public init(threshold: Double = 0) {
+    error = threshold
+    input = nil
+  }
+
+  @inlinable
+  public mutating func record(_ error: Double, for input: Input) {
+    if error > self.error {
+      self.error = error
+      self.input = input
+    }
+  }
+
+  @inlinable
+  public mutating func merge(_ other: WorstError) {
+    if let input = other.input { record(other.error, for: input) }
+  }
+}
+
+/// A parallel driver for accuracy sweeps.
+///
+/// A sweep is divided into chunks, which are identified by their index and
+/// run concurrently on all available cores. Each chunk accumulates into its
+/// own state, so there is no shared mutable state while the sweep runs, and
+/// the states are merged when all the chunks have finished.
+///
+/// Chunks are handed out to worker threads as they become idle, so chunks
+/// of uneven cost balance out as long as there are many more chunks than
+/// cores; a few times the core count is usually plenty.
+public enum Sweep {
+  /// Runs `body` for every chunk in `0 ..< chunks`, each with its own copy
+  /// of `initial`, and returns the result of merging all the states in
+  /// chunk order.
+  @inlinable
+  public static func run<State>(
+    chunks: Int,
+    initial: State,
+    _ body: (_ chunk: Int, _ state: inout State) -> Void,
+    merge: (_ into: inout State, _ state: State) -> Void
+  ) -> State {
+    precondition(chunks >= 0, "chunks must not be negative.")
+    let states = UnsafeMutablePointer<State>.allocate(capacity: chunks)
+    defer { states.deallocate() }
+    DispatchQueue.concurrentPerform(iterations: chunks) { chunk in
+      var state = initial
+      body(chunk, &state)
+      (states + chunk).initialize(to: state)
+    }
+    var result = initial
+    for chunk in 0 ..< chunks { merge(&result, (states + chunk).move()) }
+    return result
+  }
+}
+
+/// The result of a complex accuracy sweep.
+public struct ComplexAccuracy<RealType> where RealType: Real {
+  /// The number of inputs tested.
+  public var count: Int
+
+  /// The largest error in the complex norm.
+  public var normwise: WorstError<Complex<RealType>>
+
+  /// The largest error in either component.
+  public var componentwise: WorstError<Complex<RealType>>
+
+  @inlinable
+  public init(threshold: Double) {
+    count = 0
+    normwise = WorstError(threshold: threshold)
+    componentwise = WorstError(threshold: threshold)
+  }
+
+  @inlinable
+  public mutating func merge(_ other: ComplexAccuracy) {
+    count += other.count
+    normwise.merge(other.normwise)
+    componentwise.merge(other.componentwise)
+  }
+}
+
+extension Sweep {
+  /// Sweeps `test` against the more precise `reference` over the inputs
+  /// generated by `inputs`, in parallel.
+  ///
+  /// - Parameters:
+  ///   - chunks: the number of chunks the inputs are divided into.
+  ///   - inputs: generates the inputs for the given chunk, passing each of
+  ///     them to `visit`.
+  ///   - test: the function under test.
+  ///   - reference: the reference implementation, which is given the test
+  ///     input and computes in a wider type.
+  ///
+  /// Errors are relative to the reference result, and errors smaller than
+  /// half an ulp of `T` are not recorded.
+  @inlinable
+  public static func accuracy<T, R>(
+    chunks: Int,
+    inputs: (_ chunk: Int, _ visit: (Complex<T>) -> Void) -> Void,
+    test: (Complex<T>) -> Complex<T>,
+    reference: (Complex<T>) -> Complex<R>
+  ) -> ComplexAccuracy<T>
+  where T: Real & BinaryFloatingPoint, R: Real & BinaryFloatingPoint {
+    let threshold = Double(T.ulpOfOne/2)
+    return run(chunks: chunks, initial: ComplexAccuracy<T>(threshold: threshold), { chunk, state in
+      inputs(chunk) { z in
+        state.count += 1
+        let tst = test(z)
+        let ref = reference(z)
+        let wide = Complex(R(tst.real), R(tst.imaginary))
+        if wide == ref { return }
+        let least = R(T.leastNormalMagnitude)
+        let norm = (wide - ref).magnitude / max(ref.magnitude, least)
+        state.normwise.record(Double(norm), for: z)
+        let re = (wide.real - ref.real).magnitude / max(ref.real.magnitude, least)
+        let im = (wide.imaginary - ref.imaginary).magnitude /
+          max(ref.imaginary.magnitude, least)
+        state.componentwise.record(Double(max(re, im)), for: z)
+      }
+    }, merge: { $0.merge($1) })
+  }
+}
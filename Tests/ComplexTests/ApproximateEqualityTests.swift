@@ -52,17 +52,39 @@ final class ApproximateEqualityTests: XCTestCase {
     testSpecials(relative: T(1))
   }
   
+  func testBuffers<T: Real>(_ type: T.Type) {
+    // Buffers of complex values are compared with the same norm as the
+    // scalar comparison, so infinities of either sign are equal.
+    let a: [Complex<T>] = [.zero, .infinity, Complex(1, 1), Complex(1, 2)]
+    let b: [Complex<T>] = [-.zero, -.infinity, Complex(1, 1 + T.ulpOfOne), Complex(2, 1)]
+    let report = a.withUnsafeBufferPointer { a in
+      b.withUnsafeBufferPointer { b in
+        ApproximateEqualityReport(comparing: a, to: b, relativeTolerance: 4 * T.ulpOfOne)
+      }
+    }
+    XCTAssertEqual(report.count, 4)
+    XCTAssertEqual(report.failures, 1)
+    XCTAssertEqual(report.firstFailure, 3)
+    XCTAssertEqual(report.ulpHistogram[0], 2)
+    XCTAssertEqual(report.maxAbsoluteError, 1)
+    XCTAssertEqual(report.maxAbsoluteErrorIndex, 3)
+    XCTAssertEqual(report.maxRelativeError, T(1)/2)
+  }
+  
   func testFloat() {
     testSpecials(Float.self)
+    testBuffers(Float.self)
   }
   
   func testDouble() {
     testSpecials(Double.self)
+    testBuffers(Double.self)
   }
   
   #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
   func testFloat80() {
     testSpecials(Float80.self)
+    testBuffers(Float80.self)
   }
   #endif
 }
@@ -203,4 +203,49 @@ final class ArithmeticTests: XCTestCase {
     XCTAssertFalse((Complex.infinity / Complex(0, 0)).isFinite)
     XCTAssertFalse((Complex.i / Complex(0, 0)).isFinite)
   }
+
+  func testFloatDivision() {
+    // Complex<Float> division is computed in Double; check it against
+    // Complex<Double> division, including operands of extreme scale that
+    // need rescaling in the generic implementation.
+    var g = SystemRandomNumberGenerator()
+    func random() -> Complex<Float> {
+      let scale = Float(sign: .plus, exponent: .random(in: -140 ... 120, using: &g), significand: 1)
+      return Complex(Float.random(in: -1 ... 1, using: &g) * scale,
+                     Float.random(in: -1 ... 1, using: &g) * scale)
+    }
+    for _ in 0 ..< 1000 {
+      let z = random()
+      let w = random()
+      let expected = Complex<Float>(Complex<Double>(z) / Complex<Double>(w))
+      let observed = z / w
+      XCTAssertLessThanOrEqual(relativeError(observed, expected), 1, "\(z) / \(w)")
+      var q = z
+      q /= w
+      XCTAssertEqual(q, observed)
+    }
+    // Zero and non-finite divisors keep the generic semantics.
+    XCTAssertFalse((Complex<Float>(1, 1) / .zero).isFinite)
+    XCTAssertFalse((Complex<Float>.zero / .zero).isFinite)
+    XCTAssertEqual(Complex<Float>(1, 1) / .infinity, .zero)
+    XCTAssertEqual(Complex<Float>.infinity / .infinity, .zero)
+    XCTAssertFalse((Complex<Float>.infinity / .one).isFinite)
+  }
+
+  func testPolynomial() {
+    // Small Gaussian integer coefficients at small integer points are
+    // evaluated exactly, both at a real point and at the same point as a
+    // complex number.
+    let p = Polynomial<Complex<Double>>(coefficients: [
+      Complex(1, -2), Complex(0, 3), Complex(-4, 0), Complex(5, 6), Complex(-1, 1)
+    ])
+    for x in -4 ... 4 {
+      let z = Complex(Double(x))
+      var expected = Complex<Double>.zero
+      for c in p.coefficients.reversed() { expected = expected * z + c }
+      XCTAssertEqual(p.evaluate(at: Double(x)), expected)
+      XCTAssertEqual(p.evaluate(at: z), expected)
+    }
+    XCTAssertEqual(Polynomial<Complex<Float>>(coefficients: []).evaluate(at: Float(1)), .zero)
+  }
 }
@@ -0,0 +1,296 @@
+//===--- BatchedArithmeticTests.swift -------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import ComplexModule
+import RealModule
+
+final class BatchedArithmeticTests: XCTestCase {
+
+  func randomValues<T: Real>(_ type: T.Type, count: Int) -> [Complex<T>]
+  where T: BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger {
+    var g = SystemRandomNumberGenerator()
+    return (0 ..< count).map { _ in
+      Complex(T.random(in: -4 ... 4, using: &g), T.random(in: -4 ... 4, using: &g))
+    }
+  }
+
+  func testDivideByScalar<T: Real>(_ type: T.Type)
+  where T: BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger {
+    let z = randomValues(T.self, count: 300) + [.zero, .infinity, Complex(.nan, 1)]
+    let divisors: [Complex<T>] = [
+      .one, .i, Complex(3, -4), Complex(1e-3, 7),
+      // Divisors that are not well-scaled, or not finite.
+      .zero, .infinity, Complex(.greatestFiniteMagnitude, 1),
+      Complex(.leastNonzeroMagnitude, 0)
+    ]
+    for w in divisors {
+      var observed = [Complex<T>](repeating: .zero, count: z.count)
+      z.withUnsafeBufferPointer { z in
+        observed.withUnsafeMutableBufferPointer {
+          Complex.divide(z, by: w, into: $0)
+        }
+      }
+      var inPlace = z
+      inPlace.withUnsafeMutableBufferPointer { Complex.divide($0, by: w) }
+      for i in z.indices {
+        let expected = z[i] / w
+        XCTAssertEqual(observed[i], inPlace[i])
+        XCTAssertLessThanOrEqual(relativeError(observed[i], expected), 4,
+                                 "\(z[i]) / \(w)")
+      }
+    }
+  }
+
+  func testDivideByScalar() {
+    testDivideByScalar(Float.self)
+    testDivideByScalar(Double.self)
+    #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+    testDivideByScalar(Float80.self)
+    #endif
+  }
+
+  func testDivideElementwise<T: Real>(_ type: T.Type)
+  where T: BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger {
+    let z = randomValues(T.self, count: 500)
+    var w = randomValues(T.self, count: 500)
+    // A few divisors that need rescaling; every other block of 64 is clean.
+    w[3] = Complex(.greatestFiniteMagnitude, 1)
+    w[200] = .zero
+    w[201] = Complex(.leastNonzeroMagnitude, .leastNormalMagnitude)
+    w[330] = .infinity
+    let expected = zip(z, w).map { $0 / $1 }
+    var observed = [Complex<T>](repeating: .zero, count: z.count)
+    z.withUnsafeBufferPointer { z in
+      w.withUnsafeBufferPointer { w in
+        observed.withUnsafeMutableBufferPointer {
+          Complex.divide(z, w, into: $0)
+        }
+      }
+    }
+    XCTAssertEqual(observed, expected)
+    // The result may be the same buffer as either operand.
+    var inPlace = z
+    inPlace.withUnsafeMutableBufferPointer { z in
+      w.withUnsafeBufferPointer { w in
+        Complex.divide(UnsafeBufferPointer(z), w, into: z)
+      }
+    }
+    XCTAssertEqual(inPlace, expected)
+    inPlace = w
+    inPlace.withUnsafeMutableBufferPointer { w in
+      z.withUnsafeBufferPointer { z in
+        Complex.divide(z, UnsafeBufferPointer(w), into: w)
+      }
+    }
+    XCTAssertEqual(inPlace, expected)
+  }
+
+  func testDivideElementwise() {
+    testDivideElementwise(Float.self)
+    testDivideElementwise(Double.self)
+    #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+    testDivideElementwise(Float80.self)
+    #endif
+    // Concrete Complex<Float> division is evaluated in Double; so is the
+    // concrete elementwise division.
+    let z = randomValues(Float.self, count: 500)
+    var w = randomValues(Float.self, count: 500)
+    w[3] = Complex(.greatestFiniteMagnitude, 1)
+    w[200] = .zero
+    w[330] = .infinity
+    let expected = zip(z, w).map { $0 / $1 }
+    var observed = [Complex<Float>](repeating: .zero, count: z.count)
+    z.withUnsafeBufferPointer { z in
+      w.withUnsafeBufferPointer { w in
+        observed.withUnsafeMutableBufferPointer {
+          Complex.divide(z, w, into: $0)
+        }
+      }
+    }
+    XCTAssertEqual(observed, expected)
+  }
+
+  func testDot<T: Real>(_ type: T.Type)
+  where T: BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger {
+    let x = randomValues(T.self, count: 203)
+    let y = randomValues(T.self, count: 203)
+    let naive = zip(x, y).reduce(Complex<T>.zero) { $0 + $1.0 * $1.1 }
+    let naiveConj = zip(x, y).reduce(Complex<T>.zero) { $0 + $1.0.conjugate * $1.1 }
+    x.withUnsafeBufferPointer { x in
+      y.withUnsafeBufferPointer { y in
+        for compensated in [false, true] {
+          let d = Complex.dot(x, y, compensated: compensated)
+          let c = Complex.conjugateDot(x, y, compensated: compensated)
+          XCTAssert(d.isApproximatelyEqual(to: naive, relativeTolerance: 1000 * .ulpOfOne))
+          XCTAssert(c.isApproximatelyEqual(to: naiveConj, relativeTolerance: 1000 * .ulpOfOne))
+        }
+        // The inner product of x with itself is real.
+        let normSquared = Complex.conjugateDot(x, x, compensated: true)
+        XCTAssertLessThanOrEqual(normSquared.imaginary.magnitude,
+                                 normSquared.real * .ulpOfOne)
+      }
+    }
+    // An ill-conditioned sum: the exact result is 1 + i, but the large
+    // terms cancel, so the uncompensated result loses it entirely.
+    let big = 4 / T.ulpOfOne
+    let a: [Complex<T>] = [Complex(big, 0), Complex(1, 1), Complex(-big, 0)]
+    let b: [Complex<T>] = [.one, .one, .one]
+    a.withUnsafeBufferPointer { a in
+      b.withUnsafeBufferPointer { b in
+        XCTAssertEqual(Complex.dot(a, b, compensated: true), Complex(1, 1))
+        XCTAssertEqual(Complex.conjugateDot(a, b, compensated: true), Complex(1, -1))
+      }
+    }
+    XCTAssertEqual(Complex<T>.dot(UnsafeBufferPointer(start: nil, count: 0),
+                                  UnsafeBufferPointer(start: nil, count: 0)), .zero)
+  }
+
+  func testDot() {
+    testDot(Float.self)
+    testDot(Double.self)
+    #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+    testDot(Float80.self)
+    #endif
+  }
+
+  func testAxpy<T: Real>(_ type: T.Type)
+  where T: BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger {
+    let a = Complex<T>(2, -1)
+    let x = randomValues(T.self, count: 100)
+    var y = randomValues(T.self, count: 100)
+    let expected = zip(x, y).map { a * $0 + $1 }
+    x.withUnsafeBufferPointer { x in
+      y.withUnsafeMutableBufferPointer { y in
+        Complex.axpy(a: a, x: x, y: y)
+      }
+    }
+    for i in y.indices {
+      XCTAssert(y[i].isApproximatelyEqual(to: expected[i], relativeTolerance: 8 * .ulpOfOne))
+      XCTAssert(Complex.multiplyAdd(a, x[i], .one).isApproximatelyEqual(
+        to: a * x[i] + .one, relativeTolerance: 8 * .ulpOfOne))
+    }
+  }
+
+  func testAxpy() {
+    testAxpy(Float.self)
+    testAxpy(Double.self)
+    #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+    testAxpy(Float80.self)
+    #endif
+  }
+
+  func testSum<T: Real>(_ type: T.Type)
+  where T: BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger {
+    let methods: [SummationMethod] = [.naive, .pairwise, .kahanBabuska, .doubleDouble]
+    // Gaussian integers are summed exactly by every method.
+    let z = (0 ..< 300).map { Complex<T>(T($0 % 7) - 3, T($0 % 11) - 5) }
+    let w = (0 ..< 300).map { Complex<T>(T($0 % 3), T($0 % 5) - 2) }
+    let sum = z.reduce(.zero, +)
+    let dot = zip(z, w).reduce(.zero) { $0 + $1.0 * $1.1 }
+    let conjugateDot = zip(z, w).reduce(.zero) { $0 + $1.0.conjugate * $1.1 }
+    let squares = z.reduce(.zero) { $0 + $1 * $1 }
+    let lengths = z.reduce(0) { $0 + $1.lengthSquared }
+    z.withUnsafeBufferPointer { z in
+      w.withUnsafeBufferPointer { w in
+        for method in methods {
+          XCTAssertEqual(Complex.sum(z, method: method), sum)
+          XCTAssertEqual(Complex.dot(z, w, method: method), dot)
+          XCTAssertEqual(Complex.conjugateDot(z, w, method: method), conjugateDot)
+          XCTAssertEqual(Complex.sum(ofSquares: z, method: method), squares)
+          XCTAssertEqual(Complex.sum(ofSquaredLengths: z, method: method), lengths)
+        }
+      }
+    }
+    XCTAssertEqual(Complex.sum(z.lazy.map { $0 }), sum)
+    XCTAssertEqual(Complex.sum(ofSquaredLengths: z.lazy.map { $0 }), lengths)
+    // Cancellation in both components.
+    let big = 4 / T.ulpOfOne
+    let c: [Complex<T>] = [Complex(big, -big), Complex(1, 2), Complex(-big, big)]
+    XCTAssertEqual(Complex.sum(c, method: .kahanBabuska), Complex(1, 2))
+    XCTAssertEqual(Complex.sum(c, method: .doubleDouble), Complex(1, 2))
+  }
+
+  func testSum() {
+    testSum(Float.self)
+    testSum(Double.self)
+    #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+    testSum(Float80.self)
+    #endif
+  }
+
+  func testPolar<T: Real>(_ type: T.Type)
+  where T: BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger {
+    var g = SystemRandomNumberGenerator()
+    // Values of many scales, and values on the axes, on the diagonals and
+    // where the argument reduction switches intervals, along with the edge
+    // cases. The count spans several blocks.
+    let scaled = (0 ..< 300).map { _ -> Complex<T> in
+      Complex(length: .exp2(T.random(in: -40 ... 40, using: &g)),
+              phase: T.random(in: -.pi ... .pi, using: &g))
+    }
+    let tanPiOver8 = T.sqrt(2) - 1
+    let specials: [Complex<T>] = [
+      .zero, Complex(-0.0, 0), Complex(0, -0.0), .infinity, Complex(.nan, 1),
+      Complex(1, 0), Complex(-1, 0), Complex(-1, -0.0), Complex(0, 1),
+      Complex(-0.0, -1), Complex(1, 1), Complex(-1, 1), Complex(-1, -1),
+      Complex(1, tanPiOver8), Complex(-tanPiOver8, 1),
+      Complex(.greatestFiniteMagnitude, .greatestFiniteMagnitude),
+      Complex(-.greatestFiniteMagnitude, 1),
+      Complex(.leastNonzeroMagnitude, -.leastNormalMagnitude),
+    ]
+    let z = randomValues(T.self, count: 300) + scaled + specials
+    var lengths = [T](repeating: 0, count: z.count)
+    var phases = [T](repeating: 0, count: z.count)
+    z.withUnsafeBufferPointer { z in
+      lengths.withUnsafeMutableBufferPointer { lengths in
+        phases.withUnsafeMutableBufferPointer { phases in
+          Complex.toPolar(z, lengths: lengths, phases: phases)
+        }
+      }
+    }
+    for i in z.indices {
+      let expected = z[i].phase
+      XCTAssertEqual(lengths[i], z[i].length, "length of \(z[i])")
+      if expected.isNaN {
+        XCTAssert(phases[i].isNaN, "phase of \(z[i]): \(phases[i])")
+      } else {
+        XCTAssert(phases[i].sign == expected.sign &&
+                  closeEnough(phases[i], expected, ulps: 4),
+                  "phase of \(z[i]): \(phases[i]) != \(expected)")
+      }
+    }
+    // Zero and infinite lengths may have any phase.
+    let r = lengths + [0, 0, .infinity, -2]
+    let θ = phases.map { $0.isNaN ? 1 : $0 } + [.nan, .infinity, .nan, 1]
+    var w = [Complex<T>](repeating: .zero, count: r.count)
+    r.withUnsafeBufferPointer { r in
+      θ.withUnsafeBufferPointer { θ in
+        w.withUnsafeMutableBufferPointer {
+          Complex.fromPolar(lengths: r, phases: θ, into: $0)
+        }
+      }
+    }
+    for i in r.indices {
+      let expected = Complex(length: r[i], phase: θ[i])
+      XCTAssert(w[i] == expected || relativeError(w[i], expected) <= 4,
+                "Complex(length: \(r[i]), phase: \(θ[i])): \(w[i]) != \(expected)")
+    }
+  }
+
+  func testPolar() {
+    testPolar(Float.self)
+    testPolar(Double.self)
+    #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+    testPolar(Float80.self)
+    #endif
+  }
+}
@@ -0,0 +1,93 @@
+//===--- BinaryRepresentationTests.swift ----------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import ComplexModule
+import RealModule
+
+final class BinaryRepresentationTests: XCTestCase {
+
+  func testLayout<T: Real & BinaryFloatingPoint>(_ type: T.Type) {
+    XCTAssertEqual(MemoryLayout<Complex<T>>.size, 2 * MemoryLayout<T>.size)
+    XCTAssertEqual(MemoryLayout<Complex<T>>.stride, 2 * MemoryLayout<T>.stride)
+    XCTAssertEqual(MemoryLayout<Complex<T>>.alignment, MemoryLayout<T>.alignment)
+    var z: [Complex<T>] = [Complex(1, 2), Complex(3, 4), Complex(.infinity, .nan)]
+    z.withUnsafeBufferPointer { z in
+      Complex.withUnsafeComponents(of: z) { x in
+        XCTAssertEqual(x.count, 6)
+        XCTAssertEqual(Array(x[0 ..< 4]), [1, 2, 3, 4])
+        XCTAssertEqual(x[4], .infinity)
+        XCTAssert(x[5].isNaN)
+        XCTAssertEqual(UnsafeRawPointer(x.baseAddress), UnsafeRawPointer(z.baseAddress))
+      }
+    }
+    z.withUnsafeMutableBufferPointer { z in
+      Complex.withUnsafeMutableComponents(of: z) { x in x[5] = 6 }
+    }
+    // Complex == does not distinguish non-finite values, so compare the
+    // components.
+    XCTAssertEqual(z[2].real, .infinity)
+    XCTAssertEqual(z[2].imaginary, 6)
+    // Raw bytes, viewed in place and copied back into an array.
+    let bytes = z.withUnsafeBytes { [UInt8]($0) }
+    z.withUnsafeBytes { raw in
+      Complex<T>.withUnsafeBuffer(overBytes: raw) { view in
+        XCTAssertEqual(Array(view), z)
+        XCTAssertEqual(UnsafeRawPointer(view.baseAddress), raw.baseAddress)
+      }
+    }
+    bytes.withUnsafeBytes {
+      XCTAssertEqual([Complex<T>](unsafeComplexBytes: $0), z)
+    }
+    // The initializer does not need aligned bytes.
+    let unaligned = [0] + bytes
+    unaligned.withUnsafeBytes {
+      let raw = UnsafeRawBufferPointer(rebasing: $0.dropFirst())
+      XCTAssertEqual([Complex<T>](unsafeComplexBytes: raw), z)
+    }
+    [UInt8]().withUnsafeBytes {
+      XCTAssertEqual([Complex<T>](unsafeComplexBytes: $0), [])
+      Complex<T>.withUnsafeBuffer(overBytes: $0) { XCTAssertEqual($0.count, 0) }
+    }
+  }
+
+  func testLayout() {
+    testLayout(Float.self)
+    testLayout(Double.self)
+  }
+
+  func testEncoding<T: Real & BinaryFloatingPoint>(_ type: T.Type) {
+    let z = (0 ..< 1000).map { Complex(T($0) / 7, -T($0) / 3) } +
+      [.zero, .infinity, Complex(-.zero, 1)]
+    let bytes = Complex.encoded(z)
+    XCTAssertEqual(bytes.count, Complex<T>.encodedByteCount(count: z.count))
+    let decoded = bytes.withUnsafeBytes { Complex<T>.decoded($0) }
+    XCTAssertEqual(decoded, z)
+    XCTAssertEqual(decoded.last!.real.sign, .minus)
+    // Decoding does not need aligned bytes either.
+    let unaligned = [0] + bytes
+    unaligned.withUnsafeBytes {
+      let raw = UnsafeRawBufferPointer(rebasing: $0.dropFirst())
+      XCTAssertEqual(Complex<T>.decoded(raw), z)
+    }
+    XCTAssertEqual(Complex<T>.encoded([]), [])
+  }
+
+  func testEncoding() {
+    testEncoding(Float.self)
+    testEncoding(Double.self)
+    // The encoding is little-endian IEEE 754, whatever the host.
+    XCTAssertEqual(Complex.encoded([Complex<Float>(1, -2)]),
+                   [0x00, 0x00, 0x80, 0x3f, 0x00, 0x00, 0x00, 0xc0])
+    XCTAssertEqual(Complex.encoded([Complex<Double>(1, -2)]),
+                   [0, 0, 0, 0, 0, 0, 0xf0, 0x3f, 0, 0, 0, 0, 0, 0, 0, 0xc0])
+  }
+}
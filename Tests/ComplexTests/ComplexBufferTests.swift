@@ -0,0 +1,154 @@
+//===--- ComplexBufferTests.swift -----------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import ComplexModule
+import RealModule
+import _TestSupport
+
+final class ComplexBufferTests: XCTestCase {
+
+  // A mix of well-scaled values and values that need careful handling in
+  // division: zero, infinity, nan, and very large and very small values.
+  func values<T>(_ type: T.Type, count: Int) -> [Complex<T>]
+  where T: Real & FixedWidthFloatingPoint {
+    var g = SystemRandomNumberGenerator()
+    let specials: [Complex<T>] = [
+      .zero, .one, .i, .infinity, Complex(.nan, 1),
+      Complex(.greatestFiniteMagnitude, .greatestFiniteMagnitude),
+      Complex(.leastNonzeroMagnitude, -.leastNormalMagnitude),
+      Complex(1, .ulpOfOne)
+    ]
+    return (0 ..< count).map {
+      if $0 % 16 < specials.count && $0 % 3 == 0 { return specials[$0 % 16] }
+      return Complex(T.random(in: -4 ... 4, using: &g),
+                     T.random(in: -4 ... 4, using: &g))
+    }
+  }
+
+  func testConversions<T: Real & FixedWidthFloatingPoint>(_ type: T.Type) {
+    let z = values(T.self, count: 100)
+    let buffer = ComplexBuffer(z)
+    XCTAssertEqual(buffer.count, z.count)
+    XCTAssertEqual(buffer.real.count, z.count)
+    XCTAssertEqual(buffer.imaginary.count, z.count)
+    XCTAssertEqual(Array(buffer), z)
+    XCTAssert(buffer.elementsEqual(z))
+    // A sequence without contiguous storage takes the slow path.
+    XCTAssertEqual(ComplexBuffer(z.lazy.map { $0 }), buffer)
+    XCTAssertEqual(ComplexBuffer<T>(), [])
+    XCTAssertEqual(Array(ComplexBuffer<T>()), [])
+    var mutated = buffer
+    mutated[3] = .i
+    XCTAssertEqual(mutated[3], .i)
+    XCTAssertNotEqual(buffer[3], .i)
+    mutated.append(.one)
+    XCTAssertEqual(mutated.last, .one)
+    XCTAssertEqual(ComplexBuffer(repeating: Complex<T>(1, 2), count: 3),
+                   [Complex(1, 2), Complex(1, 2), Complex(1, 2)])
+  }
+
+  func testConversions() {
+    testConversions(Float.self)
+    testConversions(Double.self)
+    #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+    testConversions(Float80.self)
+    #endif
+  }
+
+  func testArithmetic<T: Real & FixedWidthFloatingPoint>(_ type: T.Type) {
+    let a = values(T.self, count: 200)
+    let b = values(T.self, count: 200).reversed()
+    let x = ComplexBuffer(a)
+    let y = ComplexBuffer(b)
+    // Every elementwise operation must give exactly the scalar result.
+    XCTAssertEqual(Array(x + y), zip(a, b).map { $0 + $1 })
+    XCTAssertEqual(Array(x - y), zip(a, b).map { $0 - $1 })
+    XCTAssertEqual(Array(x * y), zip(a, b).map { $0 * $1 })
+    XCTAssertEqual(Array(x / y), zip(a, b).map { $0 / $1 })
+    XCTAssertEqual(Array(x.conjugate), a.map { $0.conjugate })
+    XCTAssertEqual(x.magnitude, a.map { $0.magnitude })
+    XCTAssert(zip(x.lengthSquared, a.map { $0.lengthSquared }).allSatisfy {
+      $0 == $1 || $0.isNaN && $1.isNaN
+    })
+    var z = x
+    z += y
+    XCTAssertEqual(z, x + y)
+    z = x
+    z -= y
+    XCTAssertEqual(z, x - y)
+    z = x
+    z *= y
+    XCTAssertEqual(z, x * y)
+    z = x
+    z /= y
+    XCTAssertEqual(z, x / y)
+    // Operating on a buffer with itself.
+    z = x
+    z *= z
+    XCTAssertEqual(z, x * x)
+  }
+
+  func testArithmetic() {
+    testArithmetic(Float.self)
+    testArithmetic(Double.self)
+    #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+    testArithmetic(Float80.self)
+    #endif
+    // Concrete Complex<Float> division is evaluated in Double; so is
+    // concrete ComplexBuffer<Float> division.
+    let a = values(Float.self, count: 200)
+    let b = values(Float.self, count: 200).reversed()
+    let expected = zip(a, b).map { $0 / $1 }
+    var x = ComplexBuffer(a)
+    XCTAssertEqual(Array(x / ComplexBuffer(b)), expected)
+    x /= ComplexBuffer(b)
+    XCTAssertEqual(Array(x), expected)
+  }
+
+  func testElementaryFunctions<T: Real & FixedWidthFloatingPoint>(_ type: T.Type) {
+    // Points near the unit circle, where log needs extra care, in addition
+    // to the usual mix.
+    var g = SystemRandomNumberGenerator()
+    let circle = (0 ..< 64).map { _ -> Complex<T> in
+      Complex(length: 1 + T.random(in: -0.01 ... 0.01, using: &g),
+              phase: T.random(in: -.pi ... .pi, using: &g))
+    }
+    let a = values(T.self, count: 200) + circle + [Complex(800, 1), Complex(-800, 1)]
+    let x = ComplexBuffer(a)
+    func same(_ u: T, _ v: T) -> Bool { u == v || u.isNaN && v.isNaN }
+    // length, phase and sqrt give exactly the scalar results.
+    XCTAssert(zip(x.length, a.map { $0.length }).allSatisfy(same))
+    XCTAssert(zip(x.phase, a.map { $0.phase }).allSatisfy(same))
+    XCTAssertEqual(Array(ComplexBuffer.sqrt(x)), a.map { Complex.sqrt($0) })
+    // exp and log use the batched real kernels, which may differ slightly
+    // from the scalar functions.
+    for (w, z) in zip(ComplexBuffer.exp(x), a) {
+      let expected = Complex.exp(z)
+      XCTAssert(w == expected || relativeError(w, expected) <= 8,
+                "exp(\(z)): \(w) != \(expected)")
+    }
+    for (w, z) in zip(ComplexBuffer.log(x), a) {
+      let expected = Complex.log(z)
+      XCTAssert(w == expected || relativeError(w, expected) <= 8,
+                "log(\(z)): \(w) != \(expected)")
+    }
+    XCTAssertEqual(Array(ComplexBuffer.exp(ComplexBuffer<T>())), [])
+  }
+
+  func testElementaryFunctions() {
+    testElementaryFunctions(Float.self)
+    testElementaryFunctions(Double.self)
+    #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+    testElementaryFunctions(Float80.self)
+    #endif
+  }
+}
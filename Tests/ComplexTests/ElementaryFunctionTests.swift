@@ -400,6 +400,133 @@ final class ElementaryFunctionTests: XCTestCase {
     }
   }
   
+  func testPow<T: Real & FixedWidthFloatingPoint>(_ type: T.Type) {
+    // Small integer powers are computed by repeated squaring; products of
+    // small Gaussian integers are exact.
+    let z = Complex<T>(1, 1)
+    XCTAssertEqual(Complex.pow(z, 0), .one)
+    XCTAssertEqual(Complex.pow(z, 1), z)
+    XCTAssertEqual(Complex.pow(z, 2), Complex(0, 2))
+    XCTAssertEqual(Complex.pow(z, 3), Complex(-2, 2))
+    XCTAssertEqual(Complex.pow(z, 4), Complex(-4, 0))
+    XCTAssertEqual(Complex.pow(z, 17), Complex(256, 256))
+    XCTAssertEqual(Complex.pow(z, 17, compensated: true), Complex(256, 256))
+    XCTAssertEqual(Complex.pow(Complex<T>.i, -1), -.i)
+    XCTAssertEqual(Complex.pow(Complex<T>(2, 0), -3), Complex(0.125, 0))
+    XCTAssertEqual(Complex.pow(Complex<T>.zero, 3), .zero)
+    XCTAssertFalse(Complex.pow(Complex<T>(.greatestFiniteMagnitude, 1), 3).isFinite)
+    XCTAssertFalse(Complex.pow(Complex<T>.infinity, 2).isFinite)
+    // For random values, the plain and compensated results agree to within
+    // the error bound of the plain one, which grows with n.
+    var g = SystemRandomNumberGenerator()
+    for _ in 0 ..< 1000 {
+      let z = Complex(T.random(in: -2 ... 2, using: &g),
+                      T.random(in: -2 ... 2, using: &g))
+      let n = Int.random(in: -64 ... 64, using: &g)
+      let plain = Complex.pow(z, n)
+      let compensated = Complex.pow(z, n, compensated: true)
+      guard compensated.isNormal else { continue }
+      let allowed = 4 * T(n.magnitude + 1)
+      if relativeError(plain, compensated) > allowed {
+        print("pow(\(z), \(n)) was \(plain), compensated \(compensated).")
+        XCTFail()
+      }
+    }
+  }
+  
+  func testRoot<T: Real & FixedWidthFloatingPoint>(_ type: T.Type) {
+    // Even roots are repeated square roots, which are exact here.
+    XCTAssertEqual(Complex.root(Complex<T>(-4, 0), 2), Complex(0, 2))
+    XCTAssertEqual(Complex.root(Complex<T>(16, 0), 4), Complex(2, 0))
+    XCTAssertEqual(Complex.root(Complex<T>(16, 0), -4), Complex(0.5, 0))
+    XCTAssertEqual(Complex.root(Complex<T>.zero, 3), .zero)
+    XCTAssertEqual(Complex.roots(of: Complex<T>.one, count: 4), [1, .i, -1, -.i])
+    XCTAssertEqual(Complex.roots(of: Complex<T>.zero, count: 3), [.zero, .zero, .zero])
+    XCTAssertFalse(Complex.root(Complex<T>.infinity, 3).isFinite)
+    // A huge value whose length overflows.
+    let big = Complex<T>(.greatestFiniteMagnitude, .greatestFiniteMagnitude)
+    XCTAssert(Complex.root(big, 3).isFinite)
+    // For random values, the nth power of the root is z, and the root is the
+    // principal one, as computed by exp(log(z)/n).
+    var g = SystemRandomNumberGenerator()
+    for _ in 0 ..< 1000 {
+      let z = Complex(T.random(in: -2 ... 2, using: &g),
+                      T.random(in: -2 ... 2, using: &g))
+      let n = Int.random(in: 1 ... 16, using: &g) * (Bool.random(using: &g) ? 1 : -1)
+      let w = Complex.root(z, n)
+      let u = Complex.pow(w, n, compensated: true)
+      if !u.isApproximatelyEqual(to: z) {
+        print("pow(root(\(z), \(n)), \(n)) was \(u).")
+        XCTFail()
+      }
+      if !w.isApproximatelyEqual(to: .exp(Complex.log(z) / Complex(T(n)))) {
+        print("root(\(z), \(n)) = \(w) was not the principal root.")
+        XCTFail()
+      }
+      // And every member of roots(of:count:) is a root.
+      for w in Complex.roots(of: z, count: 5) {
+        XCTAssert(Complex.pow(w, 5, compensated: true).isApproximatelyEqual(to: z))
+      }
+    }
+  }
+  
+  func testFloatPow() {
+    // The compensated result should be very nearly correctly rounded;
+    // compare it with the Complex<Double> result.
+    var g = SystemRandomNumberGenerator()
+    for _ in 0 ..< 1000 {
+      let z = Complex(Float.random(in: -2 ... 2, using: &g),
+                      Float.random(in: -2 ... 2, using: &g))
+      let n = Int.random(in: -64 ... 64, using: &g)
+      let expected = Complex.pow(Complex<Double>(z), n, compensated: true)
+      let reference = Complex(Float(expected.real), Float(expected.imaginary))
+      guard reference.isNormal else { continue }
+      let observed = Complex.pow(z, n, compensated: true)
+      if relativeError(observed, reference) > 2 {
+        print("pow(\(z), \(n)) was \(observed), expected \(reference).")
+        XCTFail()
+      }
+    }
+  }
+  
+  func testFloatLog() {
+    // Complex<Float> log and log(onePlus:) are computed in Double; compare
+    // them with the Complex<Double> implementations, rounded to Float.
+    var g = SystemRandomNumberGenerator()
+    var values: [Complex<Float>] = (0 ..< 1000).map { _ in
+      Complex(Float.random(in: -2 ... 2, using: &g),
+              Float.random(in: -2 ... 2, using: &g))
+    }
+    // Points close to the unit circle, where cancellation is a problem.
+    values += (0 ..< 1000).map { _ in
+      let θ = Float.random(in: -.pi ... .pi, using: &g)
+      return Complex(length: 1, phase: θ)
+    }
+    values += [Complex(1, 0x1p-20), Complex(-1, 0x1p-30), Complex(0x1p-149, 0),
+               Complex(.greatestFiniteMagnitude, .greatestFiniteMagnitude)]
+    func check(_ name: String, _ z: Complex<Float>,
+               _ observed: Complex<Float>, _ expected: Complex<Double>) {
+      // The real part is checked on its own, because near the unit circle
+      // it is much smaller than the imaginary part.
+      let real = Float(expected.real)
+      XCTAssert(closeEnough(observed.real, real, ulps: 2),
+                "\(name)(\(z)): \(observed.real) vs \(real)")
+      XCTAssert(closeEnough(observed.imaginary, Float(expected.imaginary), ulps: 2),
+                "\(name)(\(z)): \(observed.imaginary) vs \(Float(expected.imaginary))")
+    }
+    for z in values {
+      check("log", z, .log(z), .log(Complex<Double>(z)))
+      // log(onePlus:) is most interesting for small z.
+      let w = Complex(z.real/4 - 0.25, z.imaginary/4)
+      check("log(onePlus:)", w, .log(onePlus: w), .log(onePlus: Complex<Double>(w)))
+    }
+    XCTAssertFalse(Complex<Float>.log(.zero).isFinite)
+    XCTAssertFalse(Complex<Float>.log(.infinity).isFinite)
+    XCTAssertFalse(Complex<Float>.log(onePlus: -1).isFinite)
+    XCTAssertFalse(Complex<Float>.log(onePlus: .infinity).isFinite)
+    XCTAssertEqual(Complex<Float>.log(onePlus: .zero), .zero)
+  }
+  
   func testFloat() {
     testExp(Float.self)
     testExpMinusOne(Float.self)
@@ -411,6 +538,8 @@ final class ElementaryFunctionTests: XCTestCase {
     testAcosh(Float.self)
     testAsinh(Float.self)
     testAtanh(Float.self)
+    testPow(Float.self)
+    testRoot(Float.self)
   }
   
   func testDouble() {
@@ -424,6 +553,8 @@ final class ElementaryFunctionTests: XCTestCase {
     testAcosh(Double.self)
     testAsinh(Double.self)
     testAtanh(Double.self)
+    testPow(Double.self)
+    testRoot(Double.self)
   }
   
   #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
@@ -438,6 +569,8 @@ final class ElementaryFunctionTests: XCTestCase {
     testAcosh(Float80.self)
     testAsinh(Float80.self)
     testAtanh(Float80.self)
+    testPow(Float80.self)
+    testRoot(Float80.self)
   }
   #endif
 }
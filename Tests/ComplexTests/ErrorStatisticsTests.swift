@@ -0,0 +1,111 @@
+//===--- ErrorStatisticsTests.swift ---------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import ComplexModule
+import _TestSupport
+
+final class ErrorStatisticsTests: XCTestCase {
+
+  func testUlpDistance() {
+    // Float
+    XCTAssertEqual(ulpDistance(Float(1), 1), 0)
+    XCTAssertEqual(ulpDistance(Float(1), Float(1).nextUp), 1)
+    XCTAssertEqual(ulpDistance(Float(1).nextUp, 1), 1)
+    XCTAssertEqual(ulpDistance(Float(1), 2), 1 << 23)
+    XCTAssertEqual(ulpDistance(Float.zero, -.zero), 0)
+    XCTAssertEqual(ulpDistance(Float.zero, .leastNonzeroMagnitude), 1)
+    XCTAssertEqual(ulpDistance(-Float.zero, .leastNonzeroMagnitude), 1)
+    XCTAssertEqual(ulpDistance(-Float.leastNonzeroMagnitude, .leastNonzeroMagnitude), 2)
+    XCTAssertEqual(ulpDistance(-Float(1), 1), 2 * Float(1).bitPattern)
+    XCTAssertEqual(ulpDistance(Float.leastNonzeroMagnitude, 2 * .leastNonzeroMagnitude), 1)
+    XCTAssertEqual(ulpDistance(Float.leastNormalMagnitude.nextDown, .leastNormalMagnitude), 1)
+    XCTAssertEqual(ulpDistance(Float.greatestFiniteMagnitude, .infinity), 1)
+    XCTAssertEqual(ulpDistance(-Float.infinity, -.greatestFiniteMagnitude), 1)
+    XCTAssertEqual(ulpDistance(-Float.infinity, .infinity), 0xff00_0000)
+    XCTAssertNil(ulpDistance(Float.nan, 1))
+    XCTAssertNil(ulpDistance(Float(1), .nan))
+    XCTAssertNil(ulpDistance(Float.nan, .nan))
+    XCTAssertNil(ulpDistance(Float.infinity, -.nan))
+    // Double
+    XCTAssertEqual(ulpDistance(Double(1), 1), 0)
+    XCTAssertEqual(ulpDistance(Double(1), Double(1).nextUp), 1)
+    XCTAssertEqual(ulpDistance(Double(1), 2), 1 << 52)
+    XCTAssertEqual(ulpDistance(Double.zero, -.zero), 0)
+    XCTAssertEqual(ulpDistance(Double.zero, .leastNonzeroMagnitude), 1)
+    XCTAssertEqual(ulpDistance(-Double.leastNonzeroMagnitude, .leastNonzeroMagnitude), 2)
+    XCTAssertEqual(ulpDistance(-Double(1), 1), 2 * Double(1).bitPattern)
+    XCTAssertEqual(ulpDistance(Double.leastNonzeroMagnitude, 2 * .leastNonzeroMagnitude), 1)
+    XCTAssertEqual(ulpDistance(Double.leastNormalMagnitude.nextDown, .leastNormalMagnitude), 1)
+    XCTAssertEqual(ulpDistance(Double.greatestFiniteMagnitude, .infinity), 1)
+    XCTAssertEqual(ulpDistance(-Double.infinity, -.greatestFiniteMagnitude), 1)
+    XCTAssertEqual(ulpDistance(-Double.infinity, .infinity), 0xffe0_0000_0000_0000)
+    XCTAssertNil(ulpDistance(Double.nan, 1))
+    XCTAssertNil(ulpDistance(Double(1), .nan))
+    XCTAssertNil(ulpDistance(Double.infinity, -.nan))
+  }
+
+  func testStatistics() {
+    func errors(_ tst: [Float], _ ref: [Double]) -> ErrorStatistics {
+      tst.withUnsafeBufferPointer { t in
+        ref.withUnsafeBufferPointer { relativeError(t, $0) }
+      }
+    }
+    let empty = errors([], [])
+    XCTAssertEqual(empty.count, 0)
+    XCTAssertEqual(empty.max, 0)
+    XCTAssertNil(empty.argmax)
+    XCTAssertEqual(empty.mean, 0)
+    let exact = errors([1, -2, 0], [1, -2, 0])
+    XCTAssertEqual(exact.count, 3)
+    XCTAssertEqual(exact.max, 0)
+    XCTAssertNil(exact.argmax)
+    XCTAssertEqual(exact.mean, 0)
+    // The first of several equal largest errors is reported.
+    let s = errors([1, 3, 2, 4], [1, 2, 1, 2])
+    XCTAssertEqual(s.count, 4)
+    XCTAssertEqual(s.max, 1)
+    XCTAssertEqual(s.argmax, 2)
+    XCTAssertEqual(s.sum, 2.5)
+    XCTAssertEqual(s.mean, 0.625)
+    // Errors with respect to zero are scaled by the least normal magnitude,
+    // as in the scalar relativeError.
+    let tiny = errors([.leastNormalMagnitude], [0])
+    XCTAssertEqual(tiny.max, 1)
+    XCTAssertEqual(tiny.max, relativeError(.leastNormalMagnitude, 0))
+    // The first nan is kept, even if a larger error follows it.
+    let nan = errors([2, .nan, 1, 8], [1, 1, .nan, 1])
+    XCTAssert(nan.max.isNaN)
+    XCTAssertEqual(nan.argmax, 1)
+    XCTAssert(nan.mean.isNaN)
+  }
+
+  func testComplexStatistics() {
+    let tst: [Complex<Float>] = [Complex(1, 1), Complex(3, 0), Complex(1, 2)]
+    let ref: [Complex<Double>] = [Complex(1, 1), Complex(4, 0), Complex(1, 1)]
+    let normwise = tst.withUnsafeBufferPointer { t in
+      ref.withUnsafeBufferPointer { relativeError(t, $0) }
+    }
+    XCTAssertEqual(normwise.count, 3)
+    XCTAssertEqual(normwise.argmax, 2)
+    XCTAssertEqual(normwise.max, relativeError(tst[2], ref[2]))
+    XCTAssertEqual(normwise.sum, 0.25 + relativeError(tst[2], ref[2]))
+    let componentwise = tst.withUnsafeBufferPointer { t in
+      ref.withUnsafeBufferPointer { componentwiseError(t, $0) }
+    }
+    XCTAssertEqual(componentwise.argmax, 2)
+    XCTAssertEqual(componentwise.max, 1)
+    XCTAssertEqual(componentwise.sum, 1.25)
+    for i in tst.indices {
+      XCTAssertGreaterThanOrEqual(componentwise.max, componentwiseError(tst[i], ref[i]))
+    }
+  }
+}
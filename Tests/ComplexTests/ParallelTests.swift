@@ -0,0 +1,100 @@
+//===--- ParallelTests.swift ----------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+#if canImport(Dispatch)
+import XCTest
+import ComplexModule
+import RealModule
+
+// The pairwise combination of the chunk sums, as Parallel.sum does it.
+fileprivate func combinePairwise<T>(_ z: ArraySlice<Complex<T>>) -> Complex<T> {
+  if z.count <= 1 { return z.first ?? .zero }
+  let mid = z.startIndex + z.count/2
+  return combinePairwise(z[..<mid]) + combinePairwise(z[mid...])
+}
+
+final class ParallelTests: XCTestCase {
+
+  func testReductions<T: Real>(_ type: T.Type)
+  where T: BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger {
+    let methods: [SummationMethod] = [.naive, .pairwise, .kahanBabuska, .doubleDouble]
+    let chunkSize = 1000
+    // Gaussian integers are summed exactly by every method. The count is not
+    // a multiple of the chunk size.
+    let n = 50_001
+    let z = (0 ..< n).map { Complex<T>(T($0 % 17) - 8, T($0 % 13) - 6) }
+    let w = (0 ..< n).map { Complex<T>(T($0 % 5), T($0 % 7) - 3) }
+    z.withUnsafeBufferPointer { z in
+      w.withUnsafeBufferPointer { w in
+        for method in methods {
+          XCTAssertEqual(Parallel.sum(z, method: method, chunkSize: chunkSize),
+                         Complex.sum(z))
+          XCTAssertEqual(Parallel.dot(z, w, method: method, chunkSize: chunkSize),
+                         Complex.dot(z, w, method: .pairwise))
+          XCTAssertEqual(Parallel.conjugateDot(z, w, method: method,
+                                               chunkSize: chunkSize),
+                         Complex.conjugateDot(z, w, method: .pairwise))
+          XCTAssertEqual(Parallel.sum(ofSquaredLengths: z, method: method,
+                                      chunkSize: chunkSize),
+                         Complex.sum(ofSquaredLengths: z))
+        }
+      }
+    }
+    XCTAssertEqual([Complex<T>]().withUnsafeBufferPointer { Parallel.sum($0) },
+                   .zero)
+    // Results do not depend on scheduling: repeated reductions are
+    // identical, and the pairwise sum is the pairwise combination of the
+    // serial chunk sums.
+    var g = SystemRandomNumberGenerator()
+    let x = (0 ..< 100_000).map { _ in
+      Complex(T.random(in: -8 ... 8, using: &g), T.random(in: -8 ... 8, using: &g))
+    }
+    x.withUnsafeBufferPointer { x in
+      for method in methods {
+        let sum = Parallel.sum(x, method: method, chunkSize: chunkSize)
+        let dot = Parallel.dot(x, x, method: method, chunkSize: chunkSize)
+        let conjugateDot = Parallel.conjugateDot(x, x, method: method,
+                                                 chunkSize: chunkSize)
+        let lengths = Parallel.sum(ofSquaredLengths: x, method: method,
+                                   chunkSize: chunkSize)
+        for _ in 0 ..< 4 {
+          // Complex == would not see a change in a non-finite component, so
+          // compare the components.
+          let s = Parallel.sum(x, method: method, chunkSize: chunkSize)
+          XCTAssert(s.real == sum.real && s.imaginary == sum.imaginary)
+          let d = Parallel.dot(x, x, method: method, chunkSize: chunkSize)
+          XCTAssert(d.real == dot.real && d.imaginary == dot.imaginary)
+          let c = Parallel.conjugateDot(x, x, method: method, chunkSize: chunkSize)
+          XCTAssert(c.real == conjugateDot.real &&
+                    c.imaginary == conjugateDot.imaginary)
+          XCTAssertEqual(Parallel.sum(ofSquaredLengths: x, method: method,
+                                      chunkSize: chunkSize), lengths)
+        }
+      }
+      let chunks = stride(from: 0, to: x.count, by: chunkSize).map {
+        Complex.sum(UnsafeBufferPointer(rebasing: x[$0 ..< min($0 + chunkSize, x.count)]))
+      }
+      let sum = Parallel.sum(x, method: .pairwise, chunkSize: chunkSize)
+      let expected = combinePairwise(chunks[...])
+      XCTAssertEqual(sum.real, expected.real)
+      XCTAssertEqual(sum.imaginary, expected.imaginary)
+    }
+  }
+
+  func testFloat() {
+    testReductions(Float.self)
+  }
+
+  func testDouble() {
+    testReductions(Double.self)
+  }
+}
+#endif
@@ -129,4 +129,64 @@ final class PropertyTests: XCTestCase {
     try testCodable(Float64.self)
     // Float80 doesn't conform to Codable.
   }
+  
+  // The generic conversion, which the concrete overloads must agree with.
+  func genericConversion<T, U>(_ z: Complex<U>, to: T.Type) -> Complex<T>
+  where T: Real & BinaryFloatingPoint, U: Real & BinaryFloatingPoint {
+    Complex<T>(z)
+  }
+  
+  func checkConversions(_ values: [Complex<Double>]) {
+    let floats = values.map { Complex<Float>($0) }
+    for (z, w) in zip(values, floats) {
+      XCTAssertEqual(w, genericConversion(z, to: Float.self))
+      XCTAssertEqual(Complex<Double>(w), genericConversion(w, to: Double.self))
+    }
+    var bulkFloat = [Complex<Float>](repeating: .zero, count: values.count)
+    var bulkDouble = [Complex<Double>](repeating: .zero, count: values.count)
+    values.withUnsafeBufferPointer { z in
+      bulkFloat.withUnsafeMutableBufferPointer { Complex.convert(z, into: $0) }
+    }
+    floats.withUnsafeBufferPointer { z in
+      bulkDouble.withUnsafeMutableBufferPointer { Complex.convert(z, into: $0) }
+    }
+    XCTAssertEqual(bulkFloat, floats)
+    XCTAssertEqual(bulkDouble, floats.map { Complex<Double>($0) })
+    #if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+    if #available(macOS 11.0, iOS 14.0, watchOS 14.0, tvOS 7.0, *) {
+      for (z, w) in zip(values, floats) {
+        let h = Complex<Float16>(z)
+        XCTAssertEqual(h, genericConversion(z, to: Float16.self))
+        XCTAssertEqual(Complex<Float16>(w), genericConversion(w, to: Float16.self))
+        XCTAssertEqual(Complex<Float>(h), genericConversion(h, to: Float.self))
+        XCTAssertEqual(Complex<Double>(h), genericConversion(h, to: Double.self))
+      }
+    }
+    #endif
+    #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+    for (z, w) in zip(values, floats) {
+      let e = Complex<Float80>(z)
+      XCTAssertEqual(e, genericConversion(z, to: Float80.self))
+      XCTAssertEqual(Complex<Float80>(w), genericConversion(w, to: Float80.self))
+      XCTAssertEqual(Complex<Double>(e), z)
+      XCTAssertEqual(Complex<Float>(e), w)
+    }
+    #endif
+  }
+  
+  func testConversions() {
+    var g = SystemRandomNumberGenerator()
+    // Odd counts exercise the tail of any vectorized loop.
+    let random = (0 ..< 1001).map { _ in
+      Complex<Double>(length: .exp2(.random(in: -160 ... 160, using: &g)),
+                      phase: .random(in: -.pi ... .pi, using: &g))
+    }
+    checkConversions(random)
+    checkConversions([
+      .zero, Complex(-0.0, 0), Complex(1, -1),
+      Complex(0x1.fffffffp0, 0x1.0000001p0),
+      Complex(.greatestFiniteMagnitude, .leastNonzeroMagnitude),
+      Complex(.infinity, .nan)
+    ])
+  }
 }
@@ -0,0 +1,72 @@
+//===--- RelaxedTests.swift -----------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import ComplexModule
+import RealModule
+
+final class RelaxedTests: XCTestCase {
+
+  // For well-scaled values, the relaxed functions agree with the default
+  // implementations to within their documented error bounds (plus the
+  // error of the default implementation).
+  func testRelaxed<T: Real & FixedWidthFloatingPoint>(_ type: T.Type) {
+    var g = SystemRandomNumberGenerator()
+    var values: [Complex<T>] = (0 ..< 1000).map { _ in
+      Complex(T.random(in: -4 ... 4, using: &g),
+              T.random(in: -4 ... 4, using: &g))
+    }
+    // Points close to the unit circle and to zero, where the default log
+    // and log(onePlus:) take their compensated paths.
+    values += (0 ..< 1000).map { _ in
+      Complex(length: 1 + T.random(in: -0x1p-8 ... 0x1p-8, using: &g),
+              phase: T.random(in: -.pi ... .pi, using: &g))
+    }
+    values += (0 ..< 1000).map { _ in
+      Complex(T.random(in: -0x1p-8 ... 0x1p-8, using: &g),
+              T.random(in: -0x1p-8 ... 0x1p-8, using: &g))
+    }
+    func check(_ name: String, _ z: Complex<T>, _ w: Complex<T>,
+               ulps: T, _ relaxed: Complex<T>, _ expected: Complex<T>) {
+      if relativeError(relaxed, expected) > ulps {
+        print("Relaxed.\(name)(\(z), \(w)) was \(relaxed), expected \(expected).")
+        XCTFail()
+      }
+    }
+    for (z, w) in zip(values, values.reversed()) {
+      check("multiply", z, w, ulps: 4, Relaxed.multiply(z, w), z * w)
+      check("divide", z, w, ulps: 8, Relaxed.divide(z, w), z / w)
+      check("exp", z, w, ulps: 6, Relaxed.exp(z), .exp(z))
+      check("log", z, w, ulps: 8, Relaxed.log(z), .log(z))
+      check("log(onePlus:)", z, w, ulps: 8, Relaxed.log(onePlus: z), .log(onePlus: z))
+      check("sqrt", z, w, ulps: 6, Relaxed.sqrt(z), .sqrt(z))
+      XCTAssert(closeEnough(Relaxed.length(z), z.length, ulps: 2))
+      XCTAssert(closeEnough(Relaxed.lengthSquared(z), z.lengthSquared, ulps: 2))
+    }
+    XCTAssertEqual(Relaxed.sqrt(Complex<T>.zero), .zero)
+    XCTAssertEqual(Relaxed.hypot(T(3), T(4)), 5)
+    XCTAssertEqual(Relaxed.multiplyAdd(T(2), T(3), T(4)), 10)
+  }
+
+  func testFloat() {
+    testRelaxed(Float.self)
+  }
+
+  func testDouble() {
+    testRelaxed(Double.self)
+  }
+
+  #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+  func testFloat80() {
+    testRelaxed(Float80.self)
+  }
+  #endif
+}
@@ -0,0 +1,66 @@
+//===--- SlowPathCountersTests.swift --------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import Dispatch
+import ComplexModule
+import RealModule
+
+final class SlowPathCountersTests: XCTestCase {
+
+  // Checks that body takes each slow path exactly as many times as it
+  // appears in paths (none if the counters are compiled out).
+  func checkCounts(
+    _ paths: [SlowPathCounters.Path],
+    file: StaticString = #file, line: UInt = #line,
+    _ body: () -> Void
+  ) {
+    SlowPathCounters.reset()
+    body()
+    let counts = SlowPathCounters.snapshot()
+    XCTAssertEqual(Set(counts.keys), Set(SlowPathCounters.Path.allCases),
+                   file: file, line: line)
+    for path in SlowPathCounters.Path.allCases {
+      let expected = SlowPathCounters.isEnabled ?
+        paths.filter { $0 == path }.count : 0
+      XCTAssertEqual(counts[path], expected, "\(path)", file: file, line: line)
+    }
+  }
+
+  func testCounters() {
+    let tiny = Complex<Double>(.leastNormalMagnitude, .leastNormalMagnitude)
+    let huge = Complex<Double>(.greatestFiniteMagnitude, 1)
+    checkCounts([.rescaledDivide]) { _ = Complex(1, 2) / tiny }
+    checkCounts([.carefulLength]) { _ = huge.length }
+    checkCounts([.rescaledSqrt]) { _ = Complex.sqrt(huge) }
+    checkCounts([.scaledExp]) { _ = Complex.exp(Complex<Double>(709.5, 1)) }
+    checkCounts([.compensatedLog]) {
+      _ = Complex.log(Complex<Double>(0.6, 0.8))
+    }
+    checkCounts([.compensatedLogOnePlus]) {
+      _ = Complex.log(onePlus: Complex<Double>(0.25, 0.25))
+    }
+    // Well-scaled values take no slow paths.
+    checkCounts([]) {
+      _ = Complex<Double>(1, 2) / Complex(3, 4)
+      _ = Complex<Double>(3, 4).length
+      _ = Complex.sqrt(Complex<Double>(3, 4))
+      _ = Complex.exp(Complex<Double>(1, 1))
+      _ = Complex.log(Complex<Double>(2, 1))
+    }
+    // Counts from several threads add up.
+    checkCounts(Array(repeating: .carefulLength, count: 8000)) {
+      DispatchQueue.concurrentPerform(iterations: 8) { _ in
+        for _ in 0 ..< 1000 { _ = huge.length }
+      }
+    }
+  }
+}
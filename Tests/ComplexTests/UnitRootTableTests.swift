@@ -0,0 +1,99 @@
+//===--- UnitRootTableTests.swift -----------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import ComplexModule
+import RealModule
+import _TestSupport
+
+final class UnitRootTableTests: XCTestCase {
+
+  // Lengths with each combination of the symmetries, small enough and large
+  // enough that the coarse and fine roots have several entries each, and
+  // one long enough that errors growing with the angle would show.
+  let counts = [1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 17, 100, 360, 1000, 1024, 4099,
+                3_000_009]
+
+  func testFloat() {
+    for n in counts {
+      let table = UnitRootTable<Float>(count: n)
+      XCTAssertEqual(table.count, n)
+      // The reference is computed in Double, where its own error is
+      // negligible; the roots have unit length, so their relative errors
+      // are their absolute errors.
+      let reference = (0 ..< n).map { k -> Complex<Double> in
+        let θ = 2 * Double.pi * Double(k) / Double(n)
+        return Complex(Double.cos(θ), Double.sin(θ))
+      }
+      let errors = table.withUnsafeBufferPointer { t in
+        reference.withUnsafeBufferPointer { relativeError(t, $0) }
+      }
+      XCTAssertEqual(errors.count, n)
+      if !(errors.max <= 2 * Double(Float.ulpOfOne)), let k = errors.argmax {
+        print("UnitRootTable<Float>(count: \(n))[\(k)] was \(table[k]), expected \(reference[k]).")
+        XCTFail()
+      }
+    }
+  }
+
+  func testDouble() {
+    for n in counts {
+      let table = UnitRootTable<Double>(count: n)
+      for k in 0 ..< n {
+        // There is no wider reference type on every platform, and the error
+        // in θ itself is several ulps, so this only checks that the table
+        // agrees with the direct computation.
+        let θ = 2 * Double.pi * Double(k) / Double(n)
+        let expected = Complex(length: 1, phase: θ)
+        if relativeError(table[k], expected) > 16 {
+          print("UnitRootTable<Double>(count: \(n))[\(k)] was \(table[k]), expected \(expected).")
+          XCTFail()
+        }
+      }
+    }
+  }
+
+  func testSymmetries() {
+    for n in counts {
+      let table = UnitRootTable<Double>(count: n)
+      XCTAssertEqual(table[0], .one)
+      if n % 2 == 0 { XCTAssertEqual(table[n/2], Complex(-1, 0)) }
+      if n % 4 == 0 {
+        XCTAssertEqual(table[n/4], .i)
+        XCTAssertEqual(table[3*n/4], -.i)
+      }
+      if n % 8 == 0 {
+        let h = Double.sqrt(0.5)
+        XCTAssertEqual(table[n/8], Complex(h, h))
+      }
+      for k in 1 ..< n {
+        XCTAssertEqual(table[n - k], table[k].conjugate)
+      }
+      XCTAssertEqual(table.root(-1), table[n - 1])
+      XCTAssertEqual(table.root(n + 1), table[1 % n])
+    }
+  }
+
+  func testShared() {
+    let a = UnitRootTable<Float>.shared(count: 256)
+    let b = UnitRootTable<Float>.shared(count: 256)
+    let c = UnitRootTable<Double>.shared(count: 256)
+    XCTAssertEqual(Array(a), Array(UnitRootTable<Float>(count: 256)))
+    a.withUnsafeBufferPointer { a in
+      b.withUnsafeBufferPointer { b in
+        XCTAssertEqual(a.baseAddress, b.baseAddress)
+      }
+    }
+    XCTAssertEqual(c.count, 256)
+    XCTAssertEqual(Array(UnitRootTable<Double>.shared(count: 255)),
+                   Array(UnitRootTable<Double>(count: 255)))
+  }
+}
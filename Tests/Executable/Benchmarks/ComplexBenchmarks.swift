@@ -0,0 +1,76 @@
+//===--- ComplexBenchmarks.swift ------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import ComplexModule
+import RealModule
+
+extension Distribution {
+  /// A complex value whose components (or, near the unit circle, whose
+  /// length) have the distribution's magnitude, in a random direction.
+  func sample<T, G>(_ type: Complex<T>.Type, using g: inout G) -> Complex<T>
+  where T: Real & BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger,
+        G: RandomNumberGenerator {
+    if self == .nearUnitCircle {
+      return Complex(length: magnitude(T.self, using: &g),
+                     phase: T.random(in: -.pi ... .pi, using: &g))
+    }
+    return Complex(sample(T.self, using: &g), sample(T.self, using: &g))
+  }
+}
+
+/// Measures complex multiplication, division, exp, log, sqrt and pow on
+/// `Complex<type>`, for each distribution.
+func complexBenchmarks<T>(_ type: T.Type)
+where T: Real & BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger {
+  var g = SystemRandomNumberGenerator()
+  for distribution in Distribution.allCases {
+    let z = (0 ..< Benchmarks.count).map { _ in
+      distribution.sample(Complex<T>.self, using: &g)
+    }
+    let w = (0 ..< Benchmarks.count).map { _ in
+      distribution.sample(Complex<T>.self, using: &g)
+    }
+
+    @inline(__always)
+    func unary(_ name: String, _ f: (Complex<T>) -> Complex<T>) {
+      guard Benchmarks.shouldRun(name) else { return }
+      let (throughput, latency) = measure(
+        z, chain: { $0 + Complex(dependency(on: $1.real)) }, f
+      )
+      Benchmarks.results.append(Measurement(
+        module: "ComplexModule", type: "Complex<\(T.self)>", function: name,
+        distribution: distribution, throughput: throughput, latency: latency
+      ))
+    }
+
+    @inline(__always)
+    func binary(_ name: String, _ f: (Complex<T>, Complex<T>) -> Complex<T>) {
+      guard Benchmarks.shouldRun(name) else { return }
+      let (throughput, latency) = measure(
+        Array(zip(z, w)),
+        chain: { ($0.0 + Complex(dependency(on: $1.real)), $0.1) },
+        { f($0.0, $0.1) }
+      )
+      Benchmarks.results.append(Measurement(
+        module: "ComplexModule", type: "Complex<\(T.self)>", function: name,
+        distribution: distribution, throughput: throughput, latency: latency
+      ))
+    }
+
+    binary("*") { $0 * $1 }
+    binary("/") { $0 / $1 }
+    unary("exp") { .exp($0) }
+    unary("log") { .log($0) }
+    unary("sqrt") { .sqrt($0) }
+    binary("pow(_:_:)") { .pow($0, $1) }
+    unary("pow(_:3)") { .pow($0, 3) }
+  }
+}
@@ -0,0 +1,172 @@
+//===--- Harness.swift ----------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import Dispatch
+import RealModule
+
+/// The input distributions that every function is measured on.
+///
+/// Many of the functions in this library have a fast path for well-scaled
+/// inputs and slower paths for the others, so each distribution is reported
+/// separately.
+enum Distribution: String, CaseIterable {
+  /// Magnitudes spread logarithmically over [1/16, 16].
+  case wellScaled = "well-scaled"
+  /// Magnitudes within 2⁻⁸ of 1 (for complex inputs, lengths within 2⁻⁸ of
+  /// 1 with uniformly distributed phase).
+  case nearUnitCircle = "near-unit-circle"
+  /// Subnormal magnitudes.
+  case subnormal = "subnormal"
+  /// Magnitudes within a factor of 2⁸ of `greatestFiniteMagnitude`.
+  case huge = "huge"
+
+  func magnitude<T, G>(_ type: T.Type, using g: inout G) -> T
+  where T: Real & BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger,
+        G: RandomNumberGenerator {
+    switch self {
+    case .wellScaled:
+      return T.exp2(T.random(in: -4 ... 4, using: &g))
+    case .nearUnitCircle:
+      return 1 + T(0x1p-8) * T.random(in: -1 ... 1, using: &g)
+    case .subnormal:
+      return T.leastNormalMagnitude * T.random(in: T.ulpOfOne ..< 1, using: &g)
+    case .huge:
+      return T.greatestFiniteMagnitude / T.exp2(T.random(in: 0 ... 8, using: &g))
+    }
+  }
+
+  /// A real value with the distribution's magnitude and a random sign.
+  func sample<T, G>(_ type: T.Type, using g: inout G) -> T
+  where T: Real & BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger,
+        G: RandomNumberGenerator {
+    let x = magnitude(T.self, using: &g)
+    return Bool.random(using: &g) ? x : -x
+  }
+}
+
+/// One line of the report.
+struct Measurement {
+  var module: String
+  var type: String
+  var function: String
+  var distribution: Distribution
+  /// Nanoseconds per call when the calls are independent.
+  var throughput: Double
+  /// Nanoseconds per call when each call depends on the result of the last.
+  var latency: Double
+}
+
+/// The options and accumulated results of a run.
+struct Benchmarks {
+  /// Number of inputs per measurement.
+  static let count = 1024
+  /// Each measurement is the fastest of this many passes over the inputs.
+  static var trials = 32
+  /// If non-empty, only functions whose name contains one of these strings
+  /// are measured.
+  static var filters: [String] = []
+
+  static var results: [Measurement] = []
+
+  static func shouldRun(_ function: String) -> Bool {
+    filters.isEmpty || filters.contains { function.contains($0) }
+  }
+
+  /// Writes the results as a JSON document to standard output.
+  static func printJSON() {
+    print("{")
+    print("  \"count\": \(count),")
+    print("  \"trials\": \(trials),")
+    print("  \"benchmarks\": [")
+    for (i, m) in results.enumerated() {
+      let separator = i == results.count - 1 ? "" : ","
+      print("    {\"module\": \"\(m.module)\", \"type\": \"\(m.type)\", " +
+            "\"function\": \"\(escaped(m.function))\", " +
+            "\"distribution\": \"\(m.distribution.rawValue)\", " +
+            "\"throughput_ns\": \(m.throughput), " +
+            "\"latency_ns\": \(m.latency)}\(separator)")
+    }
+    print("  ]")
+    print("}")
+  }
+
+  static func escaped(_ s: String) -> String {
+    var result = ""
+    for c in s {
+      switch c {
+      case "\"": result += "\\\""
+      case "\\": result += "\\\\"
+      default: result.append(c)
+      }
+    }
+    return result
+  }
+}
+
+/// Keeps the optimizer from discarding the computation of `x`.
+@_optimize(none)
+func blackHole<T>(_ x: T) { }
+
+/// The time taken by `body`, in nanoseconds.
+@inline(__always)
+func nanoseconds(_ body: () -> Void) -> Double {
+  let start = DispatchTime.now().uptimeNanoseconds
+  body()
+  let end = DispatchTime.now().uptimeNanoseconds
+  return Double(end - start)
+}
+
+/// Measures `f` on `inputs`, returning nanoseconds per call for independent
+/// and for dependent calls.
+///
+/// For the latency measurement, `chain` folds the previous result into the
+/// next input. It must do so in a way that does not change the input (and
+/// that the optimizer cannot see through), so that the same values are
+/// measured in both modes; see `dependency(on:)`.
+///
+/// This is always inlined so that `f` is inlined into the loops.
+@inline(__always)
+func measure<Input, Output>(
+  _ inputs: [Input],
+  chain: (Input, Output) -> Input,
+  _ f: (Input) -> Output
+) -> (throughput: Double, latency: Double) {
+  var throughput = Double.infinity
+  var latency = Double.infinity
+  var outputs = inputs.map(f)
+  inputs.withUnsafeBufferPointer { x in
+    outputs.withUnsafeMutableBufferPointer { y in
+      for _ in 0 ..< Benchmarks.trials {
+        throughput = min(throughput, nanoseconds {
+          for i in x.indices { y[i] = f(x[i]) }
+        })
+        blackHole(y)
+        var r = y[0]
+        latency = min(latency, nanoseconds {
+          for i in x.indices { r = f(chain(x[i], r)) }
+        })
+        blackHole(r)
+      }
+    }
+  }
+  let n = Double(inputs.count)
+  return (throughput / n, latency / n)
+}
+
+/// Zero, computed from `x` so that adding it to the next input makes that
+/// input depend on `x`.
+///
+/// `minimum` of zero and a magnitude is +0 for every x, including infinity
+/// and nan, but the optimizer does not know that.
+@_transparent
+func dependency<T: Real>(on x: T) -> T {
+  T.minimum(x.magnitude, 0)
+}
@@ -0,0 +1,113 @@
+//===--- RealBenchmarks.swift ---------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import RealModule
+
+/// The subset of the real line that inputs to a function are folded into,
+/// so that we measure the function rather than its nan path.
+enum Domain {
+  case all
+  case positive
+  /// [-1, 1]
+  case unit
+  /// [1, ∞]
+  case atLeastOne
+
+  func fold<T: Real>(_ x: T) -> T {
+    switch self {
+    case .all: return x
+    case .positive: return x.magnitude
+    case .unit: return x.magnitude <= 1 ? x : 1/x
+    case .atLeastOne: return x.magnitude >= 1 ? x.magnitude : 1/x.magnitude
+    }
+  }
+}
+
+/// Measures every function of `Real` on `type`, for each distribution.
+func realBenchmarks<T>(_ type: T.Type)
+where T: Real & BinaryFloatingPoint, T.RawSignificand: FixedWidthInteger {
+  var g = SystemRandomNumberGenerator()
+  for distribution in Distribution.allCases {
+    let x = (0 ..< Benchmarks.count).map { _ in
+      distribution.sample(T.self, using: &g)
+    }
+    let y = (0 ..< Benchmarks.count).map { _ in
+      distribution.sample(T.self, using: &g)
+    }
+
+    @inline(__always)
+    func unary(_ name: String, _ domain: Domain, _ f: (T) -> T) {
+      guard Benchmarks.shouldRun(name) else { return }
+      let (throughput, latency) = measure(
+        x.map { domain.fold($0) }, chain: { $0 + dependency(on: $1) }, f
+      )
+      Benchmarks.results.append(Measurement(
+        module: "RealModule", type: "\(T.self)", function: name,
+        distribution: distribution, throughput: throughput, latency: latency
+      ))
+    }
+
+    @inline(__always)
+    func binary(_ name: String, _ domain: Domain, _ f: (T, T) -> T) {
+      guard Benchmarks.shouldRun(name) else { return }
+      let (throughput, latency) = measure(
+        Array(zip(x.map { domain.fold($0) }, y)),
+        chain: { ($0.0 + dependency(on: $1), $0.1) },
+        { f($0.0, $0.1) }
+      )
+      Benchmarks.results.append(Measurement(
+        module: "RealModule", type: "\(T.self)", function: name,
+        distribution: distribution, throughput: throughput, latency: latency
+      ))
+    }
+
+    // ElementaryFunctions
+    unary("exp", .all) { .exp($0) }
+    unary("expMinusOne", .all) { .expMinusOne($0) }
+    unary("cosh", .all) { .cosh($0) }
+    unary("sinh", .all) { .sinh($0) }
+    unary("tanh", .all) { .tanh($0) }
+    unary("cos", .all) { .cos($0) }
+    unary("sin", .all) { .sin($0) }
+    unary("tan", .all) { .tan($0) }
+    unary("log", .positive) { .log($0) }
+    unary("log(onePlus:)", .positive) { .log(onePlus: $0) }
+    unary("acosh", .atLeastOne) { .acosh($0) }
+    unary("asinh", .all) { .asinh($0) }
+    unary("atanh", .unit) { .atanh($0) }
+    unary("acos", .unit) { .acos($0) }
+    unary("asin", .unit) { .asin($0) }
+    unary("atan", .all) { .atan($0) }
+    binary("pow(_:_:)", .positive) { .pow($0, $1) }
+    unary("pow(_:3)", .all) { .pow($0, 3) }
+    unary("pow(_:17)", .all) { .pow($0, 17) }
+    unary("pow(_:-2)", .all) { .pow($0, -2) }
+    unary("sqrt", .positive) { .sqrt($0) }
+    unary("root(_:3)", .all) { .root($0, 3) }
+    // RealFunctions
+    binary("atan2", .all) { .atan2(y: $0, x: $1) }
+    unary("erf", .all) { .erf($0) }
+    unary("erfc", .all) { .erfc($0) }
+    unary("exp2", .all) { .exp2($0) }
+    unary("exp10", .all) { .exp10($0) }
+    binary("hypot", .all) { .hypot($0, $1) }
+    unary("gamma", .all) { .gamma($0) }
+    unary("log2", .positive) { .log2($0) }
+    unary("log10", .positive) { .log10($0) }
+    unary("logGamma", .all) { .logGamma($0) }
+    unary("signGamma", .all) { $0 * (T.signGamma($0) == .plus ? 1 : -1) }
+    // The tuple-valued functions are measured through the sum of their
+    // results, which adds one addition to each call.
+    unary("sincos", .all) { let (s, c) = T.sincos($0); return s + c }
+    unary("sinhcosh", .all) { let (s, c) = T.sinhcosh($0); return s + c }
+    binary("_mulAdd", .all) { T._mulAdd($0, $1, $0) }
+  }
+}
@@ -0,0 +1,60 @@
+//===--- main.swift -------------------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+// Throughput and latency of the Real functions and of the complex
+// arithmetic and elementary functions, written to standard output as JSON.
+//
+// Usage: Benchmarks [--trials N] [name ...]
+//
+// If names are given, only functions whose name contains one of them are
+// measured.
+
+import Numerics
+
+#if DEBUG
+fatalError("Run the benchmarks in Release configuration")
+#else
+
+var arguments = CommandLine.arguments.dropFirst()
+while let argument = arguments.popFirst() {
+  if argument == "--trials", let n = arguments.popFirst().flatMap({ Int($0) }) {
+    precondition(n > 0, "--trials must be positive.")
+    Benchmarks.trials = n
+  } else {
+    Benchmarks.filters.append(argument)
+  }
+}
+
+#if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+if #available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *) {
+  realBenchmarks(Float16.self)
+}
+#endif
+realBenchmarks(Float.self)
+realBenchmarks(Double.self)
+#if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+realBenchmarks(Float80.self)
+#endif
+
+#if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+if #available(macOS 11.0, iOS 14.0, tvOS 14.0, watchOS 7.0, *) {
+  complexBenchmarks(Float16.self)
+}
+#endif
+complexBenchmarks(Float.self)
+complexBenchmarks(Double.self)
+#if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+complexBenchmarks(Float80.self)
+#endif
+
+Benchmarks.printJSON()
+
+#endif
@@ -0,0 +1,159 @@
+//===--- AccumulatorTests.swift -------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import RealModule
+import _TestSupport
+
+internal extension Real where Self: FixedWidthFloatingPoint {
+
+  // log(Σ exp(x[i])), computed with a separate pass for the maximum.
+  static func logSumExpReference(_ x: [Self]) -> Self {
+    let m = x.max()!
+    return m + .log(.sum(x.map { .exp($0 - m) }, method: .doubleDouble))
+  }
+
+  static func logSumExp(_ x: [Self], batched: Bool) -> Self {
+    var a = LogSumExpAccumulator<Self>()
+    if batched { a.add(contentsOf: x) } else { x.forEach { a.add($0) } }
+    return a.value
+  }
+
+  static func compensatedSumChecks() {
+    // Every addition but the last rounds; the compensation recovers it all.
+    let big = 4 / Self.ulpOfOne
+    let x = (0 ..< 1000).flatMap { _ in [big, 1, -big] }
+    var scalar = CompensatedSumAccumulator<Self>()
+    x.forEach { scalar.add($0) }
+    XCTAssertEqual(scalar.value, 1000)
+    var batched = CompensatedSumAccumulator<Self>()
+    batched.add(contentsOf: x)
+    XCTAssertEqual(batched.value, 1000)
+    var lower = CompensatedSumAccumulator<Self>()
+    var upper = CompensatedSumAccumulator<Self>()
+    lower.add(contentsOf: x[..<1501])
+    upper.add(contentsOf: x[1501...])
+    lower.merge(upper)
+    XCTAssertEqual(lower.value, 1000)
+    XCTAssertEqual(CompensatedSumAccumulator<Self>().value, 0)
+    // Infinities and overflow give the IEEE 754 result, not nan.
+    var infinite = CompensatedSumAccumulator<Self>()
+    infinite.add(.infinity)
+    XCTAssertEqual(infinite.value, .infinity)
+    var overflow = CompensatedSumAccumulator<Self>()
+    overflow.add(contentsOf: [Self](repeating: .greatestFiniteMagnitude, count: 10))
+    XCTAssertEqual(overflow.value, .infinity)
+    overflow.merge(infinite)
+    XCTAssertEqual(overflow.value, .infinity)
+  }
+
+  static func logSumExpChecks() {
+    var g = SystemRandomNumberGenerator()
+    // Moderate values, and values for which exp overflows.
+    for offset: Self in [0, 1000, -1000] {
+      let x = (0 ..< 1000).map { _ in offset + Self.random(in: -8 ... 8, using: &g) }
+      let reference = logSumExpReference(x)
+      let tolerance = 8 * Self.ulpOfOne + 2 * reference.ulp
+      for batched in [false, true] {
+        let observed = logSumExp(x, batched: batched)
+        XCTAssert((observed - reference).magnitude <= tolerance,
+                  "\(observed) != \(reference)")
+      }
+      // Merging the summaries of shards gives the summary of the whole.
+      var a = LogSumExpAccumulator<Self>()
+      var b = LogSumExpAccumulator<Self>()
+      a.add(contentsOf: x[..<300])
+      b.add(contentsOf: x[300...])
+      a.merge(b)
+      XCTAssert((a.value - reference).magnitude <= tolerance)
+      b.merge(LogSumExpAccumulator())
+      XCTAssertEqual(b.value, logSumExp(Array(x[300...]), batched: true))
+    }
+    let w: [Self] = [1000, 1000]
+    XCTAssert((logSumExp(w, batched: true) - (1000 + .log(2))).magnitude <= Self(1000).ulp)
+    // Edge cases.
+    for batched in [false, true] {
+      XCTAssertEqual(logSumExp([], batched: batched), -.infinity)
+      XCTAssertEqual(logSumExp([-.infinity, -.infinity], batched: batched), -.infinity)
+      XCTAssertEqual(logSumExp([-.infinity, 2], batched: batched), 2)
+      XCTAssertEqual(logSumExp([1, .infinity, 2], batched: batched), .infinity)
+      XCTAssertEqual(logSumExp([.infinity, .infinity], batched: batched), .infinity)
+      XCTAssert(logSumExp([1, .nan, 2], batched: batched).isNaN)
+      XCTAssert(logSumExp([.nan, .infinity], batched: batched).isNaN)
+      XCTAssert(logSumExp([.infinity, .nan], batched: batched).isNaN)
+    }
+    var nan = LogSumExpAccumulator<Self>()
+    nan.add(.nan)
+    var one = LogSumExpAccumulator<Self>()
+    one.add(1)
+    one.merge(nan)
+    XCTAssert(one.value.isNaN)
+  }
+
+  static func meanVarianceChecks() {
+    // Small deviations from a large offset, where the textbook formula
+    // cancels catastrophically. The mean is offset + 3, and the variance 4.
+    let offset = Self(1 << (Self.significandBitCount / 2))
+    let x = (0 ..< 7000).map { offset + Self($0 % 7) }
+    let tolerance = 4 * offset * .ulpOfOne
+    var scalar = MeanVarianceAccumulator<Self>()
+    x.forEach { scalar.add($0) }
+    var batched = MeanVarianceAccumulator<Self>()
+    batched.add(contentsOf: x)
+    var sharded = MeanVarianceAccumulator<Self>()
+    for start in stride(from: 0, to: x.count, by: 999) {
+      var shard = MeanVarianceAccumulator<Self>()
+      shard.add(contentsOf: x[start ..< min(start + 999, x.count)])
+      sharded.merge(shard)
+    }
+    for a in [scalar, batched, sharded] {
+      XCTAssertEqual(a.count, 7000)
+      XCTAssert((a.mean - (offset + 3)).magnitude <= 8 * offset.ulp)
+      XCTAssert((a.variance - 4).magnitude <= tolerance, "\(a.variance) != 4")
+      XCTAssert((a.sampleVariance - 4 * 7000 / 6999).magnitude <= tolerance)
+      XCTAssert((a.standardDeviation - 2).magnitude <= tolerance)
+    }
+    // Edge cases.
+    var empty = MeanVarianceAccumulator<Self>()
+    XCTAssertEqual(empty.count, 0)
+    XCTAssert(empty.mean.isNaN)
+    XCTAssert(empty.variance.isNaN)
+    empty.merge(MeanVarianceAccumulator())
+    XCTAssertEqual(empty.count, 0)
+    var single = MeanVarianceAccumulator<Self>()
+    single.add(5)
+    XCTAssertEqual(single.mean, 5)
+    XCTAssertEqual(single.variance, 0)
+    XCTAssert(single.sampleVariance.isNaN)
+    empty.merge(single)
+    XCTAssertEqual(empty.mean, 5)
+    XCTAssertEqual(empty.count, 1)
+    var infinite = MeanVarianceAccumulator<Self>()
+    infinite.add(1)
+    infinite.add(.infinity)
+    XCTAssertEqual(infinite.mean, .infinity)
+  }
+}
+
+final class AccumulatorTests: XCTestCase {
+
+  func testFloat() {
+    Float.compensatedSumChecks()
+    Float.logSumExpChecks()
+    Float.meanVarianceChecks()
+  }
+
+  func testDouble() {
+    Double.compensatedSumChecks()
+    Double.logSumExpChecks()
+    Double.meanVarianceChecks()
+  }
+}
@@ -123,16 +123,77 @@ final class ApproximateEqualityTests: XCTestCase {
     }
   }
   
+  func testBuffers<T>(_ type: T.Type) where T: FixedWidthFloatingPoint & Real {
+    var g = SystemRandomNumberGenerator()
+    let a = (0 ..< 1000).map { _ in T.random(in: -2 ... 2, using: &g) }
+    // b differs from a by a random number of ulps, with a few exceptional
+    // values mixed in.
+    var b = a.map { x -> T in
+      var y = x
+      for _ in 0 ..< Int.random(in: 0 ..< 40, using: &g) { y = y.nextUp }
+      return y
+    }
+    b[10] = .nan
+    b[20] = .infinity
+    b[30] = -a[30]
+    let tol = 16 * T.ulpOfOne
+    let report = a.withUnsafeBufferPointer { a in
+      b.withUnsafeBufferPointer { b in
+        ApproximateEqualityReport(comparing: a, to: b, relativeTolerance: tol)
+      }
+    }
+    // The comparison agrees with the scalar one.
+    let failing = a.indices.filter {
+      !a[$0].isApproximatelyEqual(to: b[$0], relativeTolerance: tol)
+    }
+    XCTAssertEqual(report.count, a.count)
+    XCTAssertEqual(report.failures, failing.count)
+    XCTAssertEqual(report.firstFailure, failing.first)
+    XCTAssertFalse(report.allApproximatelyEqual)
+    XCTAssertEqual(report.ulpHistogram.reduce(0, +), a.count)
+    XCTAssertEqual(report.ulpHistogram.count, ApproximateEqualityReport<T>.bucketCount)
+    // The infinite difference has the largest absolute error and the sign
+    // flip the largest relative error; the nans contribute to neither.
+    XCTAssertEqual(report.maxAbsoluteError, .infinity)
+    XCTAssertEqual(report.maxAbsoluteErrorIndex, 20)
+    XCTAssertEqual(report.maxRelativeError, 2)
+    XCTAssertEqual(report.maxRelativeErrorIndex, 30)
+    // Equal buffers, including zeros of either sign, have no error at all.
+    let zeros: [T] = [0, -0, 1, -1]
+    let equal = zeros.withUnsafeBufferPointer { a in
+      zeros.map { $0 == 0 ? -$0 : $0 }.withUnsafeBufferPointer { b in
+        ApproximateEqualityReport(comparing: a, to: b, absoluteTolerance: 0)
+      }
+    }
+    XCTAssertTrue(equal.allApproximatelyEqual)
+    XCTAssertNil(equal.maxAbsoluteErrorIndex)
+    XCTAssertEqual(equal.ulpHistogram[0], equal.count)
+    // One ulp, two ulps and three ulps fall into buckets 1, 2 and 3.
+    let x: [T] = [1, 1, 1]
+    let y: [T] = [T(1).nextUp, T(1).nextUp.nextUp, T(1).nextUp.nextUp.nextUp]
+    let small = x.withUnsafeBufferPointer { x in
+      y.withUnsafeBufferPointer {
+        ApproximateEqualityReport(comparing: x, to: $0, absoluteTolerance: 0, relativeTolerance: 0)
+      }
+    }
+    XCTAssertEqual(small.failures, 3)
+    XCTAssertEqual(Array(small.ulpHistogram[0 ..< 4]), [0, 1, 1, 1])
+    XCTAssertEqual(small.maxAbsoluteError, 3 * T.ulpOfOne)
+    XCTAssertEqual(small.maxAbsoluteErrorIndex, 2)
+  }
+  
   func testFloat() {
     testSpecials(Float.self)
     testDefaults(Float.self)
     testRandom(Float.self)
+    testBuffers(Float.self)
   }
   
   func testDouble() {
     testSpecials(Double.self)
     testDefaults(Double.self)
     testRandom(Double.self)
+    testBuffers(Double.self)
   }
   
   #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
@@ -140,6 +201,7 @@ final class ApproximateEqualityTests: XCTestCase {
     testSpecials(Float80.self)
     testDefaults(Float80.self)
     testRandom(Float80.self)
+    testBuffers(Float80.self)
   }
   #endif
 }
@@ -0,0 +1,284 @@
+//===--- BatchedFunctionTests.swift ---------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import RealModule
+import _TestSupport
+
+internal extension Real where Self: FixedWidthFloatingPoint {
+  
+  // The batched functions must produce exactly the same result as the
+  // scalar functions, both out-of-place and in-place.
+  static func checkBatched(
+    _ name: String,
+    _ inputs: [Self],
+    scalar: (Self) -> Self,
+    batched: (UnsafeBufferPointer<Self>, UnsafeMutableBufferPointer<Self>) -> Void,
+    inPlace: (UnsafeMutableBufferPointer<Self>) -> Void,
+    file: StaticString = #file,
+    line: UInt = #line
+  ) {
+    let expected = inputs.map(scalar)
+    var observed = [Self](repeating: 0, count: inputs.count)
+    inputs.withUnsafeBufferPointer { x in
+      observed.withUnsafeMutableBufferPointer { batched(x, $0) }
+    }
+    var inPlaceObserved = inputs
+    inPlaceObserved.withUnsafeMutableBufferPointer { inPlace($0) }
+    for i in inputs.indices {
+      if expected[i].isNaN {
+        XCTAssert(observed[i].isNaN, "\(name)(\(inputs[i]))", file: file, line: line)
+        XCTAssert(inPlaceObserved[i].isNaN, "\(name)(\(inputs[i]))", file: file, line: line)
+      } else {
+        XCTAssertEqual(expected[i], observed[i], "\(name)(\(inputs[i]))", file: file, line: line)
+        XCTAssertEqual(expected[i], inPlaceObserved[i], "\(name)(\(inputs[i]))", file: file, line: line)
+      }
+    }
+  }
+  
+  static func batchedFunctionChecks() {
+    var g = SystemRandomNumberGenerator()
+    let inputs: [Self] = [0, -.zero, 1, -1, .infinity, -.infinity, .nan,
+                          .leastNonzeroMagnitude, .greatestFiniteMagnitude] +
+      (0 ..< 100).map { _ in Self.random(in: -8 ... 8, using: &g) }
+    checkBatched("exp", inputs, scalar: { Self.exp($0) },
+                 batched: { Self.exp($0, into: $1) }, inPlace: { Self.exp($0) })
+    checkBatched("expMinusOne", inputs, scalar: { Self.expMinusOne($0) },
+                 batched: { Self.expMinusOne($0, into: $1) }, inPlace: { Self.expMinusOne($0) })
+    checkBatched("log", inputs, scalar: { Self.log($0) },
+                 batched: { Self.log($0, into: $1) }, inPlace: { Self.log($0) })
+    checkBatched("log(onePlus:)", inputs, scalar: { Self.log(onePlus: $0) },
+                 batched: { Self.log(onePlus: $0, into: $1) }, inPlace: { Self.log(onePlus: $0) })
+    checkBatched("cos", inputs, scalar: { Self.cos($0) },
+                 batched: { Self.cos($0, into: $1) }, inPlace: { Self.cos($0) })
+    checkBatched("sin", inputs, scalar: { Self.sin($0) },
+                 batched: { Self.sin($0, into: $1) }, inPlace: { Self.sin($0) })
+    checkBatched("tanh", inputs, scalar: { Self.tanh($0) },
+                 batched: { Self.tanh($0, into: $1) }, inPlace: { Self.tanh($0) })
+    checkBatched("sqrt", inputs, scalar: { Self.sqrt($0) },
+                 batched: { Self.sqrt($0, into: $1) }, inPlace: { Self.sqrt($0) })
+    checkBatched("erf", inputs, scalar: { Self.erf($0) },
+                 batched: { Self.erf($0, into: $1) }, inPlace: { Self.erf($0) })
+    checkBatched("erfc", inputs, scalar: { Self.erfc($0) },
+                 batched: { Self.erfc($0, into: $1) }, inPlace: { Self.erfc($0) })
+    checkBatched("gamma", inputs, scalar: { Self.gamma($0) },
+                 batched: { Self.gamma($0, into: $1) }, inPlace: { Self.gamma($0) })
+    #if !os(Windows)
+    checkBatched("logGamma", inputs, scalar: { Self.logGamma($0) },
+                 batched: { Self.logGamma($0, into: $1) }, inPlace: { Self.logGamma($0) })
+    #endif
+    checkBatched("normalCDF", inputs, scalar: { Self.normalCDF($0) },
+                 batched: { Self.normalCDF($0, into: $1) }, inPlace: { Self.normalCDF($0) })
+    checkBatched("normalQuantile", inputs, scalar: { Self.normalQuantile($0) },
+                 batched: { Self.normalQuantile($0, into: $1) },
+                 inPlace: { Self.normalQuantile($0) })
+    checkBatched("pow(_:3)", inputs, scalar: { Self.pow($0, 3) },
+                 batched: { Self.pow($0, 3, into: $1) }, inPlace: { Self.pow($0, 3) })
+    checkBatched("root(_:3)", inputs, scalar: { Self.root($0, 3) },
+                 batched: { Self.root($0, 3, into: $1) }, inPlace: { Self.root($0, 3) })
+  }
+  
+  // The Float and Double kernels are not required to match the scalar
+  // functions exactly; finite results must be within `allowedUlps` of the
+  // scalar result, and non-finite results must match exactly.
+  static func checkKernel(
+    _ name: String,
+    _ inputs: [Self],
+    allowedUlps: Self,
+    scalar: (Self) -> Self,
+    batched: (UnsafeBufferPointer<Self>, UnsafeMutableBufferPointer<Self>) -> Void,
+    inPlace: (UnsafeMutableBufferPointer<Self>) -> Void,
+    file: StaticString = #file,
+    line: UInt = #line
+  ) {
+    let expected = inputs.map(scalar)
+    var observed = [Self](repeating: 0, count: inputs.count)
+    inputs.withUnsafeBufferPointer { x in
+      observed.withUnsafeMutableBufferPointer { batched(x, $0) }
+    }
+    var inPlaceObserved = inputs
+    inPlaceObserved.withUnsafeMutableBufferPointer { inPlace($0) }
+    for i in inputs.indices {
+      // The batched result must not depend on whether it is in-place.
+      XCTAssert(observed[i] == inPlaceObserved[i] ||
+                observed[i].isNaN && inPlaceObserved[i].isNaN,
+                "\(name)(\(inputs[i]))", file: file, line: line)
+      if expected[i].isNaN {
+        XCTAssert(observed[i].isNaN, "\(name)(\(inputs[i]))", file: file, line: line)
+      } else if !expected[i].isFinite || expected[i] == 0 {
+        XCTAssertEqual(expected[i], observed[i], "\(name)(\(inputs[i]))", file: file, line: line)
+        // Zeros must have the right sign too.
+        XCTAssertEqual(expected[i].sign, observed[i].sign, "\(name)(\(inputs[i]))", file: file, line: line)
+      } else {
+        let error = (observed[i] - expected[i]).magnitude / expected[i].ulp
+        XCTAssert(error <= allowedUlps,
+                  "\(name)(\(inputs[i])): \(observed[i]) is \(error) ulp from \(expected[i])",
+                  file: file, line: line)
+      }
+    }
+  }
+  
+  // Enough inputs to cover several blocks of the kernel drivers, with a
+  // ragged tail, and values both inside and outside their fast domains.
+  static func kernelInputs() -> [Self] {
+    var g = SystemRandomNumberGenerator()
+    var inputs: [Self] = [0, -.zero, 1, -1, .infinity, -.infinity, .nan,
+                          .leastNonzeroMagnitude, .leastNormalMagnitude,
+                          .greatestFiniteMagnitude, -.greatestFiniteMagnitude,
+                          .pi, -.pi/2, 0x1p20, -0x1p21, 700, -700, 750, -750]
+    inputs += (0 ..< 1000).map { _ in Self.random(in: -1 ... 1, using: &g) }
+    inputs += (0 ..< 1000).map { _ in Self.random(in: -100 ... 100, using: &g) }
+    inputs += (0 ..< 200).map { _ in Self.random(in: -1e6 ... 1e6, using: &g) }
+    return inputs
+  }
+}
+
+extension Float {
+  static func batchedKernelChecks() {
+    let inputs = kernelInputs()
+    checkKernel("exp", inputs, allowedUlps: 1, scalar: { Float.exp($0) },
+                batched: { Float.exp($0, into: $1) }, inPlace: { Float.exp($0) })
+    checkKernel("expMinusOne", inputs, allowedUlps: 1, scalar: { Float.expMinusOne($0) },
+                batched: { Float.expMinusOne($0, into: $1) }, inPlace: { Float.expMinusOne($0) })
+    checkKernel("log", inputs, allowedUlps: 1, scalar: { Float.log($0) },
+                batched: { Float.log($0, into: $1) }, inPlace: { Float.log($0) })
+    checkKernel("log(onePlus:)", inputs, allowedUlps: 1, scalar: { Float.log(onePlus: $0) },
+                batched: { Float.log(onePlus: $0, into: $1) }, inPlace: { Float.log(onePlus: $0) })
+    checkKernel("cos", inputs, allowedUlps: 1, scalar: { Float.cos($0) },
+                batched: { Float.cos($0, into: $1) }, inPlace: { Float.cos($0) })
+    checkKernel("sin", inputs, allowedUlps: 1, scalar: { Float.sin($0) },
+                batched: { Float.sin($0, into: $1) }, inPlace: { Float.sin($0) })
+    checkKernel("tanh", inputs, allowedUlps: 1, scalar: { Float.tanh($0) },
+                batched: { Float.tanh($0, into: $1) }, inPlace: { Float.tanh($0) })
+    checkKernel("erf", inputs, allowedUlps: 1, scalar: { Float.erf($0) },
+                batched: { Float.erf($0, into: $1) }, inPlace: { Float.erf($0) })
+    checkKernel("erfc", inputs, allowedUlps: 1, scalar: { Float.erfc($0) },
+                batched: { Float.erfc($0, into: $1) }, inPlace: { Float.erfc($0) })
+    checkKernel("gamma", inputs, allowedUlps: 2, scalar: { Float.gamma($0) },
+                batched: { Float.gamma($0, into: $1) }, inPlace: { Float.gamma($0) })
+    #if !os(Windows)
+    checkKernel("logGamma", inputs, allowedUlps: 2, scalar: { Float.logGamma($0) },
+                batched: { Float.logGamma($0, into: $1) }, inPlace: { Float.logGamma($0) })
+    #endif
+  }
+}
+
+extension Double {
+  static func batchedKernelChecks() {
+    let inputs = kernelInputs()
+    checkKernel("exp", inputs, allowedUlps: 2, scalar: { Double.exp($0) },
+                batched: { Double.exp($0, into: $1) }, inPlace: { Double.exp($0) })
+    checkKernel("expMinusOne", inputs, allowedUlps: 2, scalar: { Double.expMinusOne($0) },
+                batched: { Double.expMinusOne($0, into: $1) }, inPlace: { Double.expMinusOne($0) })
+    checkKernel("log", inputs, allowedUlps: 2, scalar: { Double.log($0) },
+                batched: { Double.log($0, into: $1) }, inPlace: { Double.log($0) })
+    checkKernel("log(onePlus:)", inputs, allowedUlps: 2, scalar: { Double.log(onePlus: $0) },
+                batched: { Double.log(onePlus: $0, into: $1) }, inPlace: { Double.log(onePlus: $0) })
+    checkKernel("cos", inputs, allowedUlps: 2, scalar: { Double.cos($0) },
+                batched: { Double.cos($0, into: $1) }, inPlace: { Double.cos($0) })
+    checkKernel("sin", inputs, allowedUlps: 2, scalar: { Double.sin($0) },
+                batched: { Double.sin($0, into: $1) }, inPlace: { Double.sin($0) })
+    checkKernel("tanh", inputs, allowedUlps: 3, scalar: { Double.tanh($0) },
+                batched: { Double.tanh($0, into: $1) }, inPlace: { Double.tanh($0) })
+    checkKernel("erf", inputs, allowedUlps: 2, scalar: { Double.erf($0) },
+                batched: { Double.erf($0, into: $1) }, inPlace: { Double.erf($0) })
+    checkKernel("erfc", inputs, allowedUlps: 5, scalar: { Double.erfc($0) },
+                batched: { Double.erfc($0, into: $1) }, inPlace: { Double.erfc($0) })
+    #if !os(Windows)
+    checkKernel("logGamma", inputs, allowedUlps: 4, scalar: { Double.logGamma($0) },
+                batched: { Double.logGamma($0, into: $1) }, inPlace: { Double.logGamma($0) })
+    #endif
+  }
+}
+
+#if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+@available(macOS 11.0, iOS 14.0, watchOS 14.0, tvOS 7.0, *)
+extension Float16 {
+  static func batchedKernelChecks() {
+    // Every Float16 value.
+    let inputs = (0 ... UInt16.max).map { Float16(bitPattern: $0) }
+    checkKernel("exp", inputs, allowedUlps: 1, scalar: { Float16.exp($0) },
+                batched: { Float16.exp($0, into: $1) }, inPlace: { Float16.exp($0) })
+    checkKernel("expMinusOne", inputs, allowedUlps: 1, scalar: { Float16.expMinusOne($0) },
+                batched: { Float16.expMinusOne($0, into: $1) }, inPlace: { Float16.expMinusOne($0) })
+    checkKernel("log", inputs, allowedUlps: 1, scalar: { Float16.log($0) },
+                batched: { Float16.log($0, into: $1) }, inPlace: { Float16.log($0) })
+    checkKernel("log(onePlus:)", inputs, allowedUlps: 1, scalar: { Float16.log(onePlus: $0) },
+                batched: { Float16.log(onePlus: $0, into: $1) }, inPlace: { Float16.log(onePlus: $0) })
+    checkKernel("cos", inputs, allowedUlps: 1, scalar: { Float16.cos($0) },
+                batched: { Float16.cos($0, into: $1) }, inPlace: { Float16.cos($0) })
+    checkKernel("sin", inputs, allowedUlps: 1, scalar: { Float16.sin($0) },
+                batched: { Float16.sin($0, into: $1) }, inPlace: { Float16.sin($0) })
+    checkKernel("tanh", inputs, allowedUlps: 1, scalar: { Float16.tanh($0) },
+                batched: { Float16.tanh($0, into: $1) }, inPlace: { Float16.tanh($0) })
+    checkKernel("erf", inputs, allowedUlps: 1, scalar: { Float16.erf($0) },
+                batched: { Float16.erf($0, into: $1) }, inPlace: { Float16.erf($0) })
+    checkKernel("erfc", inputs, allowedUlps: 1, scalar: { Float16.erfc($0) },
+                batched: { Float16.erfc($0, into: $1) }, inPlace: { Float16.erfc($0) })
+    checkKernel("gamma", inputs, allowedUlps: 1, scalar: { Float16.gamma($0) },
+                batched: { Float16.gamma($0, into: $1) }, inPlace: { Float16.gamma($0) })
+    #if !os(Windows)
+    checkKernel("logGamma", inputs, allowedUlps: 1, scalar: { Float16.logGamma($0) },
+                batched: { Float16.logGamma($0, into: $1) }, inPlace: { Float16.logGamma($0) })
+    #endif
+    // The scalar normal distribution functions are evaluated in Float16
+    // arithmetic, so they are a little less accurate than the batched ones.
+    checkKernel("normalCDF", inputs, allowedUlps: 4, scalar: { Float16.normalCDF($0) },
+                batched: { Float16.normalCDF($0, into: $1) }, inPlace: { Float16.normalCDF($0) })
+    // Below leastNormalMagnitude, the scalar quantile is not refined.
+    let p = inputs.filter { !($0 > 0 && $0 < .leastNormalMagnitude) }
+    checkKernel("normalQuantile", p, allowedUlps: 4, scalar: { Float16.normalQuantile($0) },
+                batched: { Float16.normalQuantile($0, into: $1) },
+                inPlace: { Float16.normalQuantile($0) })
+  }
+}
+#endif
+
+final class BatchedFunctionTests: XCTestCase {
+  
+  #if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+  func testFloat16() {
+    if #available(macOS 11.0, iOS 14.0, watchOS 14.0, tvOS 7.0, *) {
+      Float16.batchedFunctionChecks()
+    }
+  }
+  #endif
+  
+  func testFloat() {
+    Float.batchedFunctionChecks()
+  }
+  
+  func testDouble() {
+    Double.batchedFunctionChecks()
+  }
+  
+  #if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+  func testFloat16Kernels() {
+    if #available(macOS 11.0, iOS 14.0, watchOS 14.0, tvOS 7.0, *) {
+      Float16.batchedKernelChecks()
+    }
+  }
+  #endif
+  
+  func testFloatKernels() {
+    Float.batchedKernelChecks()
+  }
+  
+  func testDoubleKernels() {
+    Double.batchedKernelChecks()
+  }
+  
+  #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+  func testFloat80() {
+    Float80.batchedFunctionChecks()
+  }
+  #endif
+}
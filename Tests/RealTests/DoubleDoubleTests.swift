@@ -0,0 +1,121 @@
+//===--- DoubleDoubleTests.swift ------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import RealModule
+
+fileprivate func assertAccurate(
+  _ a: DoubleDouble, _ b: DoubleDouble, bits: Int = 100,
+  file: StaticString = #file, line: UInt = #line
+) {
+  let tolerance = b.magnitude.multiplied(by: Double(sign: .plus, exponent: -bits, significand: 1))
+  XCTAssert((a - b).magnitude <= tolerance, "\(a) is not close to \(b)", file: file, line: line)
+}
+
+final class DoubleDoubleTests: XCTestCase {
+
+  // Correctly rounded values of constants.
+  let e = DoubleDouble(head: 0x1.5bf0a8b145769p+1, tail: 0x1.4d57ee2b1013ap-53)
+  let ln2 = DoubleDouble(head: 0x1.62e42fefa39efp-1, tail: 0x1.abc9e3b39803fp-56)
+  let sqrt2 = DoubleDouble(head: 0x1.6a09e667f3bcdp+0, tail: -0x1.bdd3413b26456p-54)
+
+  func testArithmetic() {
+    // Integers are exact, even beyond 2⁵³.
+    XCTAssertEqual(DoubleDouble(Int.max) - DoubleDouble(Int.max - 1), 1)
+    XCTAssertEqual(DoubleDouble(exactly: 1 << 60 + 1)!.tail, 1)
+    XCTAssertNil(DoubleDouble(exactly: UInt.max))
+    // The result is normalized.
+    let x = DoubleDouble(head: 1, tail: 1)
+    XCTAssertEqual(x.head, 2)
+    XCTAssertEqual(x.tail, 0)
+    let third = DoubleDouble(1) / 3
+    assertAccurate(third * 3, 1, bits: 104)
+    assertAccurate(DoubleDouble.sqrt(2), sqrt2, bits: 104)
+    assertAccurate(sqrt2 * sqrt2, 2, bits: 104)
+    XCTAssertEqual(Double(third), 1/3)
+    XCTAssertGreaterThan(third, DoubleDouble(1/3.0))
+    XCTAssertLessThan(third, DoubleDouble((1/3.0).nextUp))
+    // Special values.
+    XCTAssertEqual((DoubleDouble(.infinity) + 1).head, .infinity)
+    XCTAssertEqual((DoubleDouble(.infinity) + 1).tail, 0)
+    XCTAssertEqual((1 / DoubleDouble.zero).head, .infinity)
+    XCTAssertTrue((DoubleDouble.zero / 0).isNaN)
+    XCTAssertEqual((DoubleDouble(.greatestFiniteMagnitude) * 2).head, .infinity)
+    XCTAssertTrue(DoubleDouble.sqrt(-1).isNaN)
+  }
+
+  func testAccumulation() {
+    // big + 1 - big, repeated, is lost entirely in Double.
+    var sum = DoubleDouble.zero
+    for _ in 0 ..< 1000 {
+      sum.add(0x1p60)
+      sum.add(1)
+      sum.add(-0x1p60)
+    }
+    XCTAssertEqual(sum, 1000)
+    // (1 + ε)(1 - ε) - 1 = -ε²
+    var dot = DoubleDouble.zero
+    dot.addProduct(1 + .ulpOfOne, 1 - .ulpOfOne)
+    dot.add(-1)
+    XCTAssertEqual(dot, DoubleDouble(-.ulpOfOne * .ulpOfOne))
+  }
+
+  func testElementaryFunctions() {
+    assertAccurate(.exp(1), e)
+    assertAccurate(.log(e), 1)
+    assertAccurate(.log(2), ln2)
+    assertAccurate(.expMinusOne(ln2), 1)
+    assertAccurate(.log(onePlus: 1), ln2)
+    assertAccurate(4 * .atan(1), .pi)
+    assertAccurate(.sin(.pi / 6), DoubleDouble(1) / 2)
+    assertAccurate(.cos(.pi / 3), DoubleDouble(1) / 2)
+    assertAccurate(.tan(.pi / 4), 1)
+    assertAccurate(2 * .asin(DoubleDouble(1) / 2), .pi / 3)
+    assertAccurate(.acos(-1), .pi)
+    assertAccurate(.atan2(y: -1, x: -1), -3 * .pi / 4)
+    assertAccurate(.pow(2, DoubleDouble(1) / 2), sqrt2)
+    assertAccurate(.pow(sqrt2, 20), 1024, bits: 102)
+    assertAccurate(.root(8, 3), 2)
+    assertAccurate(.root(-8, 3), -2)
+    assertAccurate(.hypot(3, 4), 5)
+    assertAccurate(.cosh(1), (e + 1 / e) / 2)
+    assertAccurate(.sinh(1), (e - 1 / e) / 2)
+    assertAccurate(.tanh(ln2), DoubleDouble(3) / 5)
+    assertAccurate(.asinh(DoubleDouble(3) / 4), ln2)
+    assertAccurate(.acosh(DoubleDouble(5) / 4), ln2)
+    assertAccurate(.atanh(DoubleDouble(1) / 3), ln2 / 2)
+    // Identities on random arguments, which test the argument reductions.
+    var g = SystemRandomNumberGenerator()
+    for _ in 0 ..< 100 {
+      let x = DoubleDouble(head: .random(in: -100 ... 100, using: &g),
+                           tail: .random(in: -1 ... 1, using: &g) * 0x1p-60)
+      let s = DoubleDouble.sin(x), c = DoubleDouble.cos(x)
+      assertAccurate(s * s + c * c, 1)
+      assertAccurate(.exp(x) * .exp(-x), 1, bits: 98)
+      assertAccurate(.atan(.tan(x / 64)), x / 64)
+      let y = DoubleDouble(.random(in: 0x1p-1000 ... 0x1p1000, using: &g))
+      assertAccurate(.exp(.log(y)), y, bits: 92)
+    }
+    // Accuracy near zero.
+    let tiny = DoubleDouble(0x1p-70)
+    assertAccurate(.expMinusOne(tiny), tiny + tiny * tiny / 2)
+    assertAccurate(.log(onePlus: tiny), tiny - tiny * tiny / 2)
+    assertAccurate(.sin(tiny), tiny)
+    // Special values.
+    XCTAssertEqual(DoubleDouble.exp(1000).head, .infinity)
+    XCTAssertEqual(DoubleDouble.exp(-1000), 0)
+    XCTAssertEqual(DoubleDouble.log(0).head, -.infinity)
+    XCTAssertTrue(DoubleDouble.log(-1).isNaN)
+    XCTAssertTrue(DoubleDouble.sin(.init(.infinity)).isNaN)
+    XCTAssertTrue(DoubleDouble.acosh(0).isNaN)
+    XCTAssertEqual(DoubleDouble.atanh(1).head, .infinity)
+  }
+}
@@ -120,6 +120,19 @@ internal extension Real where Self: BinaryFloatingPoint {
     assertClose(0.4041169094348222983238250859191217675, Self.erf(0.375))
     assertClose(0.5958830905651777016761749140808782324, Self.erfc(0.375))
     assertClose(2.3704361844166009086464735041766525098, Self.gamma(0.375))
+    let (sin, cos) = Self.sincos(0.375)
+    assertClose(0.3662725290860475613729093517162641571, sin)
+    assertClose(0.9305076219123142911494767922295555080, cos)
+    assertClose(-0.069492378087685708850523207770444492, Self.cosMinusOne(sin: sin, cos: cos))
+    let small = Self.sincos(0x1p-6)
+    assertClose(-0.00012206782899334526398399063084053863, Self.cosMinusOne(sin: small.sin, cos: small.cos))
+    let (sinh, cosh) = Self.sinhcosh(0.375)
+    assertClose(0.3838510679136145687542956764205024589, sinh)
+    assertClose(1.0711403467045867672994980155670160493, cosh)
+    let large = Self.sinhcosh(-2.5)
+    assertClose(-6.0502044810397873214503236383504031877, large.sinh)
+    assertClose(6.1322894796636861166198523128175629955, large.cosh)
+    XCTAssertEqual(Self.sinhcosh(-0.0).sinh.sign, .minus)
     #if !os(Windows)
     assertClose( -0.11775527074107877445136203331798850, Self.logGamma(1.375))
     XCTAssertEqual(.plus,  Self.signGamma(1.375))
@@ -59,6 +59,36 @@ internal extension Real where Self: FixedWidthFloatingPoint {
     }
   }
   
+  static func testIntegerExponentSmall() {
+    // Small exponents are computed by repeated squaring. Products of small
+    // integers are exact, as are powers of two.
+    XCTAssertEqual(Self.pow(3, 2), 9)
+    XCTAssertEqual(Self.pow(-3, 3), -27)
+    XCTAssertEqual(Self.pow(3, 4), 81)
+    XCTAssertEqual(Self.pow(-3, 5), -243)
+    XCTAssertEqual(Self.pow(2, 64), 0x1p64)
+    XCTAssertEqual(Self.pow(-2, -63), -0x1p-63)
+    XCTAssertEqual(Self.pow(.nan, 0), 1)
+    XCTAssert(Self.pow(.nan, 3).isNaN)
+    XCTAssertEqual(Self.pow(-.infinity, 3), -.infinity)
+    XCTAssertEqual(Self.pow(-0.0, -3), -.infinity)
+    XCTAssertEqual(Self.pow(-0.0, 3).sign, .minus)
+    XCTAssertEqual(Self.pow(.greatestFiniteMagnitude, 4), .infinity)
+    XCTAssertEqual(Self.pow(.leastNormalMagnitude, 3), 0)
+    // Random values, compared with the libm function. Both have errors of
+    // less than an ulp.
+    var g = SystemRandomNumberGenerator()
+    for _ in 0 ..< 1000 {
+      let x = Self.random(in: 0.5 ... 2, using: &g)
+      let n = Int.random(in: -64 ... 64, using: &g)
+      let expected = Self.pow(x, Self(n))
+      assertClose(TestLiteralType(expected), Self.pow(x, n), allowedError: 2)
+      // Negating x only flips the sign of odd powers, exactly.
+      let sign: Self = n & 1 == 0 ? 1 : -1
+      XCTAssertEqual(Self.pow(-x, n), sign * Self.pow(x, n))
+    }
+  }
+  
   static func testIntegerExponentDoubleAndSmaller() {
     // max/min exponents, these always saturate, but this will reveal
     // errors in some implementations that one could try.
@@ -82,6 +112,7 @@ internal extension Real where Self: FixedWidthFloatingPoint {
 extension Float16 {
   static func testIntegerExponent() {
     testIntegerExponentCommon()
+    testIntegerExponentSmall()
     testIntegerExponentDoubleAndSmaller()
     let u = Float16(1).nextUp
     let d = Float16(1).nextDown
@@ -109,6 +140,7 @@ extension Float16 {
 extension Float {
   static func testIntegerExponent() {
     testIntegerExponentCommon()
+    testIntegerExponentSmall()
     testIntegerExponentDoubleAndSmaller()
     let u = Float(1).nextUp
     let d = Float(1).nextDown
@@ -135,6 +167,7 @@ extension Float {
 extension Double {
   static func testIntegerExponent() {
     testIntegerExponentCommon()
+    testIntegerExponentSmall()
     // Following tests only make sense (and are only necessary) on 64b platforms.
 #if arch(arm64) || arch(x86_64)
     testIntegerExponentDoubleAndSmaller()
@@ -193,6 +226,7 @@ final class IntegerExponentTests: XCTestCase {
   #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
   func testFloat80() {
     Float80.testIntegerExponentCommon()
+    Float80.testIntegerExponentSmall()
   }
   #endif
 }
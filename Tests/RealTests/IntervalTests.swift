@@ -0,0 +1,106 @@
+//===--- IntervalTests.swift ----------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import _TestSupport
+
+internal extension BinaryFloatingPoint {
+
+  // The value after this one in an interval; nextUp steps from
+  // -leastNonzeroMagnitude to -0, but intervals contain zero as +0.
+  var nextInInterval: Self { nextUp + 0 }
+
+  static func intervalChecks(sample: Interval<Self>) {
+    // Both zeros are the same position.
+    let zero = Interval<Self>(from: -.zero, through: .zero)
+    XCTAssertEqual(zero.count, 1)
+    XCTAssertEqual(zero[0], 0)
+    XCTAssertEqual(zero[0].sign, .plus)
+    XCTAssertEqual(Interval<Self>(from: .zero, through: -.zero).count, 1)
+    let tiny = Interval<Self>(from: -.leastNonzeroMagnitude,
+                              through: .leastNonzeroMagnitude)
+    XCTAssertEqual(Array(tiny), [-.leastNonzeroMagnitude, 0, .leastNonzeroMagnitude])
+    XCTAssertEqual(tiny[1].sign, .plus)
+    XCTAssertEqual(Interval<Self>(from: -.zero, to: .leastNonzeroMagnitude).count, 1)
+    XCTAssertEqual(Interval<Self>(from: -.leastNonzeroMagnitude, to: .zero).count, 1)
+    // Endpoints, including the subnormal boundary and the infinities.
+    let binade = Interval<Self>(from: 1, to: 2)
+    XCTAssertEqual(binade.count, 1 << Self.significandBitCount)
+    XCTAssertEqual(binade.first, 1)
+    XCTAssertEqual(binade.last, Self(2).nextDown)
+    let boundary = Interval<Self>(from: Self.leastNormalMagnitude.nextDown,
+                                  through: .leastNormalMagnitude)
+    XCTAssertEqual(Array(boundary),
+                   [Self.leastNormalMagnitude.nextDown, .leastNormalMagnitude])
+    let top = Interval<Self>(from: -.infinity, through: -.greatestFiniteMagnitude)
+    XCTAssertEqual(Array(top), [-.infinity, -.greatestFiniteMagnitude])
+    let overflow = Interval<Self>(from: .greatestFiniteMagnitude, through: .infinity)
+    XCTAssertEqual(Array(overflow), [.greatestFiniteMagnitude, .infinity])
+    let symmetric = Interval<Self>(from: -1, through: 1)
+    XCTAssertEqual(symmetric.count, 2 * binade.count * Int(Self(1).exponentBitPattern) + 1)
+    XCTAssertEqual(symmetric[symmetric.count/2], 0)
+    XCTAssertEqual(symmetric[symmetric.count/2 + 1], .leastNonzeroMagnitude)
+    XCTAssertEqual(symmetric.last, 1)
+    // The values are consecutive.
+    for interval in [tiny, boundary, overflow, sample] {
+      for i in 1 ..< interval.count {
+        XCTAssertEqual(interval[i], interval[i - 1].nextInInterval)
+      }
+    }
+  }
+
+  // The pieces of a split are consecutive, nonempty, differ in count by at
+  // most one, and together contain exactly the values of the interval.
+  static func splitChecks(_ interval: Interval<Self>) {
+    var ns = [1, 2, 3, 7, 100]
+    if interval.count <= 1 << 16 { ns += [interval.count, interval.count + 5] }
+    for n in ns {
+      let pieces = interval.split(into: n)
+      XCTAssertEqual(pieces.count, Swift.min(n, interval.count))
+      XCTAssertEqual(pieces.first?.first, interval.first)
+      XCTAssertEqual(pieces.last?.last, interval.last)
+      XCTAssertEqual(pieces.reduce(0) { $0 + $1.count }, interval.count)
+      let counts = pieces.map { $0.count }
+      XCTAssertLessThanOrEqual(counts.max()! - counts.min()!, 1)
+      for piece in pieces {
+        XCTAssertEqual(piece.lower, piece.first)
+        XCTAssertEqual(piece.upper, piece.last)
+      }
+      for (a, b) in zip(pieces, pieces.dropFirst()) {
+        XCTAssertEqual(b.first, a.last!.nextInInterval)
+      }
+    }
+  }
+}
+
+final class IntervalTests: XCTestCase {
+
+  func testFloat() {
+    let sample = Interval<Float>(from: -0x1p-140, through: 0x1p-140)
+    Float.intervalChecks(sample: sample)
+    // Every Float but the nans, with zero once; the count needs 64-bit Int.
+    if Int.bitWidth == 64 {
+      let all = Interval<Float>(from: -.infinity, through: .infinity)
+      XCTAssertEqual(all.count, 1 << 32 - 2 * (1 << 23 - 1) - 1)
+      XCTAssertEqual(all[all.count/2], 0)
+      Float.splitChecks(all)
+    }
+    Float.splitChecks(sample)
+    Float.splitChecks(Interval(from: 1, to: 1.5))
+  }
+
+  func testDouble() {
+    let sample = Interval<Double>(from: -0x1p-1060, through: 0x1p-1060)
+    Double.intervalChecks(sample: sample)
+    Double.splitChecks(sample)
+    Double.splitChecks(Interval(from: -.greatestFiniteMagnitude, through: 0))
+  }
+}
@@ -0,0 +1,143 @@
+//===--- NormalDistributionTests.swift ------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import RealModule
+import _TestSupport
+
+internal extension Real where Self: FixedWidthFloatingPoint {
+  static func normalDistributionEdgeCases() {
+    XCTAssertEqual(normalCDF(-.infinity), 0)
+    XCTAssertEqual(normalCDF(.infinity), 1)
+    XCTAssertEqual(normalCDF(0), 1/2)
+    XCTAssert(normalCDF(.nan).isNaN)
+    XCTAssertEqual(normalQuantile(0), -.infinity)
+    XCTAssertEqual(normalQuantile(1), .infinity)
+    XCTAssertEqual(normalQuantile(1/2), 0)
+    XCTAssert(normalQuantile(-1).isNaN)
+    XCTAssert(normalQuantile(2).isNaN)
+    XCTAssert(normalQuantile(.nan).isNaN)
+    XCTAssert(normalQuantile(-.leastNonzeroMagnitude).isNaN)
+    // Symmetry is exact, as 1 - p is.
+    for p: Self in [0.1, 0.25, 0.375] {
+      XCTAssertEqual(normalQuantile(1 - p), -normalQuantile(p))
+    }
+  }
+
+  // The batched functions must have the same edge cases as the scalar
+  // functions, and agree with them closely elsewhere, including in the
+  // lower tail.
+  static func batchedNormalDistributionChecks(
+    tail: Self, allowedUlps: Self,
+    cdf: (UnsafeBufferPointer<Self>, UnsafeMutableBufferPointer<Self>) -> Void,
+    cdfInPlace: (UnsafeMutableBufferPointer<Self>) -> Void,
+    quantile: (UnsafeBufferPointer<Self>, UnsafeMutableBufferPointer<Self>) -> Void,
+    quantileInPlace: (UnsafeMutableBufferPointer<Self>) -> Void
+  ) {
+    var g = SystemRandomNumberGenerator()
+    let specials: [Self] = [0, -.zero, 1, -1, 1/2, .infinity, -.infinity, .nan,
+                            .leastNonzeroMagnitude, .leastNormalMagnitude,
+                            .greatestFiniteMagnitude, -.greatestFiniteMagnitude]
+    let x = specials +
+      (0 ..< 1000).map { _ in Self.random(in: -8 ... 8, using: &g) } +
+      (0 ..< 1000).map { _ in Self.random(in: tail ... 0, using: &g) }
+    checkKernel("normalCDF", x, allowedUlps: allowedUlps,
+                scalar: { Self.normalCDF($0) }, batched: cdf, inPlace: cdfInPlace)
+    let p = specials +
+      (0 ..< 1000).map { _ in Self.random(in: 0 ... 1, using: &g) } +
+      (0 ..< 1000).map { _ in
+        Self(sign: .plus, exponent: -Self.Exponent(Int.random(in: 1 ..< 120)),
+             significand: Self.random(in: 1 ..< 2, using: &g))
+      }
+    checkKernel("normalQuantile", p, allowedUlps: allowedUlps,
+                scalar: { Self.normalQuantile($0) },
+                batched: quantile, inPlace: quantileInPlace)
+  }
+}
+
+final class NormalDistributionTests: XCTestCase {
+
+  func testFloat() {
+    Float.normalDistributionEdgeCases()
+    // Double is accurate enough to be the reference for Float.
+    var g = SystemRandomNumberGenerator()
+    for _ in 0 ..< 10000 {
+      let x = Float.random(in: -12 ... 8, using: &g)
+      assertClose(TestLiteralType(Double.normalCDF(Double(x))),
+                  Float.normalCDF(x), allowedError: 3)
+      let p = Float.random(in: 0x1p-100 ... 1, using: &g)
+      assertClose(TestLiteralType(Double.normalQuantile(Double(p))),
+                  Float.normalQuantile(p), allowedError: 3)
+    }
+    Float.batchedNormalDistributionChecks(tail: -12, allowedUlps: 3,
+      cdf: { Float.normalCDF($0, into: $1) }, cdfInPlace: { Float.normalCDF($0) },
+      quantile: { Float.normalQuantile($0, into: $1) },
+      quantileInPlace: { Float.normalQuantile($0) })
+  }
+
+  func testDouble() {
+    Double.normalDistributionEdgeCases()
+    // Reference values, computed in quadruple precision.
+    let cdf: [(Double, TestLiteralType)] = [
+      (-38.4, 6.60159985432676802422e-323),
+      (-38.2, 1.40802286669035286670e-319),
+      (-37.6, 1.07481124958704539932e-309),
+      (-37, 5.72557122252457682268e-300),
+      (-30, 4.90671392714818705953e-198),
+      (-20, 2.75362411860623369508e-89),
+      (-12, 1.77648211207767899770e-33),
+      (-8, 6.22096057427178412352e-16),
+      (-5, 2.86651571879193911674e-07),
+      (-3, 1.34989803163009452665e-03),
+      (-1.5, 6.68072012688580660045e-02),
+      (-0.5, 3.08537538725986896362e-01),
+      (-0x1p-20, 4.99999619538993452671e-01),
+      (0.25, 5.98706325682923724241e-01),
+      (1, 8.41344746068542948585e-01),
+      (2.5, 9.93790334674223864833e-01),
+      (6, 9.99999999013412354962e-01),
+    ]
+    for (x, expected) in cdf {
+      assertClose(expected, Double.normalCDF(x), allowedError: 6)
+    }
+    // The batched function too, including below -37.5, where the kernel
+    // leaves off.
+    var batched = cdf.map { $0.0 }
+    batched.withUnsafeMutableBufferPointer { Double.normalCDF($0) }
+    for (observed, (_, expected)) in zip(batched, cdf) {
+      assertClose(expected, observed, allowedError: 6)
+    }
+    let quantile: [(Double, TestLiteralType)] = [
+      (0x1p-1000, -3.71110119371647914101e+01),
+      (1e-300, -3.70470962993611992365e+01),
+      (1e-100, -2.12734535609653242942e+01),
+      (1e-30, -1.14640246884436157198e+01),
+      (1e-10, -6.36134090240405619910e+00),
+      (1e-5, -4.26489079392282461023e+00),
+      (0.001, -3.09023230616781353536e+00),
+      (0.02, -2.05374891063182304434e+00),
+      (0.1, -1.28155156554460043533e+00),
+      (0.3, -5.24400512708040815969e-01),
+      (0.49, -2.50689082587110580327e-02),
+      (0.5 - 0x1p-30, -2.33447949833329813992e-09),
+      (0.75, 6.74489750196081743202e-01),
+      (0.975, 1.95996398454005385560e+00),
+      (0.999999, 4.75342430881708776569e+00),
+    ]
+    for (p, expected) in quantile {
+      assertClose(expected, Double.normalQuantile(p), allowedError: 6)
+    }
+    Double.batchedNormalDistributionChecks(tail: -38.5, allowedUlps: 8,
+      cdf: { Double.normalCDF($0, into: $1) }, cdfInPlace: { Double.normalCDF($0) },
+      quantile: { Double.normalQuantile($0, into: $1) },
+      quantileInPlace: { Double.normalQuantile($0) })
+  }
+}
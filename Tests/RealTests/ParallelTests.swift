@@ -0,0 +1,122 @@
+//===--- ParallelTests.swift ----------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+#if canImport(Dispatch)
+import XCTest
+import RealModule
+import _TestSupport
+
+// The pairwise combination of the chunk sums, as Parallel.sum does it.
+fileprivate func combinePairwise<T: Real>(_ x: ArraySlice<T>) -> T {
+  if x.count <= 1 { return x.first ?? 0 }
+  let mid = x.startIndex + x.count/2
+  return combinePairwise(x[..<mid]) + combinePairwise(x[mid...])
+}
+
+internal extension Real where Self: FixedWidthFloatingPoint {
+
+  static func parallelChecks() {
+    let methods: [SummationMethod] = [.naive, .pairwise, .kahanBabuska, .doubleDouble]
+    let chunkSize = 1000
+    var g = SystemRandomNumberGenerator()
+    let x = (0 ..< 100_000).map { _ in Self.random(in: -8 ... 8, using: &g) }
+    // Batched functions give exactly the serial results.
+    var serial = [Self](repeating: 0, count: x.count)
+    var parallel = serial
+    x.withUnsafeBufferPointer { x in
+      serial.withUnsafeMutableBufferPointer { Self.exp(x, into: $0) }
+      parallel.withUnsafeMutableBufferPointer {
+        Parallel.apply(Self.exp(_:into:), to: x, into: $0, chunkSize: chunkSize)
+      }
+    }
+    XCTAssertEqual(serial, parallel)
+    serial.withUnsafeMutableBufferPointer { Self.log(onePlus: $0) }
+    parallel.withUnsafeMutableBufferPointer {
+      Parallel.apply(Self.log(onePlus:), to: $0, chunkSize: chunkSize)
+    }
+    XCTAssertEqual(serial, parallel)
+    // Small integers are summed exactly by every method. The count is not a
+    // multiple of the chunk size.
+    let n = 50_001
+    let a = (0 ..< n).map { Self($0 % 17) - 8 }
+    let b = (0 ..< n).map { Self($0 % 5) }
+    a.withUnsafeBufferPointer { a in
+      b.withUnsafeBufferPointer { b in
+        for method in methods {
+          XCTAssertEqual(Parallel.sum(a, method: method, chunkSize: chunkSize),
+                         Self.sum(a))
+          XCTAssertEqual(Parallel.dot(a, b, method: method, chunkSize: chunkSize),
+                         Self.dot(a, b))
+          XCTAssertEqual(Parallel.sum(ofSquares: a, method: method,
+                                      chunkSize: chunkSize),
+                         Self.sum(ofSquares: a))
+        }
+      }
+    }
+    XCTAssertEqual([Self]().withUnsafeBufferPointer { Parallel.sum($0) }, 0)
+    // Cancellation across chunk boundaries.
+    let big = 4 / Self.ulpOfOne
+    let c = (0 ..< 4000).flatMap { _ in [big, 1, -big] }
+    c.withUnsafeBufferPointer { c in
+      XCTAssertEqual(Parallel.sum(c, method: .kahanBabuska, chunkSize: chunkSize), 4000)
+      XCTAssertEqual(Parallel.sum(c, method: .doubleDouble, chunkSize: chunkSize), 4000)
+    }
+    // Chunk sums that overflow, and infinite terms, give the IEEE 754
+    // result when the chunks are merged.
+    let huge = [Self](repeating: .greatestFiniteMagnitude, count: 2 * chunkSize)
+    var infinite = [Self](repeating: 1, count: 2 * chunkSize)
+    infinite[chunkSize + 1] = -.infinity
+    huge.withUnsafeBufferPointer { huge in
+      infinite.withUnsafeBufferPointer { infinite in
+        for method in methods {
+          XCTAssertEqual(Parallel.sum(huge, method: method, chunkSize: chunkSize),
+                         .infinity)
+          XCTAssertEqual(Parallel.dot(infinite, infinite, method: method,
+                                      chunkSize: chunkSize), .infinity)
+          XCTAssertEqual(Parallel.sum(infinite, method: method,
+                                      chunkSize: chunkSize), -.infinity)
+        }
+      }
+    }
+    // Results do not depend on scheduling: repeated sums are identical, and
+    // the pairwise sum is the pairwise combination of the serial chunk sums.
+    x.withUnsafeBufferPointer { x in
+      for method in methods {
+        let first = Parallel.sum(x, method: method, chunkSize: chunkSize)
+        for _ in 0 ..< 4 {
+          XCTAssertEqual(Parallel.sum(x, method: method, chunkSize: chunkSize),
+                         first)
+        }
+      }
+      let chunks = stride(from: 0, to: x.count, by: chunkSize).map {
+        Self.sum(UnsafeBufferPointer(rebasing: x[$0 ..< min($0 + chunkSize, x.count)]))
+      }
+      XCTAssertEqual(Parallel.sum(x, method: .pairwise, chunkSize: chunkSize),
+                     combinePairwise(chunks[...]))
+      // The double-double sums are both very nearly correctly rounded.
+      let reference = Self.sum(x, method: .doubleDouble)
+      let observed = Parallel.sum(x, method: .doubleDouble, chunkSize: chunkSize)
+      XCTAssertLessThanOrEqual((observed - reference).magnitude, reference.ulp)
+    }
+  }
+}
+
+final class ParallelTests: XCTestCase {
+
+  func testFloat() {
+    Float.parallelChecks()
+  }
+
+  func testDouble() {
+    Double.parallelChecks()
+  }
+}
+#endif
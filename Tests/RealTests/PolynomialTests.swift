@@ -0,0 +1,105 @@
+//===--- PolynomialTests.swift --------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import RealModule
+import _TestSupport
+
+internal extension Real where Self: FixedWidthFloatingPoint {
+
+  static func polynomialChecks() {
+    let methods: [PolynomialEvaluationMethod] = [.horner, .estrin, .compensatedHorner]
+    // Integer polynomials at integer points are evaluated exactly by every
+    // method, as long as Σ|c[k]||x|^k is exactly representable (which bounds
+    // every intermediate value). The degrees exercise Estrin's partial
+    // blocks.
+    let exactLimit = 1 << Swift.min(Self.significandBitCount + 1, 32)
+    for degree in [-1, 0, 1, 3, 4, 7, 8, 9, 15, 16, 20] {
+      let c = (0 ..< degree + 1).map { Int($0 * 7 % 11) - 5 }
+      let p = Polynomial(coefficients: c.map { Self($0) })
+      for x in -3 ... 3 {
+        let bound = c.reversed().reduce(0) { $0 * abs(x) + abs($1) }
+        guard bound <= exactLimit else { continue }
+        let expected = Self(c.reversed().reduce(0) { $0 * x + $1 })
+        XCTAssertEqual(p.evaluate(at: Self(x)), expected)
+        for method in methods {
+          XCTAssertEqual(p.evaluate(at: Self(x), method: method), expected)
+        }
+      }
+    }
+    XCTAssertEqual(Polynomial<Self>(coefficients: []).evaluate(at: 2), 0)
+    // (x - 1)^7, evaluated at 3/2 where its condition number is 5^7. Horner
+    // and Estrin may be off by many ulps, but the compensated evaluation is
+    // nearly correctly rounded. There is not enough precision in Float16 to
+    // recover the result.
+    if Self.significandBitCount >= 23 {
+      let p: Polynomial<Self> = [-1, 7, -21, 35, -35, 21, -7, 1]
+      let expected = 1 / Self(128)
+      let observed = p.evaluate(at: 1.5, method: .compensatedHorner)
+      XCTAssertLessThanOrEqual((observed - expected).magnitude, 2 * expected.ulp)
+    }
+    // Random coefficients and points: every method agrees with the
+    // compensated evaluation to within the error bound of Horner's rule.
+    var g = SystemRandomNumberGenerator()
+    let p = Polynomial(coefficients: (0 ..< 13).map { _ in
+      Self.random(in: -1 ... 1, using: &g)
+    })
+    let x = (0 ..< 1001).map { _ in Self.random(in: -2 ... 2, using: &g) }
+    for xi in x {
+      let reference = p.evaluate(at: xi, method: .compensatedHorner)
+      let scale = Polynomial(coefficients: p.coefficients.map { $0.magnitude })
+        .evaluate(at: xi.magnitude, method: .compensatedHorner)
+      for method in [PolynomialEvaluationMethod.horner, .estrin] {
+        XCTAssertLessThanOrEqual(
+          (p.evaluate(at: xi, method: method) - reference).magnitude,
+          2 * 13 * .ulpOfOne * scale
+        )
+      }
+    }
+    // Batched evaluation gives exactly the scalar results, including in
+    // place.
+    for method in methods {
+      var y = [Self](repeating: 0, count: x.count)
+      x.withUnsafeBufferPointer { x in
+        y.withUnsafeMutableBufferPointer { p.evaluate(at: x, into: $0, method: method) }
+      }
+      XCTAssertEqual(y, x.map { p.evaluate(at: $0, method: method) })
+      var z = x
+      z.withUnsafeMutableBufferPointer { p.evaluate(at: $0, method: method) }
+      XCTAssertEqual(z, y)
+    }
+  }
+}
+
+final class PolynomialTests: XCTestCase {
+
+  #if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+  func testFloat16() {
+    if #available(macOS 11.0, iOS 14.0, watchOS 14.0, tvOS 7.0, *) {
+      Float16.polynomialChecks()
+    }
+  }
+  #endif
+
+  func testFloat() {
+    Float.polynomialChecks()
+  }
+
+  func testDouble() {
+    Double.polynomialChecks()
+  }
+
+  #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+  func testFloat80() {
+    Float80.polynomialChecks()
+  }
+  #endif
+}
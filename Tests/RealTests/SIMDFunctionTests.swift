@@ -0,0 +1,117 @@
+//===--- SIMDFunctionTests.swift ------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import RealModule
+import _TestSupport
+
+// An arbitrary function written against ElementaryFunctions, to check that
+// generic code can be used with SIMD vectors.
+fileprivate func softplus<T: ElementaryFunctions>(_ x: T) -> T {
+  .log(onePlus: .exp(x))
+}
+
+// Each lane of the vector result must match the scalar function of the
+// corresponding lane, to within `allowedUlps`.
+fileprivate func checkLanewise<V>(
+  _ name: String,
+  _ x: V,
+  allowedUlps: V.Scalar,
+  vector: (V) -> V,
+  scalar: (V.Scalar) -> V.Scalar,
+  file: StaticString = #file,
+  line: UInt = #line
+) where V: SIMD & ElementaryFunctions, V.Scalar: Real & FixedWidthFloatingPoint {
+  let observed = vector(x)
+  for i in x.indices {
+    let expected = scalar(x[i])
+    if expected.isNaN {
+      XCTAssert(observed[i].isNaN, "\(name)(\(x[i]))", file: file, line: line)
+    } else if !expected.isFinite || expected == 0 {
+      XCTAssertEqual(expected, observed[i], "\(name)(\(x[i]))", file: file, line: line)
+      XCTAssertEqual(expected.sign, observed[i].sign, "\(name)(\(x[i]))", file: file, line: line)
+    } else {
+      let error = (observed[i] - expected).magnitude / expected.ulp
+      XCTAssert(error <= allowedUlps,
+                "\(name)(\(x[i])): \(observed[i]) is \(error) ulp from \(expected)",
+                file: file, line: line)
+    }
+  }
+}
+
+fileprivate func simdFunctionChecks<V>(_ type: V.Type, allowedUlps: V.Scalar)
+where V: SIMD & ElementaryFunctions, V.Scalar: Real & FixedWidthFloatingPoint {
+  var g = SystemRandomNumberGenerator()
+  for _ in 0 ..< 20 {
+    var x = V()
+    for i in x.indices {
+      x[i] = V.Scalar.random(in: -4 ... 4, using: &g)
+    }
+    // Specials in the first lanes; every SIMD type has at least two.
+    x[0] = .nan
+    x[1] = -.infinity
+    checkLanewise("exp", x, allowedUlps: allowedUlps, vector: { .exp($0) }, scalar: { .exp($0) })
+    checkLanewise("expMinusOne", x, allowedUlps: allowedUlps, vector: { .expMinusOne($0) }, scalar: { .expMinusOne($0) })
+    checkLanewise("log", x, allowedUlps: allowedUlps, vector: { .log($0) }, scalar: { .log($0) })
+    checkLanewise("log(onePlus:)", x, allowedUlps: allowedUlps, vector: { .log(onePlus: $0) }, scalar: { .log(onePlus: $0) })
+    checkLanewise("cos", x, allowedUlps: allowedUlps, vector: { .cos($0) }, scalar: { .cos($0) })
+    checkLanewise("sin", x, allowedUlps: allowedUlps, vector: { .sin($0) }, scalar: { .sin($0) })
+    checkLanewise("tanh", x, allowedUlps: allowedUlps, vector: { .tanh($0) }, scalar: { .tanh($0) })
+    checkLanewise("cosh", x, allowedUlps: 0, vector: { .cosh($0) }, scalar: { .cosh($0) })
+    checkLanewise("asinh", x, allowedUlps: 0, vector: { .asinh($0) }, scalar: { .asinh($0) })
+    checkLanewise("atan", x, allowedUlps: 0, vector: { .atan($0) }, scalar: { .atan($0) })
+    checkLanewise("sqrt", x, allowedUlps: 0, vector: { .sqrt($0) }, scalar: { .sqrt($0) })
+    checkLanewise("pow(_:3)", x, allowedUlps: 0, vector: { .pow($0, 3) }, scalar: { .pow($0, 3) })
+    checkLanewise("root(_:3)", x, allowedUlps: 0, vector: { .root($0, 3) }, scalar: { .root($0, 3) })
+    checkLanewise("softplus", x, allowedUlps: 2*allowedUlps + 1, vector: softplus, scalar: softplus)
+  }
+  // Odd functions preserve the sign of zero.
+  let zeros = V(repeating: -.zero)
+  checkLanewise("expMinusOne", zeros, allowedUlps: 0, vector: { .expMinusOne($0) }, scalar: { .expMinusOne($0) })
+  checkLanewise("log(onePlus:)", zeros, allowedUlps: 0, vector: { .log(onePlus: $0) }, scalar: { .log(onePlus: $0) })
+  checkLanewise("sin", zeros, allowedUlps: 0, vector: { .sin($0) }, scalar: { .sin($0) })
+  checkLanewise("tanh", zeros, allowedUlps: 0, vector: { .tanh($0) }, scalar: { .tanh($0) })
+  let y = V(repeating: 2)
+  let z = V.pow(y, V(repeating: 0.5))
+  for i in z.indices {
+    XCTAssertEqual(z[i], .pow(2, 0.5))
+  }
+}
+
+final class SIMDFunctionTests: XCTestCase {
+
+  #if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+  func testFloat16() {
+    if #available(macOS 11.0, iOS 14.0, watchOS 14.0, tvOS 7.0, *) {
+      simdFunctionChecks(SIMD2<Float16>.self, allowedUlps: 0)
+      simdFunctionChecks(SIMD8<Float16>.self, allowedUlps: 0)
+    }
+  }
+  #endif
+
+  func testFloat() {
+    simdFunctionChecks(SIMD2<Float>.self, allowedUlps: 1)
+    simdFunctionChecks(SIMD3<Float>.self, allowedUlps: 1)
+    simdFunctionChecks(SIMD4<Float>.self, allowedUlps: 1)
+    simdFunctionChecks(SIMD8<Float>.self, allowedUlps: 1)
+    simdFunctionChecks(SIMD16<Float>.self, allowedUlps: 1)
+    simdFunctionChecks(SIMD32<Float>.self, allowedUlps: 1)
+    simdFunctionChecks(SIMD64<Float>.self, allowedUlps: 1)
+  }
+
+  func testDouble() {
+    simdFunctionChecks(SIMD2<Double>.self, allowedUlps: 3)
+    simdFunctionChecks(SIMD3<Double>.self, allowedUlps: 3)
+    simdFunctionChecks(SIMD4<Double>.self, allowedUlps: 3)
+    simdFunctionChecks(SIMD8<Double>.self, allowedUlps: 3)
+    simdFunctionChecks(SIMD64<Double>.self, allowedUlps: 3)
+  }
+}
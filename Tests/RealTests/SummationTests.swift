@@ -0,0 +1,106 @@
+//===--- SummationTests.swift ---------------------------------*- swift -*-===//
+//
+// This source file is part of the Swift Numerics open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift Numerics project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+//
+//===----------------------------------------------------------------------===//
+
+import XCTest
+import RealModule
+import _TestSupport
+
+internal extension Real where Self: FixedWidthFloatingPoint {
+
+  static func summationChecks() {
+    let methods: [SummationMethod] = [.naive, .pairwise, .kahanBabuska, .doubleDouble]
+    // Small integers are summed exactly by every method, whatever the order
+    // of the additions, as long as the totals are exactly representable.
+    // The lengths exercise the unrolled loops and the pairwise blocking.
+    let exactLimit = 1 << min(Self.significandBitCount + 1, 32)
+    for count in [0, 1, 3, 4, 31, 127, 128, 129, 1000] where 64 * count <= exactLimit {
+      let x = (0 ..< count).map { Self($0 % 17) - 8 }
+      let y = (0 ..< count).map { Self($0 % 5) }
+      let sum = x.reduce(0, +)
+      let dot = zip(x, y).reduce(0) { $0 + $1.0 * $1.1 }
+      let sumOfSquares = x.reduce(0) { $0 + $1 * $1 }
+      for method in methods {
+        XCTAssertEqual(Self.sum(x, method: method), sum)
+        XCTAssertEqual(Self.dot(x, y, method: method), dot)
+        XCTAssertEqual(Self.sum(ofSquares: x, method: method), sumOfSquares)
+        // Sequences without contiguous storage.
+        XCTAssertEqual(Self.sum(x.lazy.map { $0 }, method: method), sum)
+      }
+    }
+    // A sum with massive cancellation: big + 1 - big, repeated. The exact
+    // sum is the number of repetitions, but naive summation loses every 1.
+    let big = 4 / Self.ulpOfOne
+    let x = (0 ..< 400).flatMap { _ in [big, 1, -big] }
+    XCTAssertEqual(Self.sum(x, method: .kahanBabuska), 400)
+    XCTAssertEqual(Self.sum(x, method: .doubleDouble), 400)
+    // The same cancellation in a dot product, where the products are also
+    // not exactly representable.
+    let a = [Self(1) + .ulpOfOne, Self(1) - .ulpOfOne, -1]
+    let b = [Self(1) - .ulpOfOne, Self(1) + .ulpOfOne, 2]
+    // (1 + ε)(1 - ε) + (1 - ε)(1 + ε) - 2 = -2ε²
+    let expected = -2 * .ulpOfOne * .ulpOfOne
+    XCTAssertEqual(Self.dot(a, b, method: .kahanBabuska), expected)
+    XCTAssertEqual(Self.dot(a, b, method: .doubleDouble), expected)
+    // Infinite terms, and sums that overflow, give the IEEE 754 result;
+    // the compensation must not turn them into nan (∞ - ∞).
+    let inf = Self.infinity
+    let gfm = Self.greatestFiniteMagnitude
+    for method in methods {
+      XCTAssertEqual(Self.sum([inf], method: method), inf)
+      XCTAssertEqual(Self.sum([1, -inf, 2], method: method), -inf)
+      XCTAssertEqual(Self.sum([gfm, gfm], method: method), inf)
+      XCTAssertEqual(Self.sum([-gfm, 1, -gfm, 1], method: method), -inf)
+      XCTAssertEqual(Self.sum(Array(repeating: gfm, count: 100), method: method), inf)
+      XCTAssert(Self.sum([inf, 1, -inf], method: method).isNaN)
+      XCTAssert(Self.sum([1, .nan], method: method).isNaN)
+      XCTAssertEqual(Self.dot([gfm, 2], [2, 1], method: method), inf)
+      XCTAssertEqual(Self.dot([1, inf], [1, -1], method: method), -inf)
+      XCTAssertEqual(Self.sum(ofSquares: [gfm, 1], method: method), inf)
+    }
+    // Random data: every method agrees with the most accurate one to within
+    // its error bound.
+    var g = SystemRandomNumberGenerator()
+    let r = (0 ..< 10_000).map { _ in Self.random(in: -1 ... 1, using: &g) }
+    let reference = Self.sum(r, method: .doubleDouble)
+    let scale = Self.sum(r.map { $0.magnitude }, method: .doubleDouble)
+    XCTAssertLessThanOrEqual((Self.sum(r, method: .naive) - reference).magnitude,
+                             10_000 * .ulpOfOne * scale)
+    XCTAssertLessThanOrEqual((Self.sum(r, method: .pairwise) - reference).magnitude,
+                             100 * .ulpOfOne * scale)
+    XCTAssertLessThanOrEqual((Self.sum(r, method: .kahanBabuska) - reference).magnitude,
+                             2 * reference.ulp + .ulpOfOne * .ulpOfOne * scale)
+  }
+}
+
+final class SummationTests: XCTestCase {
+
+  #if swift(>=5.4) && !((os(macOS) || targetEnvironment(macCatalyst)) && arch(x86_64))
+  func testFloat16() {
+    if #available(macOS 11.0, iOS 14.0, watchOS 14.0, tvOS 7.0, *) {
+      Float16.summationChecks()
+    }
+  }
+  #endif
+
+  func testFloat() {
+    Float.summationChecks()
+  }
+
+  func testDouble() {
+    Double.summationChecks()
+  }
+
+  #if (arch(i386) || arch(x86_64)) && !os(Windows) && !os(Android)
+  func testFloat80() {
+    Float80.summationChecks()
+  }
+  #endif
+}
@@ -48,6 +48,41 @@ extension IntegerExponentTests {
     ("testDouble", IntegerExponentTests.testDouble),
   ])
 }
+
+extension BatchedFunctionTests {
+  static var all = testCase([
+    ("testFloat16", BatchedFunctionTests.testFloat16),
+    ("testFloat", BatchedFunctionTests.testFloat),
+    ("testDouble", BatchedFunctionTests.testDouble),
+    ("testFloat16Kernels", BatchedFunctionTests.testFloat16Kernels),
+    ("testFloatKernels", BatchedFunctionTests.testFloatKernels),
+    ("testDoubleKernels", BatchedFunctionTests.testDoubleKernels),
+  ])
+}
+
+extension SIMDFunctionTests {
+  static var all = testCase([
+    ("testFloat16", SIMDFunctionTests.testFloat16),
+    ("testFloat", SIMDFunctionTests.testFloat),
+    ("testDouble", SIMDFunctionTests.testDouble),
+  ])
+}
+
+extension PolynomialTests {
+  static var all = testCase([
+    ("testFloat16", PolynomialTests.testFloat16),
+    ("testFloat", PolynomialTests.testFloat),
+    ("testDouble", PolynomialTests.testDouble),
+  ])
+}
+
+extension SummationTests {
+  static var all = testCase([
+    ("testFloat16", SummationTests.testFloat16),
+    ("testFloat", SummationTests.testFloat),
+    ("testDouble", SummationTests.testDouble),
+  ])
+}
 #else
 extension ElementaryFunctionChecks {
   static var all = testCase([
@@ -62,13 +97,136 @@ extension IntegerExponentTests {
     ("testDouble", IntegerExponentTests.testDouble),
   ])
 }
+
+extension BatchedFunctionTests {
+  static var all = testCase([
+    ("testFloat", BatchedFunctionTests.testFloat),
+    ("testDouble", BatchedFunctionTests.testDouble),
+    ("testFloatKernels", BatchedFunctionTests.testFloatKernels),
+    ("testDoubleKernels", BatchedFunctionTests.testDoubleKernels),
+  ])
+}
+
+extension SIMDFunctionTests {
+  static var all = testCase([
+    ("testFloat", SIMDFunctionTests.testFloat),
+    ("testDouble", SIMDFunctionTests.testDouble),
+  ])
+}
+
+extension PolynomialTests {
+  static var all = testCase([
+    ("testFloat", PolynomialTests.testFloat),
+    ("testDouble", PolynomialTests.testDouble),
+  ])
+}
+
+extension SummationTests {
+  static var all = testCase([
+    ("testFloat", SummationTests.testFloat),
+    ("testDouble", SummationTests.testDouble),
+  ])
+}
 #endif
 
+extension DoubleDoubleTests {
+  static var all = testCase([
+    ("testArithmetic", DoubleDoubleTests.testArithmetic),
+    ("testAccumulation", DoubleDoubleTests.testAccumulation),
+    ("testElementaryFunctions", DoubleDoubleTests.testElementaryFunctions),
+  ])
+}
+
+extension IntervalTests {
+  static var all = testCase([
+    ("testFloat", IntervalTests.testFloat),
+    ("testDouble", IntervalTests.testDouble),
+  ])
+}
+
+extension AccumulatorTests {
+  static var all = testCase([
+    ("testFloat", AccumulatorTests.testFloat),
+    ("testDouble", AccumulatorTests.testDouble),
+  ])
+}
+
+extension NormalDistributionTests {
+  static var all = testCase([
+    ("testFloat", NormalDistributionTests.testFloat),
+    ("testDouble", NormalDistributionTests.testDouble),
+  ])
+}
+
+extension RealTests.ParallelTests {
+  static var all = testCase([
+    ("testFloat", RealTests.ParallelTests.testFloat),
+    ("testDouble", RealTests.ParallelTests.testDouble),
+  ])
+}
+
+extension ComplexTests.ParallelTests {
+  static var all = testCase([
+    ("testFloat", ComplexTests.ParallelTests.testFloat),
+    ("testDouble", ComplexTests.ParallelTests.testDouble),
+  ])
+}
+
 extension ArithmeticTests {
   static var all = testCase([
     ("testPolar", ArithmeticTests.testPolar),
     ("testBaudinSmith", ArithmeticTests.testBaudinSmith),
     ("testDivisionByZero", ArithmeticTests.testDivisionByZero),
+    ("testFloatDivision", ArithmeticTests.testFloatDivision),
+    ("testPolynomial", ArithmeticTests.testPolynomial),
+  ])
+}
+
+extension BatchedArithmeticTests {
+  static var all = testCase([
+    ("testDivideByScalar", BatchedArithmeticTests.testDivideByScalar),
+    ("testDivideElementwise", BatchedArithmeticTests.testDivideElementwise),
+    ("testDot", BatchedArithmeticTests.testDot),
+    ("testAxpy", BatchedArithmeticTests.testAxpy),
+    ("testSum", BatchedArithmeticTests.testSum),
+    ("testPolar", BatchedArithmeticTests.testPolar),
+  ])
+}
+
+extension RelaxedTests {
+  static var all = testCase([
+    ("testFloat", RelaxedTests.testFloat),
+    ("testDouble", RelaxedTests.testDouble),
+  ])
+}
+
+extension BinaryRepresentationTests {
+  static var all = testCase([
+    ("testLayout", BinaryRepresentationTests.testLayout),
+    ("testEncoding", BinaryRepresentationTests.testEncoding),
+  ])
+}
+
+extension SlowPathCountersTests {
+  static var all = testCase([
+    ("testCounters", SlowPathCountersTests.testCounters),
+  ])
+}
+
+extension UnitRootTableTests {
+  static var all = testCase([
+    ("testFloat", UnitRootTableTests.testFloat),
+    ("testDouble", UnitRootTableTests.testDouble),
+    ("testSymmetries", UnitRootTableTests.testSymmetries),
+    ("testShared", UnitRootTableTests.testShared),
+  ])
+}
+
+extension ComplexBufferTests {
+  static var all = testCase([
+    ("testConversions", ComplexBufferTests.testConversions),
+    ("testArithmetic", ComplexBufferTests.testArithmetic),
+    ("testElementaryFunctions", ComplexBufferTests.testElementaryFunctions),
   ])
 }
 
@@ -77,6 +235,15 @@ extension PropertyTests {
     ("testProperties", PropertyTests.testProperties),
     ("testEquatableHashable", PropertyTests.testEquatableHashable),
     ("testCodable", PropertyTests.testCodable),
+    ("testConversions", PropertyTests.testConversions),
+  ])
+}
+
+extension ErrorStatisticsTests {
+  static var all = testCase([
+    ("testUlpDistance", ErrorStatisticsTests.testUlpDistance),
+    ("testStatistics", ErrorStatisticsTests.testStatistics),
+    ("testComplexStatistics", ErrorStatisticsTests.testComplexStatistics),
   ])
 }
 
@@ -85,8 +252,25 @@ var testCases = [
   RealTests.ApproximateEqualityTests.all,
   ElementaryFunctionChecks.all,
   IntegerExponentTests.all,
+  BatchedFunctionTests.all,
+  SIMDFunctionTests.all,
+  SummationTests.all,
+  PolynomialTests.all,
+  DoubleDoubleTests.all,
+  RealTests.ParallelTests.all,
+  ComplexTests.ParallelTests.all,
+  IntervalTests.all,
+  AccumulatorTests.all,
+  NormalDistributionTests.all,
   ArithmeticTests.all,
+  BatchedArithmeticTests.all,
+  BinaryRepresentationTests.all,
+  ComplexBufferTests.all,
+  RelaxedTests.all,
+  SlowPathCountersTests.all,
+  UnitRootTableTests.all,
   PropertyTests.all,
+  ErrorStatisticsTests.all,
 ]
 
 #if swift(>=5.3) && canImport(_Differentiation)